@@ -19,8 +19,19 @@ extern "C"
 #endif
 
 #include "xutil/filesystem.h"
+#include "xutil/filepath.h"
+#include "xutil/filemap.h"
+#include "xutil/fileio.h"
+#include "xutil/statcache.h"
+#include "xutil/fingerprint.h"
+#include "xutil/filewatch.h"
+#include "xutil/filewriter.h"
+#include "xutil/diskusage.h"
+#include "xutil/fileglob.h"
 #include "xutil/arguments.h"
 #include "xutil/lavalamp.h"
+#include "xutil/lavarng.h"
+#include "xutil/lavaentropy.h"
 #include "xutil/cnullptr.h"
 #include "xutil/command.h"
 #include "xutil/bitwise.h"
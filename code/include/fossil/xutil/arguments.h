@@ -18,13 +18,19 @@ extern "C"
 {
 #endif
 
+#include "filemap.h"
+#include <stddef.h>
+
 // Option types
 typedef enum {
     COPTION_TYPE_INT,
     COPTION_TYPE_STRING,
     COPTION_TYPE_BOOL,
     COPTION_TYPE_COMBO,
-    COPTION_TYPE_FEATURE
+    COPTION_TYPE_FEATURE,
+    COPTION_TYPE_INT64,  // 64-bit integer, decimal or 0x hex
+    COPTION_TYPE_DOUBLE,
+    COPTION_TYPE_SIZE    // byte count with an optional k, M, G, T or P suffix (powers of 1024)
 } coption_type;
 
 // Feature values
@@ -40,6 +46,14 @@ typedef struct {
     int value;
 } combo_choice;
 
+// Where the value of an option came from, in increasing precedence
+typedef enum {
+    CARG_SOURCE_DEFAULT,
+    CARG_SOURCE_CONFIG,      // configuration file
+    CARG_SOURCE_ENVIRONMENT, // PREFIX_NAME environment variable
+    CARG_SOURCE_COMMAND_LINE
+} carg_source;
+
 // Option value union
 typedef union {
     int int_val;
@@ -47,6 +61,9 @@ typedef union {
     int bool_val;
     int combo_val;
     feature_value feature_val;
+    long long int64_val;
+    double double_val;
+    size_t size_val;
 } coption_value;
 
 // Option structure
@@ -57,6 +74,8 @@ typedef struct {
     void* extra_data; // Used for choices in COPTION_TYPE_COMBO
     int num_choices;  // Used for choices in COPTION_TYPE_COMBO
     int parsed;       // Flag to indicate if the option is parsed
+    const char* help; // Description shown in the usage text, may be NULL
+    carg_source source; // Layer the current value came from
 } coption;
 
 // Command line structure
@@ -65,6 +84,194 @@ typedef struct {
     char** argv;
 } ccommandline;
 
+// Slot of an option lookup table
+typedef struct {
+    unsigned int hash;
+    int option; // index into the option array, -1 for an empty slot
+} coption_slot;
+
+// Hash index over the names of an option array, built once and shared by
+// every lookup so parsing costs one probe per argument
+typedef struct {
+    const coption* options;
+    int num_options;
+    coption_slot* slots;
+    int capacity;
+    int owned; // slots were allocated by fscl_arg_index_build
+} coption_index;
+
+// Problems reported by the checked parser
+typedef enum {
+    CARG_ERROR_UNKNOWN_OPTION,   // no option has this name
+    CARG_ERROR_MISSING_VALUE,    // the option needs a value and none followed
+    CARG_ERROR_INVALID_VALUE,    // the value does not parse for the option type
+    CARG_ERROR_OUT_OF_RANGE,     // the number does not fit the option type
+    CARG_ERROR_UNEXPECTED_VALUE  // a value other than on/off was attached to a boolean option
+} carg_error_code;
+
+// One problem found by the checked parser
+typedef struct {
+    carg_error_code code;
+    int position;         // argument number counting from 1, line number in a config file
+    const char* argument; // the argument, config key or environment value as given
+    int option;           // index of the option involved, -1 if unknown
+    carg_source source;   // layer the problem was found in
+} carg_error;
+
+// Problems found by one checked parse
+typedef struct {
+    carg_error* errors;
+    int count;
+    int capacity;
+} carg_errors;
+
+// Value of one option in a parse result
+typedef struct {
+    coption_value value;
+    carg_source source;
+    int parsed;
+} carg_value;
+
+// Block of caller memory that parse results are carved from. Nothing in
+// it is freed on its own; reset the arena to reuse the whole block.
+typedef struct {
+    char* data;
+    size_t capacity;
+    size_t used;
+} carg_arena;
+
+// Result of a parse against a shared option schema, values[i] belongs
+// to schema->options[i] (or to prefix_opt_<name> of an option table)
+typedef struct {
+    const coption_index* schema;
+    carg_value* values;
+} carg_result;
+
+// Source of argument tokens for the streaming parser, returns NULL at the end
+typedef const char* (*carg_next_token)(void* source);
+
+// A response file being read. Tokens are unquoted in place inside a
+// private view of the file and stay valid until it is closed.
+typedef struct {
+    cfilemap map;
+    char* cursor;
+    char* end;
+    char* tail; // copy of a last token that runs into the end of the view
+} carg_response;
+
+// Nesting limit of response files referring to other response files
+#define FSCL_ARG_RESPONSE_DEPTH 8
+
+// Token source over a command line that expands @file arguments
+typedef struct {
+    int argc;
+    char** argv;
+    int position;
+    carg_response* files; // every response file opened, tokens point into them
+    int file_count;
+    int file_capacity;
+    int stack[FSCL_ARG_RESPONSE_DEPTH]; // files being read, innermost last
+    int depth;
+} carg_tokens;
+
+// Layers resolved on top of the option defaults by fscl_arg_resolve
+typedef struct {
+    const char* config_path; // key=value or INI file, NULL to skip; a missing file is skipped
+    const char* section;     // INI section read besides the top level keys, may be NULL
+    const char* env_prefix;  // PREFIX of PREFIX_NAME variables, NULL to skip
+    cfilemap config;         // private view of the file, string values point into it
+    char* tail;              // copy of a last line that runs into the end of the view
+    int loaded;
+} carg_layers;
+
+// Output formats of an option dump
+typedef enum {
+    CARG_RENDER_TEXT,
+    CARG_RENDER_JSON
+} carg_render_format;
+
+// Buffer that usage text and option dumps are rendered into, so the
+// whole output goes out in one write. Zero initialize before use.
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int failed; // an allocation failed, the output is incomplete
+} carg_render;
+
+// Handler of a subcommand. cmd starts at the subcommand name and the
+// options of the subcommand are already parsed; returns the exit status.
+typedef int (*carg_handler)(ccommandline* cmd, coption* options, int num_options, void* user);
+
+typedef struct csubcommand_registry csubcommand_registry;
+
+// Subcommand of a multi-tool binary
+typedef struct {
+    const char* name;
+    carg_handler handler;                   // NULL for a group that only holds children
+    coption* options;                       // parsed only when this subcommand is selected
+    int num_options;
+    const coption_index* (*index)(void);    // prefix_index of an option table, may be NULL
+    const csubcommand_registry* children;   // nested subcommands ("remote add"), may be NULL
+    const char* help;
+} csubcommand;
+
+// Hash dispatch table over the names of a subcommand array, slots hold
+// positions in the array
+struct csubcommand_registry {
+    const csubcommand* commands;
+    int num_commands;
+    coption_slot* slots;
+    int capacity;
+    int owned; // slots were allocated by fscl_arg_registry_build
+};
+
+/*
+ * Declarative option tables. List the options once in an X-macro and
+ * FSCL_ARG_DEFINE_TABLE emits an id per option, a static option array
+ * holding the defaults and help text, and a lookup index that lives in
+ * static storage, so nothing is allocated or copied at startup:
+ *
+ *     static const combo_choice tool_modes[] = {{"debug", 0}, {"release", 1}};
+ *
+ *     #define TOOL_OPTIONS(X, P) \
+ *         X(P, verbose, COPTION_TYPE_BOOL, .bool_val = 0, FSCL_ARG_NO_CHOICES, "Print progress") \
+ *         X(P, jobs, COPTION_TYPE_INT, .int_val = 4, FSCL_ARG_NO_CHOICES, "Parallel jobs") \
+ *         X(P, mode, COPTION_TYPE_COMBO, .combo_val = 0, FSCL_ARG_CHOICES(tool_modes), "Build mode")
+ *
+ *     FSCL_ARG_DEFINE_TABLE(tool, TOOL_OPTIONS)
+ *
+ * defines tool_opt_verbose, tool_opt_jobs, tool_opt_mode and tool_opt_count,
+ * the array tool_options[] and tool_index(). The index is filled on the
+ * first call of tool_index(), make that call before sharing it between
+ * threads.
+ */
+#define FSCL_ARG_CHOICES(choices) .extra_data = (void*)(choices), .num_choices = (int)(sizeof(choices) / sizeof((choices)[0]))
+#define FSCL_ARG_NO_CHOICES .extra_data = NULL, .num_choices = 0
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FSCL_ARG_MAYBE_UNUSED __attribute__((unused))
+#else
+#define FSCL_ARG_MAYBE_UNUSED
+#endif
+
+#define FSCL_ARG_TABLE_ID(prefix, name, type, value, choices, help) prefix##_opt_##name,
+#define FSCL_ARG_TABLE_ENTRY(prefix, id, kind, initial, choices, text) \
+    {.name = #id, .type = kind, .value = {initial}, choices, .help = text},
+
+#define FSCL_ARG_DEFINE_TABLE(prefix, LIST)                                                       \
+    enum { LIST(FSCL_ARG_TABLE_ID, prefix) prefix##_opt_count };                                  \
+    static coption prefix##_options[] = {LIST(FSCL_ARG_TABLE_ENTRY, prefix)};                     \
+    static FSCL_ARG_MAYBE_UNUSED const coption_index* prefix##_index(void) {                       \
+        static coption_slot slots[prefix##_opt_count * 2 + 1];                                    \
+        static coption_index index;                                                               \
+        if (!index.slots) {                                                                       \
+            fscl_arg_index_init(&index, prefix##_options, prefix##_opt_count, slots,               \
+                                prefix##_opt_count * 2 + 1);                                      \
+        }                                                                                         \
+        return &index;                                                                            \
+    }
+
 // =================================================================
 // Available Functions
 // =================================================================
@@ -114,6 +321,57 @@ void fscl_arg_check_unrecognized(ccommandline* cmd, coption* options, int num_op
  */
 void fscl_arg_print_parsed_options(coption* options, int num_options);
 
+/**
+ * Get the width of the terminal behind a descriptor, from the terminal
+ * itself, then the COLUMNS variable, then 80.
+ *
+ * @param fd The descriptor of the terminal.
+ * @return   The number of columns.
+ */
+int fscl_arg_terminal_width(int fd);
+
+/**
+ * Render the usage text into a buffer. Option names and value hints form
+ * a column sized to the longest entry; help text is wrapped next to it.
+ *
+ * @param render       The buffer to append to.
+ * @param program_name The name of the program.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param width        The line width to wrap to, 0 for the width of stdout.
+ * @return             0 on success, -1 if the buffer could not grow.
+ */
+int fscl_arg_render_usage(carg_render* render, const char* program_name, const coption* options, int num_options,
+                          int width);
+
+/**
+ * Render the options with their values, parsed flags and sources into a
+ * buffer, as text lines or as one JSON object keyed by option name.
+ *
+ * @param render       The buffer to append to.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param format       The output format.
+ * @return             0 on success, -1 if the buffer could not grow.
+ */
+int fscl_arg_render_options(carg_render* render, const coption* options, int num_options, carg_render_format format);
+
+/**
+ * Write a rendered buffer to a descriptor and empty it.
+ *
+ * @param render The buffer to write.
+ * @param fd     The descriptor to write to.
+ * @return       0 on success, -1 on failure with errno set.
+ */
+int fscl_arg_render_flush(carg_render* render, int fd);
+
+/**
+ * Release a render buffer.
+ *
+ * @param render The buffer to erase.
+ */
+void fscl_arg_render_erase(carg_render* render);
+
 /**
  * Reset the parsed flags of the options to their initial state.
  *
@@ -144,6 +402,372 @@ combo_choice* fscl_arg_create_combo_choices(const char* names[], const int value
  */
 coption* fscl_arg_create_options(const char* names[], coption_type types[], coption_value values[], void* extra_data[], int num_options);
 
+/**
+ * Build a hash index over the names of an option array.
+ *
+ * @param index        The index to build.
+ * @param options      Array of coption structures to index.
+ * @param num_options  The number of options in the array.
+ * @return             0 on success, -1 if the table could not be allocated.
+ */
+int fscl_arg_index_build(coption_index* index, const coption* options, int num_options);
+
+/**
+ * Build a hash index into caller provided slots, without allocating.
+ *
+ * @param index        The index to build.
+ * @param options      Array of coption structures to index.
+ * @param num_options  The number of options in the array.
+ * @param slots        Storage for the table.
+ * @param capacity     The number of slots, more than num_options.
+ */
+void fscl_arg_index_init(coption_index* index, const coption* options, int num_options, coption_slot* slots, int capacity);
+
+/**
+ * Look up an option by name.
+ *
+ * @param index   The index to search.
+ * @param name    The option name, not necessarily NUL terminated.
+ * @param length  The length of the name.
+ * @return        The position of the option in the array, -1 if unknown.
+ */
+int fscl_arg_index_find(const coption_index* index, const char* name, size_t length);
+
+/**
+ * Release the table of an index built by fscl_arg_index_build.
+ *
+ * @param index The index to erase.
+ */
+void fscl_arg_index_erase(coption_index* index);
+
+/**
+ * Parse the command-line arguments using a prebuilt index of the options.
+ *
+ * @param cmd      Pointer to the ccommandline structure representing parsed command-line arguments.
+ * @param options  The options the index was built over.
+ * @param index    The index of the options.
+ */
+void fscl_arg_parse_indexed(ccommandline* cmd, coption* options, const coption_index* index);
+
+/**
+ * Check if a specific option has been parsed, using a prebuilt index.
+ *
+ * @param options      The options the index was built over.
+ * @param index        The index of the options.
+ * @param option_name  The name of the option to check for.
+ * @return             1 if the option is present, 0 otherwise.
+ */
+int fscl_arg_parse_has_indexed(const coption* options, const coption_index* index, const char* option_name);
+
+/**
+ * Check for unrecognized arguments using a prebuilt index of the options.
+ *
+ * @param cmd      Pointer to the ccommandline structure representing parsed command-line arguments.
+ * @param index    The index of the options.
+ */
+void fscl_arg_check_unrecognized_indexed(ccommandline* cmd, const coption_index* index);
+
+/**
+ * Open a response file. Tokens are separated by whitespace; single quotes
+ * keep everything up to the closing quote, double quotes allow \" and \\
+ * inside, and a backslash outside quotes escapes the next character.
+ *
+ * @param response The response file to initialize.
+ * @param path     The path of the file.
+ * @return         0 on success, -1 on failure with errno set.
+ */
+int fscl_arg_response_open(carg_response* response, const char* path);
+
+/**
+ * Cut the next token out of a response file, without allocating.
+ *
+ * @param response The response file to read.
+ * @return         The token, or NULL at the end of the file.
+ */
+const char* fscl_arg_response_next(carg_response* response);
+
+/**
+ * Close a response file, invalidating its tokens.
+ *
+ * @param response The response file to close.
+ */
+void fscl_arg_response_close(carg_response* response);
+
+/**
+ * Start reading the arguments of a command line, after the program name.
+ * An argument "@path" is replaced by the tokens of that file when it can
+ * be read, and kept as it is otherwise.
+ *
+ * @param tokens The token source to initialize.
+ * @param cmd    The command line to read.
+ */
+void fscl_arg_tokens_init(carg_tokens* tokens, const ccommandline* cmd);
+
+/**
+ * Get the next argument, a carg_next_token for a carg_tokens source.
+ *
+ * @param source The carg_tokens to read.
+ * @return       The next argument, or NULL at the end.
+ */
+const char* fscl_arg_tokens_next(void* source);
+
+/**
+ * Close the response files opened by a token source. String values parsed
+ * from them become invalid.
+ *
+ * @param tokens The token source to close.
+ */
+void fscl_arg_tokens_close(carg_tokens* tokens);
+
+/**
+ * Parse arguments pulled one at a time from a token source, so long
+ * argument lists are handled in a single pass without an argv copy.
+ *
+ * @param next         Returns the next token.
+ * @param source       Passed to next.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param index        Index of the options, or NULL to build one when useful.
+ */
+void fscl_arg_parse_stream(carg_next_token next, void* source, coption* options, int num_options, const coption_index* index);
+
+/**
+ * Parse the command-line arguments without ever exiting. Accepts "-name"
+ * and "--name", values given as the next argument or attached with '='
+ * ("--jobs=4"), bundles of single letter options ("-vx", "-j4") and "--"
+ * to end option parsing. A boolean option takes no value; only an
+ * attached on/off spelling ("--color=off") is accepted, anything else is
+ * reported as CARG_ERROR_UNEXPECTED_VALUE. Every problem is recorded and
+ * parsing goes on; an option whose value is rejected keeps its previous
+ * value.
+ *
+ * @param cmd          Pointer to the ccommandline structure representing parsed command-line arguments.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param index        Index of the options, or NULL to build one when useful.
+ * @param errors       Receives the problems found, release with fscl_arg_errors_erase.
+ * @return             The number of problems found, 0 on success.
+ */
+int fscl_arg_parse_checked(ccommandline* cmd, coption* options, int num_options, const coption_index* index, carg_errors* errors);
+
+/**
+ * Checked parse over a token source, see fscl_arg_parse_checked.
+ *
+ * @param next         Returns the next token.
+ * @param source       Passed to next.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param index        Index of the options, or NULL to build one when useful.
+ * @param errors       Receives the problems found, release with fscl_arg_errors_erase.
+ * @return             The number of problems found, 0 on success.
+ */
+int fscl_arg_parse_stream_checked(carg_next_token next, void* source, coption* options, int num_options,
+                                  const coption_index* index, carg_errors* errors);
+
+/**
+ * Resolve every option from its default, then the config file, then the
+ * environment, then the command line, each layer read in a single pass
+ * and overriding the one before. The layer that set each value is kept
+ * in its source field; parsed is only set by the command line.
+ *
+ * The config file holds "key = value" lines, "#" or ";" comments and
+ * "[section]" headers; keys before the first header always apply, keys
+ * of the named section too. A value may be quoted, and a boolean key
+ * without a value is set. Environment names are the prefix, '_' and the
+ * option name in upper case with other characters turned into '_'.
+ *
+ * @param layers       The layers to read, config_path, section and env_prefix set by the caller.
+ * @param cmd          The command line, NULL to skip.
+ * @param options      Array of coption structures representing available options.
+ * @param num_options  The number of options in the array.
+ * @param index        Index of the options, or NULL to build one when useful.
+ * @param errors       Receives the problems found, release with fscl_arg_errors_erase.
+ * @return             The number of problems found, or -1 with errno set when
+ *                     the config file exists but cannot be read.
+ */
+int fscl_arg_resolve(carg_layers* layers, ccommandline* cmd, coption* options, int num_options,
+                     const coption_index* index, carg_errors* errors);
+
+/**
+ * Release the config file of resolved layers. String values read from
+ * the file become invalid.
+ *
+ * @param layers The layers to close.
+ */
+void fscl_arg_layers_close(carg_layers* layers);
+
+/**
+ * Build the dispatch table of a subcommand array into caller provided
+ * slots, without allocating.
+ *
+ * @param registry      The registry to build.
+ * @param commands      Array of csubcommand structures.
+ * @param num_commands  The number of subcommands in the array.
+ * @param slots         Storage for the table.
+ * @param capacity      The number of slots, more than num_commands.
+ */
+void fscl_arg_registry_init(csubcommand_registry* registry, const csubcommand* commands, int num_commands,
+                            coption_slot* slots, int capacity);
+
+/**
+ * Build the dispatch table of a subcommand array.
+ *
+ * @param registry      The registry to build.
+ * @param commands      Array of csubcommand structures.
+ * @param num_commands  The number of subcommands in the array.
+ * @return              0 on success, -1 if the table could not be allocated.
+ */
+int fscl_arg_registry_build(csubcommand_registry* registry, const csubcommand* commands, int num_commands);
+
+/**
+ * Look up a subcommand by name.
+ *
+ * @param registry The registry to search.
+ * @param name     The subcommand name, not necessarily NUL terminated.
+ * @param length   The length of the name.
+ * @return         The subcommand, or NULL if unknown.
+ */
+const csubcommand* fscl_arg_registry_find(const csubcommand_registry* registry, const char* name, size_t length);
+
+/**
+ * Select the subcommand named by the leading arguments, following nested
+ * registries as long as the next argument names a child.
+ *
+ * @param registry  The top level registry.
+ * @param cmd       The command line, argv[1] names the subcommand.
+ * @param consumed  Receives the number of subcommand words matched, may be NULL.
+ * @return          The deepest subcommand matched, or NULL.
+ */
+const csubcommand* fscl_arg_registry_select(const csubcommand_registry* registry, const ccommandline* cmd, int* consumed);
+
+/**
+ * Run the subcommand named by the leading arguments. Only the option
+ * table of the selected subcommand is parsed, so the cost of a dispatch
+ * does not depend on the number of subcommands.
+ *
+ * @param registry  The top level registry.
+ * @param cmd       The command line, argv[1] names the subcommand.
+ * @param user      Passed to the handler.
+ * @param status    Receives the value returned by the handler, may be NULL.
+ * @param errors    Receives the problems found in the subcommand options,
+ *                  release with fscl_arg_errors_erase; may be NULL.
+ * @return          0 when a handler ran, -1 with errno set to ENOENT when
+ *                  no subcommand with a handler was named, or to EINVAL
+ *                  when its options did not parse and the handler did not run.
+ */
+int fscl_arg_dispatch(const csubcommand_registry* registry, ccommandline* cmd, void* user, int* status,
+                      carg_errors* errors);
+
+/**
+ * Render the subcommands of a registry into a buffer, with the help text
+ * aligned and wrapped as in fscl_arg_render_usage.
+ *
+ * @param render       The buffer to append to.
+ * @param program_name The name of the program.
+ * @param registry     The registry to list.
+ * @param width        The line width to wrap to, 0 for the width of stdout.
+ * @return             0 on success, -1 if the buffer could not grow.
+ */
+int fscl_arg_render_registry(carg_render* render, const char* program_name, const csubcommand_registry* registry,
+                             int width);
+
+/**
+ * Display the subcommands of a registry.
+ *
+ * @param program_name The name of the program.
+ * @param registry     The registry to list.
+ */
+void fscl_arg_registry_usage(const char* program_name, const csubcommand_registry* registry);
+
+/**
+ * Release the table of a registry built by fscl_arg_registry_build.
+ *
+ * @param registry The registry to erase.
+ */
+void fscl_arg_registry_erase(csubcommand_registry* registry);
+
+/**
+ * Set up an arena over a caller provided block of memory.
+ *
+ * @param arena    The arena to initialize.
+ * @param buffer   The memory to carve results from.
+ * @param capacity The size of the buffer in bytes.
+ */
+void fscl_arg_arena_init(carg_arena* arena, void* buffer, size_t capacity);
+
+/**
+ * Release everything carved from an arena at once.
+ *
+ * @param arena The arena to reset.
+ */
+void fscl_arg_arena_reset(carg_arena* arena);
+
+/**
+ * Parse a command line against a shared schema without touching it. The
+ * schema (the index and its options) is only read, so any number of
+ * threads may parse against it at the same time; each result starts
+ * from the option defaults and lives in the caller's arena. Parsing
+ * follows the rules of fscl_arg_parse_checked.
+ *
+ * @param schema   The index of the options, shared and left unchanged.
+ * @param cmd      Pointer to the ccommandline structure representing parsed command-line arguments.
+ * @param arena    The arena the values are allocated from.
+ * @param result   Receives the values.
+ * @param errors   Receives the problems found, or NULL to only count them.
+ * @return         The number of problems found, or -1 with errno set to
+ *                 ENOMEM when the arena is too small.
+ */
+int fscl_arg_parse_result(const coption_index* schema, ccommandline* cmd, carg_arena* arena, carg_result* result,
+                          carg_errors* errors);
+
+/**
+ * Parse a token source against a shared schema, see fscl_arg_parse_result.
+ *
+ * @param schema   The index of the options, shared and left unchanged.
+ * @param next     Returns the next token.
+ * @param source   Passed to next.
+ * @param arena    The arena the values are allocated from.
+ * @param result   Receives the values.
+ * @param errors   Receives the problems found, or NULL to only count them.
+ * @return         The number of problems found, or -1 with errno set to
+ *                 ENOMEM when the arena is too small.
+ */
+int fscl_arg_parse_result_stream(const coption_index* schema, carg_next_token next, void* source, carg_arena* arena,
+                                 carg_result* result, carg_errors* errors);
+
+/**
+ * Look up the value of an option in a parse result.
+ *
+ * @param result The parse result.
+ * @param name   The name of the option.
+ * @return       The value, or NULL if the schema has no such option.
+ */
+const coption_value* fscl_arg_result_get(const carg_result* result, const char* name);
+
+/**
+ * Check if an option was given in a parse result.
+ *
+ * @param result The parse result.
+ * @param name   The name of the option.
+ * @return       1 if the option was parsed, 0 otherwise.
+ */
+int fscl_arg_result_has(const carg_result* result, const char* name);
+
+/**
+ * Describe an error code.
+ *
+ * @param code The error code.
+ * @return     A short static description.
+ */
+const char* fscl_arg_error_string(carg_error_code code);
+
+/**
+ * Release the error list of a checked parse.
+ *
+ * @param errors The list to erase.
+ */
+void fscl_arg_errors_erase(carg_errors* errors);
+
 #ifdef __cplusplus
 }
 #endif
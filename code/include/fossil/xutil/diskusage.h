@@ -0,0 +1,88 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_DISKUSAGE_H
+#define FSCL_DISKUSAGE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "filesystem.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Index value meaning no node
+#define FSCL_DISKUSAGE_NONE ((size_t)-1)
+
+// One directory of a disk usage tree, totals include everything below it
+typedef struct {
+    const char* name;         // directory name, the scanned path for the root
+    size_t parent;            // index of the parent, FSCL_DISKUSAGE_NONE for the root
+    size_t first_child;       // index of the first subdirectory or FSCL_DISKUSAGE_NONE
+    size_t next_sibling;      // index of the next subdirectory of the parent
+    int depth;                // 0 for the root
+    uint64_t apparent_size;   // sum of file sizes in bytes
+    uint64_t disk_usage;      // allocated bytes
+    uint64_t files;           // non-directory entries, hard links counted once
+    uint64_t directories;     // directories, this one included
+} cdiskusage_node;
+
+// Directory sizes of a tree in preorder, children sorted by name
+typedef struct {
+    cdiskusage_node* nodes;   // nodes[0] is the root
+    size_t count;
+    char* names;              // storage for the node names
+    uint64_t errors;          // entries that could not be read
+} cdiskusage_tree;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Measure the disk usage of a directory tree. Directories are listed in
+ * parallel and each entry costs a single statx call asking only for size
+ * and blocks. Hard linked files are counted once. Directories deeper than
+ * max_depth get no node of their own and are added to their ancestor.
+ *
+ * @param root      The directory to measure.
+ * @param max_depth Deepest level that gets nodes, negative for no limit.
+ * @param threads   Worker threads to use, 0 for one per processor.
+ * @param tree      Receives the result, release it with fscl_diskusage_erase.
+ * @return          0 on success (unreadable entries are counted in errors),
+ *                  -1 on failure with errno set.
+ */
+int fscl_diskusage_scan(const cfilesystem* root, int max_depth, int threads, cdiskusage_tree* tree);
+
+/**
+ * Find a node by its path relative to the root, '/' separated.
+ *
+ * @param tree The tree to search.
+ * @param path The relative path, "" or "." for the root.
+ * @return     The node, or NULL if the tree has no node for the path.
+ */
+const cdiskusage_node* fscl_diskusage_find(const cdiskusage_tree* tree, const char* path);
+
+/**
+ * Release a disk usage tree.
+ *
+ * @param tree The tree to erase.
+ */
+void fscl_diskusage_erase(cdiskusage_tree* tree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEGLOB_H
+#define FSCL_FILEGLOB_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Compiled set of glob patterns
+typedef struct cfileglob cfileglob;
+
+// Called for each matching entry with its path relative to the walked
+// root and the index of the first pattern it matched. Return nonzero to
+// stop the walk.
+typedef int (*cfileglob_callback)(const char* path, int is_directory, size_t pattern, void* user);
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Compile glob patterns into one matcher. Patterns are '/' separated and
+ * relative to the directory they are matched against, and support '*',
+ * '?', bracket classes ("[a-z]", "[!0-9]"), "**" as a whole component for
+ * any number of directories, brace alternatives ("*.{c,h}") and '\' to
+ * escape. Wildcards do not match '/', dot files are matched like any
+ * other name.
+ *
+ * @param patterns The patterns to compile.
+ * @param count    The number of patterns.
+ * @return         The matcher, or NULL with errno set (EINVAL for a
+ *                 malformed pattern).
+ */
+cfileglob* fscl_fileglob_compile(const char* const* patterns, size_t count);
+
+/**
+ * Match a relative path against a compiled set of patterns.
+ *
+ * @param glob The compiled patterns.
+ * @param path The path to test.
+ * @return     The index of the first pattern that matches, -1 if none.
+ */
+long fscl_fileglob_match(const cfileglob* glob, const char* path);
+
+/**
+ * Walk a directory tree and report every entry matching a pattern. Only
+ * directories some pattern can still match are opened, and components
+ * without wildcards are looked up directly instead of listing the
+ * directory. Symbolic links are reported but not followed.
+ *
+ * @param glob     The compiled patterns.
+ * @param root     The directory to walk.
+ * @param callback Called for each match.
+ * @param user     Passed to the callback.
+ * @return         The number of matches reported, -1 on failure with
+ *                 errno set.
+ */
+long fscl_fileglob_walk(const cfileglob* glob, const char* root, cfileglob_callback callback, void* user);
+
+/**
+ * Release a compiled set of patterns.
+ *
+ * @param glob The matcher to erase.
+ */
+void fscl_fileglob_erase(cfileglob* glob);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEIO_H
+#define FSCL_FILEIO_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Operations that can be queued on a batch
+typedef enum {
+    FILEIO_OP_OPEN,   // open path with flags and mode, result is the descriptor
+    FILEIO_OP_CLOSE,  // close fd
+    FILEIO_OP_STAT,   // stat path into info
+    FILEIO_OP_READ,   // read length bytes at offset from fd into buffer
+    FILEIO_OP_WRITE,  // write length bytes at offset from buffer to fd
+    FILEIO_OP_UNLINK, // remove the file at path
+    FILEIO_OP_MKDIR,  // create the directory at path with mode
+    FILEIO_OP_RMDIR   // remove the empty directory at path
+} cfileio_op;
+
+// Engines a batch can run on
+typedef enum {
+    FILEIO_BACKEND_THREADS, // blocking syscalls spread over a thread pool
+    FILEIO_BACKEND_URING    // io_uring submission and completion rings
+} cfileio_backend;
+
+// File metadata filled in by FILEIO_OP_STAT
+typedef struct {
+    unsigned long long size;
+    unsigned long long inode;
+    long long mtime_sec;
+    long mtime_nsec;
+    unsigned int mode;
+} cfileio_stat;
+
+typedef struct cfileio_request cfileio_request;
+
+// Completion callback, runs on the thread calling fscl_fileio_wait
+typedef void (*cfileio_callback)(cfileio_request* request, void* user);
+
+// A single queued operation, owned by the caller until its callback ran
+struct cfileio_request {
+    cfileio_op op;
+    const char* path;          // OPEN, STAT, UNLINK, MKDIR, RMDIR
+    int fd;                    // CLOSE, READ, WRITE
+    int flags;                 // OPEN
+    unsigned int mode;         // OPEN, MKDIR
+    void* buffer;              // READ, WRITE
+    size_t length;             // READ, WRITE, at most 1 GiB moves per request
+    long long offset;          // READ, WRITE
+    cfileio_stat* info;        // STAT
+    cfileio_callback callback; // optional completion callback
+    void* user;                // passed to the callback
+    long long result;          // >= 0 on success, -errno on failure
+};
+
+// Opaque batch context
+typedef struct cfileio cfileio;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Create a batch context. io_uring is used when the kernel provides it;
+ * operations the ring cannot run, or every operation when io_uring is
+ * unavailable, go to a pool of worker threads.
+ *
+ * @param depth   Maximum operations in flight on the ring, 0 for a default.
+ * @param threads Worker threads for the fallback, 0 for one per processor.
+ * @return        The new context, or NULL on failure.
+ */
+cfileio* fscl_fileio_create(unsigned int depth, int threads);
+
+/**
+ * Report the engine a context runs on.
+ *
+ * @param io The batch context.
+ * @return   The backend in use.
+ */
+cfileio_backend fscl_fileio_backend(const cfileio* io);
+
+/**
+ * Start operations without waiting for them. Requests that fit on the
+ * ring are submitted to the kernel before this returns, the rest wait
+ * for ring space or go to the workers; they complete in any order.
+ *
+ * @param io       The batch context.
+ * @param requests Array of requests that must stay valid until completion.
+ * @param count    Number of requests in the array.
+ * @return         Number of leading requests accepted, which complete
+ *                 through fscl_fileio_wait. Fewer than count means the
+ *                 rest were not queued and errno says why; -1 for
+ *                 invalid arguments.
+ */
+long fscl_fileio_submit(cfileio* io, cfileio_request* requests, size_t count);
+
+/**
+ * Drive queued operations until all of them completed, running callbacks
+ * as completions arrive. Callbacks may queue further requests.
+ *
+ * @param io The batch context.
+ * @return   Number of failed operations, or -1 if the context failed.
+ */
+long fscl_fileio_wait(cfileio* io);
+
+/**
+ * Wait for outstanding operations and free a batch context.
+ *
+ * @param io The batch context.
+ */
+void fscl_fileio_erase(cfileio* io);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEMAP_H
+#define FSCL_FILEMAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Access modes for a file view
+typedef enum {
+    FILEMAP_READ_ONLY,  // shared read-only view
+    FILEMAP_READ_WRITE, // shared view, writes go back to the file
+    FILEMAP_PRIVATE     // copy-on-write view, writes stay in memory
+} cfilemap_mode;
+
+// Access pattern hints for a file view
+typedef enum {
+    FILEMAP_ADVICE_NORMAL,
+    FILEMAP_ADVICE_SEQUENTIAL,
+    FILEMAP_ADVICE_RANDOM,
+    FILEMAP_ADVICE_WILLNEED,
+    FILEMAP_ADVICE_HUGEPAGE
+} cfilemap_advice;
+
+// Structure to represent a view of a file in memory
+typedef struct {
+    int fd;             // descriptor of the underlying file
+    cfilemap_mode mode; // access mode the view was opened with
+    size_t size;        // total size of the file in bytes
+    size_t offset;      // file offset of the first byte in data
+    size_t length;      // number of bytes visible through data
+    char* data;         // first byte of the current window
+    void* base;         // start of the mapping or fallback buffer
+    size_t base_length; // length of the mapping or fallback buffer
+    size_t window;      // window size limit, 0 maps the whole file
+    int mapped;         // 1 when backed by mmap, 0 for the buffered fallback
+} cfilemap;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Open a memory view of a file. When the file cannot be mapped (pipes,
+ * procfs entries, platforms without mmap) the view falls back to a single
+ * buffered read into the heap so callers see the same interface.
+ *
+ * @param map    The view to initialize.
+ * @param path   The path of the file to open.
+ * @param mode   The access mode for the view.
+ * @param window Maximum bytes to map at once, 0 to map the whole file.
+ * @return       0 on success, -1 on failure with errno set.
+ */
+int fscl_filemap_open(cfilemap* map, const char* path, cfilemap_mode mode, size_t window);
+
+/**
+ * Pass an access pattern hint for the current window to the kernel.
+ *
+ * @param map    The view to advise.
+ * @param advice The expected access pattern.
+ * @return       0 on success, -1 if the hint was rejected.
+ */
+int fscl_filemap_advise(cfilemap* map, cfilemap_advice advice);
+
+/**
+ * Move the window of a view to another region of the file. The region is
+ * clamped to the end of the file; a region already covered by the current
+ * mapping is served without remapping.
+ *
+ * @param map    The view to move.
+ * @param offset The file offset of the new window.
+ * @param length The number of bytes wanted, 0 for the configured window size.
+ * @return       0 on success, -1 on failure with errno set.
+ */
+int fscl_filemap_window(cfilemap* map, size_t offset, size_t length);
+
+/**
+ * Flush changes made through a read-write view back to the file.
+ *
+ * @param map The view to flush.
+ * @return    0 on success, -1 on failure with errno set.
+ */
+int fscl_filemap_sync(cfilemap* map);
+
+/**
+ * Close a view, flushing pending changes of a read-write view.
+ *
+ * @param map The view to close.
+ */
+void fscl_filemap_close(cfilemap* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEPATH_H
+#define FSCL_FILEPATH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Paths up to this length live inside the builder without allocating
+#define FSCL_FILEPATH_INLINE 256
+
+// Directory handle meaning the current working directory, like AT_FDCWD
+#define FSCL_FILEPATH_CWD (-100)
+
+// Structure to represent a path being built. Read it through
+// fscl_filepath_cstr, the text moves to the heap once it outgrows the
+// inline buffer.
+typedef struct {
+    char* heap;                        // heap buffer, NULL while inline
+    size_t length;                     // length of the path
+    size_t capacity;                   // usable bytes of the heap buffer
+    char inline_path[FSCL_FILEPATH_INLINE];
+} cfilepath;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Initialize an empty path builder.
+ *
+ * @param path The builder to initialize.
+ */
+void fscl_filepath_init(cfilepath* path);
+
+/**
+ * Replace the contents of a path builder.
+ *
+ * @param path The builder to update.
+ * @param text The new path.
+ * @return     0 on success, -1 on allocation failure.
+ */
+int fscl_filepath_set(cfilepath* path, const char* text);
+
+/**
+ * Append a component, adding a separator when needed. An absolute
+ * component replaces the whole path.
+ *
+ * @param path      The builder to extend.
+ * @param component The component to append.
+ * @return          0 on success, -1 on allocation failure.
+ */
+int fscl_filepath_join(cfilepath* path, const char* component);
+
+/**
+ * Cut a path back to an earlier length, typically one saved before a
+ * join, so loops over directory entries reuse the same builder.
+ *
+ * @param path   The builder to shorten.
+ * @param length The new length, ignored if not shorter.
+ */
+void fscl_filepath_truncate(cfilepath* path, size_t length);
+
+/**
+ * Normalize a path in place: repeated separators collapse, "." components
+ * go away and ".." removes the component before it. The result is purely
+ * lexical, symbolic links are not resolved.
+ *
+ * @param path The builder to normalize.
+ */
+void fscl_filepath_normalize(cfilepath* path);
+
+/**
+ * Reduce a path to its parent directory in place ("." when it has none).
+ *
+ * @param path The builder to update.
+ */
+void fscl_filepath_dirname(cfilepath* path);
+
+/**
+ * Reduce a path to its final component in place.
+ *
+ * @param path The builder to update.
+ */
+void fscl_filepath_basename(cfilepath* path);
+
+/**
+ * Get the text of a path builder.
+ *
+ * @param path The builder to read.
+ * @return     The NUL terminated path, valid until the builder changes.
+ */
+const char* fscl_filepath_cstr(const cfilepath* path);
+
+/**
+ * Release the heap buffer of a path builder, if any.
+ *
+ * @param path The builder to erase.
+ */
+void fscl_filepath_erase(cfilepath* path);
+
+/**
+ * Open a directory handle for the fd-relative functions below.
+ *
+ * @param dirfd A directory handle or FSCL_FILEPATH_CWD.
+ * @param name  The directory to open, relative to dirfd.
+ * @return      The handle, or -1 on failure with errno set.
+ */
+int fscl_filepath_open_dir(int dirfd, const char* name);
+
+/**
+ * Open a file relative to a directory handle, so deep trees are walked
+ * without rebuilding or resolving the full path on every call.
+ *
+ * @param dirfd A directory handle or FSCL_FILEPATH_CWD.
+ * @param name  The file to open, relative to dirfd.
+ * @param flags open flags.
+ * @param mode  Permissions for a created file.
+ * @return      The descriptor, or -1 on failure with errno set.
+ */
+int fscl_filepath_openat(int dirfd, const char* name, int flags, int mode);
+
+/**
+ * Create a directory relative to a directory handle.
+ *
+ * @param dirfd A directory handle or FSCL_FILEPATH_CWD.
+ * @param name  The directory to create.
+ * @return      0 on success, -1 on failure with errno set.
+ */
+int fscl_filepath_mkdirat(int dirfd, const char* name);
+
+/**
+ * Remove a file or an empty directory relative to a directory handle.
+ *
+ * @param dirfd        A directory handle or FSCL_FILEPATH_CWD.
+ * @param name         The entry to remove.
+ * @param is_directory 1 to remove a directory, 0 for anything else.
+ * @return             0 on success, -1 on failure with errno set.
+ */
+int fscl_filepath_unlinkat(int dirfd, const char* name, int is_directory);
+
+/**
+ * Check what an entry relative to a directory handle is, without
+ * following a final symbolic link.
+ *
+ * @param dirfd A directory handle or FSCL_FILEPATH_CWD.
+ * @param name  The entry to check.
+ * @return      2 for a directory, 1 for anything else, 0 if missing.
+ */
+int fscl_filepath_existsat(int dirfd, const char* name);
+
+/**
+ * Close a directory handle returned by fscl_filepath_open_dir.
+ *
+ * @param dirfd The handle to close.
+ */
+void fscl_filepath_close_dir(int dirfd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
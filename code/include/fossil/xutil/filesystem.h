@@ -18,6 +18,8 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 // Structure to represent a directory
 typedef struct {
     char* path;
@@ -81,6 +83,50 @@ void fscl_filesys_remove_file(const cfilesystem* directory, const char* filename
  */
 void fscl_filesys_change_directory(cfilesystem* directory, const char* new_path);
 
+/**
+ * Create the directory of a filesystem object along with any missing
+ * parents. mkdir is tried on the full path first and only the missing
+ * ancestors are walked: a new leaf costs one mkdir, an existing tree a
+ * mkdir plus a stat to confirm the path is a directory.
+ *
+ * @param directory The directory to create.
+ * @return          0 on success or if it already exists, -1 on failure.
+ */
+int fscl_filesys_create_directories(const cfilesystem* directory);
+
+/**
+ * Remove a file, or a directory and everything below it. Subtrees are
+ * emptied in parallel with unlinkat relative to open directory handles.
+ * A path that does not exist counts as removed.
+ *
+ * @param directory The file or directory to remove.
+ * @param threads   Worker threads to use, 0 for one per processor.
+ * @return          0 on success, -1 if any entry could not be removed.
+ */
+int fscl_filesys_remove_all(const cfilesystem* directory, int threads);
+
+/**
+ * Copy a regular file without going through user space where possible.
+ * A reflink clone is tried first, then copy_file_range, sendfile and a
+ * buffered loop; holes in sparse files are preserved.
+ *
+ * @param source      The file to copy.
+ * @param destination The file to create or overwrite.
+ * @return            0 on success, -1 on failure with errno set.
+ */
+int fscl_filesys_copy_file(const cfilesystem* source, const cfilesystem* destination);
+
+/**
+ * Move a file. Within a filesystem this is a single rename; across
+ * filesystems the file is copied to a temporary name beside the
+ * destination, synced and renamed into place before the source is removed.
+ *
+ * @param source      The file to move.
+ * @param destination The new path of the file.
+ * @return            0 on success, -1 on failure with errno set.
+ */
+int fscl_filesys_move_file(const cfilesystem* source, const cfilesystem* destination);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,97 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEWATCH_H
+#define FSCL_FILEWATCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Kinds of change, combined as flags when coalesced
+typedef enum {
+    FILEWATCH_CREATED  = 1 << 0,
+    FILEWATCH_DELETED  = 1 << 1,
+    FILEWATCH_MODIFIED = 1 << 2,
+    FILEWATCH_ATTRIB   = 1 << 3,
+    FILEWATCH_MOVED    = 1 << 4,
+    FILEWATCH_OVERFLOW = 1 << 5  // the kernel dropped events, rescan what you track
+} cfilewatch_kind;
+
+// One path of a delivered batch
+typedef struct {
+    const char* path;     // root joined with the path relative to it
+    unsigned int events;  // cfilewatch_kind flags seen for the path during the tick
+    int is_directory;
+} cfilewatch_event;
+
+// Receives every path that changed during one tick, each path once
+typedef void (*cfilewatch_callback)(const cfilewatch_event* events, size_t count, void* user);
+
+// Opaque watcher
+typedef struct cfilewatch cfilewatch;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Start watching a directory. In recursive mode subdirectories are
+ * watched too, including those created while the watcher runs.
+ *
+ * @param root      The directory to watch.
+ * @param recursive 1 to watch the whole tree below root.
+ * @param tick_ms   Milliseconds to keep collecting after the first event
+ *                  so bursts arrive as one batch, 0 to deliver at once.
+ * @return          The watcher, or NULL with errno set (ENOSYS where
+ *                  inotify is not available).
+ */
+cfilewatch* fscl_filewatch_create(const char* root, int recursive, int tick_ms);
+
+/**
+ * Get a descriptor that becomes readable when events are pending, for
+ * use with poll, select or epoll. Call fscl_filewatch_poll with a timeout
+ * of 0 once it is readable.
+ *
+ * @param watch The watcher.
+ * @return      The descriptor.
+ */
+int fscl_filewatch_fd(const cfilewatch* watch);
+
+/**
+ * Wait for changes and deliver them as one coalesced batch. Repeated
+ * events for a path are merged, and a path created and deleted within
+ * the same tick is dropped.
+ *
+ * @param watch      The watcher.
+ * @param timeout_ms Milliseconds to wait for the first event, -1 forever.
+ * @param callback   Receives the batch; not called for an empty batch.
+ * @param user       Passed to the callback.
+ * @return           Number of paths delivered, 0 on timeout, -1 on failure.
+ */
+int fscl_filewatch_poll(cfilewatch* watch, int timeout_ms, cfilewatch_callback callback, void* user);
+
+/**
+ * Stop watching and free the watcher.
+ *
+ * @param watch The watcher to erase.
+ */
+void fscl_filewatch_erase(cfilewatch* watch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FILEWRITER_H
+#define FSCL_FILEWRITER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Options for a file writer, combined with bitwise or
+typedef enum {
+    FILEWRITER_BUFFERED = 0,         // plain buffered writes through the page cache
+    FILEWRITER_DIRECT = 1 << 0,      // bypass the page cache where the filesystem allows it
+    FILEWRITER_PREALLOCATE = 1 << 1  // reserve the expected size up front
+} cfilewriter_flags;
+
+// Structure to represent a file being replaced atomically
+typedef struct {
+    int fd;                    // descriptor of the temporary file
+    char* path;                // destination path
+    char* temp_path;           // temporary file beside the destination
+    char* buffer;              // aligned write-combining buffer
+    size_t capacity;           // size of the buffer
+    size_t used;               // bytes waiting in the buffer
+    unsigned long long offset; // bytes already written to the temporary file
+    unsigned int flags;        // options in effect, DIRECT is dropped when unsupported
+    int error;                 // first write error, reported on commit
+} cfilewriter;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Start replacing a file. Data goes to a temporary file in the same
+ * directory and only replaces the destination on commit, so readers see
+ * either the old or the new content, never a partial write.
+ *
+ * @param writer        The writer to initialize.
+ * @param path          The destination path.
+ * @param flags         Options from cfilewriter_flags.
+ * @param expected_size Expected final size, 0 if unknown. Sizes the buffer
+ *                      and the preallocation.
+ * @return              0 on success, -1 on failure with errno set.
+ */
+int fscl_filewriter_open(cfilewriter* writer, const char* path, unsigned int flags, size_t expected_size);
+
+/**
+ * Append data to a writer. Small writes are combined in the buffer and
+ * reach the file in large aligned blocks.
+ *
+ * @param writer The writer to append to.
+ * @param data   The bytes to append.
+ * @param length The number of bytes.
+ * @return       0 on success, -1 on failure with errno set.
+ */
+int fscl_filewriter_write(cfilewriter* writer, const void* data, size_t length);
+
+/**
+ * Flush, make durable and rename a writer into place, then release it.
+ * On failure the temporary file is removed and the destination is left
+ * untouched.
+ *
+ * @param writer The writer to commit.
+ * @return       0 on success, -1 on failure with errno set and the
+ *               destination untouched, 1 with errno set when the file was
+ *               renamed into place but syncing its directory failed, so
+ *               the rename may not survive a crash. Do not retry or roll
+ *               back on 1.
+ */
+int fscl_filewriter_commit(cfilewriter* writer);
+
+/**
+ * Commit many writers with one filesystem sync per device instead of one
+ * fsync per file. Writers that fail are aborted, the others still commit.
+ *
+ * @param writers The writers to commit.
+ * @param count   The number of writers.
+ * @return        0 if every writer was committed. -1 with errno set by the
+ *                first failure if some writer could not be committed (the
+ *                others are still in place). 1 with errno set if every
+ *                writer was renamed into place but the final sync of the
+ *                directory entries failed, so the renames may not survive
+ *                a crash.
+ */
+int fscl_filewriter_commit_all(cfilewriter* writers, size_t count);
+
+/**
+ * Discard a writer, removing its temporary file.
+ *
+ * @param writer The writer to discard.
+ */
+void fscl_filewriter_abort(cfilewriter* writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_FINGERPRINT_H
+#define FSCL_FINGERPRINT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Streaming state of the 64-bit content hash (XXH64)
+typedef struct {
+    uint64_t lanes[4];
+    uint64_t seed;
+    uint64_t total;
+    unsigned char buffer[32];
+    size_t buffered;
+} cfingerprint_hasher;
+
+// One regular file of a scanned tree
+typedef struct {
+    char* path;          // relative to the scanned root, '/' separated
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime_sec;
+    long mtime_nsec;
+    uint64_t hash;
+} cfingerprint_entry;
+
+// Files of a tree sorted by path
+typedef struct {
+    cfingerprint_entry* entries;
+    size_t count;
+    size_t capacity;
+} cfingerprint_manifest;
+
+// Differences between two scans, paths point into the manifests
+typedef struct {
+    const char** added;
+    size_t added_count;
+    const char** removed;
+    size_t removed_count;
+    const char** modified;
+    size_t modified_count;
+    size_t hashed;       // files read during the scan
+    size_t reused;       // files whose hash came from the previous manifest
+} cfingerprint_diff;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Start a streaming hash.
+ *
+ * @param hasher The state to initialize.
+ * @param seed   The seed of the hash.
+ */
+void fscl_fingerprint_hash_init(cfingerprint_hasher* hasher, uint64_t seed);
+
+/**
+ * Feed bytes into a streaming hash.
+ *
+ * @param hasher The state to update.
+ * @param data   The bytes to hash.
+ * @param length The number of bytes.
+ */
+void fscl_fingerprint_hash_update(cfingerprint_hasher* hasher, const void* data, size_t length);
+
+/**
+ * Get the hash of everything fed so far. The state stays usable.
+ *
+ * @param hasher The state to read.
+ * @return       The 64-bit hash.
+ */
+uint64_t fscl_fingerprint_hash_digest(const cfingerprint_hasher* hasher);
+
+/**
+ * Hash a buffer in one call.
+ *
+ * @param data   The bytes to hash.
+ * @param length The number of bytes.
+ * @param seed   The seed of the hash.
+ * @return       The 64-bit hash.
+ */
+uint64_t fscl_fingerprint_hash64(const void* data, size_t length, uint64_t seed);
+
+/**
+ * Hash every regular file below a directory. Files whose inode, size and
+ * modification time match the previous manifest reuse the stored hash;
+ * the rest are read through memory maps on a pool of worker threads.
+ * A subdirectory that cannot be opened (EACCES, EMFILE) fails the scan
+ * rather than having its files reported as removed.
+ *
+ * @param root     The directory to scan.
+ * @param previous The manifest of the last scan, may be NULL.
+ * @param current  Receives the new manifest.
+ * @param diff     Receives the differences to previous, may be NULL.
+ * @param threads  Worker threads to use, 0 for one per processor.
+ * @return         0 on success, -1 on failure with errno set.
+ */
+int fscl_fingerprint_scan(const char* root, const cfingerprint_manifest* previous,
+                          cfingerprint_manifest* current, cfingerprint_diff* diff, int threads);
+
+/**
+ * Combine all file hashes and paths of a manifest into one tree hash.
+ *
+ * @param manifest The manifest to summarize.
+ * @return         The tree hash.
+ */
+uint64_t fscl_fingerprint_tree_hash(const cfingerprint_manifest* manifest);
+
+/**
+ * Write a manifest to a file.
+ *
+ * @param manifest The manifest to store.
+ * @param path     The file to write.
+ * @return         0 on success, -1 on failure.
+ */
+int fscl_fingerprint_save(const cfingerprint_manifest* manifest, const char* path);
+
+/**
+ * Read a manifest written by fscl_fingerprint_save.
+ *
+ * @param manifest Receives the manifest.
+ * @param path     The file to read.
+ * @return         0 on success, -1 on failure.
+ */
+int fscl_fingerprint_load(cfingerprint_manifest* manifest, const char* path);
+
+/**
+ * Free the entries of a manifest.
+ *
+ * @param manifest The manifest to erase.
+ */
+void fscl_fingerprint_manifest_erase(cfingerprint_manifest* manifest);
+
+/**
+ * Free the lists of a diff.
+ *
+ * @param diff The diff to erase.
+ */
+void fscl_fingerprint_diff_erase(cfingerprint_diff* diff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAVAENTROPY_H
+#define FSCL_LAVAENTROPY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "lavalamp.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Size of a ChaCha20 key, nonce and output block in bytes
+#define LAVAENTROPY_KEY_SIZE 32
+#define LAVAENTROPY_NONCE_SIZE 12
+#define LAVAENTROPY_BLOCK_SIZE 64
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Compute one ChaCha20 block (RFC 8439).
+ *
+ * @param key     The 32-byte key.
+ * @param counter The block counter.
+ * @param nonce   The 12-byte nonce.
+ * @param out     Receives the 64-byte key stream block.
+ */
+void fscl_lavaentropy_chacha20(const unsigned char key[LAVAENTROPY_KEY_SIZE], uint32_t counter,
+                               const unsigned char nonce[LAVAENTROPY_NONCE_SIZE],
+                               unsigned char out[LAVAENTROPY_BLOCK_SIZE]);
+
+/**
+ * Mix bytes into the shared entropy pool. Mixed bytes never reduce the
+ * strength of the pool, so untrusted input is fine.
+ *
+ * @param data   The bytes to mix.
+ * @param length The number of bytes.
+ */
+void fscl_lavaentropy_mix(const void* data, size_t length);
+
+/**
+ * Mix the state of multiple lava lamps into the shared entropy pool.
+ *
+ * @param lamps    Pointer to the array of lava lamps.
+ * @param numLamps The number of lava lamps.
+ */
+void fscl_lavaentropy_mix_lamps(const clavalamp* lamps, int numLamps);
+
+/**
+ * Fill a buffer with cryptographically secure random bytes. Each thread
+ * runs its own ChaCha20 stream keyed from the pool, which in turn is fed
+ * by the operating system, timer jitter and lamp state. Output blocks
+ * are buffered per thread and the key is replaced by fresh key stream
+ * on every refill, so bytes already handed out cannot be recovered
+ * from the state. A thread reseeds after a fork and after every few
+ * hundred kilobytes; other calls make no system call.
+ *
+ * @param out    Receives the random bytes.
+ * @param length The number of bytes.
+ * @return       0 on success, -1 with errno set when the operating
+ *               system source fails while reseeding.
+ */
+int fscl_lavaentropy_bytes(void* out, size_t length);
+
+/**
+ * Generate 64 cryptographically secure random bits.
+ *
+ * @param value Receives the random value.
+ * @return      0 on success, -1 with errno set on failure.
+ */
+int fscl_lavaentropy_u64(uint64_t* value);
+
+/**
+ * Reseed the stream of the calling thread from the pool and erase its
+ * buffered output.
+ *
+ * @return 0 on success, -1 with errno set on failure.
+ */
+int fscl_lavaentropy_reseed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -18,12 +18,60 @@ extern "C"
 {
 #endif
 
+#include "fingerprint.h"
+#include "lavarng.h"
+#include <stddef.h>
+
 // Simulate the virtual lava lamp state
 typedef struct {
     double position;
     double velocity;
 } clavalamp;
 
+// Structure-of-arrays storage for many lamps: positions and velocities
+// live in separate 64-byte aligned arrays so the kernels below run
+// several lamps per instruction
+typedef struct {
+    double* position;
+    double* velocity;
+    size_t count;
+} clavafield;
+
+// Lamps per chunk of a parallel simulation, each chunk has its own stream
+#define FSCL_LAVA_CHUNK 1024
+
+// Hash functions for lamp state
+typedef enum {
+    LAVA_HASH_FAST,  // XXH64, 8-byte digest, for checksums and change detection
+    LAVA_HASH_STRONG // BLAKE2b-256, 32-byte digest, for deriving seeds
+} clavahash_mode;
+
+// Largest digest produced by fscl_lava_hash_final
+#define FSCL_LAVA_HASH_SIZE 32
+
+// Streaming hash over lamp state, fed in place without a staging copy
+typedef struct {
+    clavahash_mode mode;
+    union {
+        cfingerprint_hasher fast;
+        struct {
+            uint64_t h[8];
+            uint64_t total[2];
+            unsigned char buffer[128];
+            size_t buffered;
+        } strong;
+    } s;
+} clavahash;
+
+// Number of lamps in each category checked by fscl_lava_analyze
+typedef struct {
+    size_t extreme_position; // |position| > 10
+    size_t extreme_velocity; // |velocity| > 5
+    size_t stagnant;         // |velocity| < 0.1
+    size_t erratic;          // |velocity| > 2 and |position| > 5
+    size_t consistent;       // |velocity| > 0.1 and |position| < 5
+} clavafield_report;
+
 // =================================================================
 // Avalable functions
 // =================================================================
@@ -60,7 +108,9 @@ void fscl_lava_capture_state(clavalamp* lamp);
 void fscl_lava_combine_states(clavalamp* lamps, int numLamps, char* combinedState);
 
 /**
- * Hash the combined state string of lava lamps.
+ * Hash the combined state string of lava lamps. Kept for existing
+ * callers; fscl_lava_hash_state hashes the lamps in place and is much
+ * faster.
  *
  * @param combinedState The combined state string to hash.
  * @param length        The length of the combined state string.
@@ -108,19 +158,170 @@ void fscl_lava_reset(clavalamp* lamps, int numLamps);
 void fscl_lava_randomize(clavalamp* lamps, int numLamps);
 
 /**
- * Seed the random number generator for lava lamps.
+ * Seed the random number generator for lava lamps. Each thread has a
+ * generator of its own, this seeds the one of the calling thread.
  *
  * @param seed The seed value for the random number generator.
  */
 void fscl_lava_seed(unsigned int seed);
 
 /**
- * Generate a random number for lava lamps.
+ * Generate a random number for lava lamps, without any lock.
  *
- * @return The generated random number.
+ * @return The generated random number, in [0, 2^31).
  */
 int fscl_lava_random(void);
 
+/**
+ * Create a lamp field with every lamp at rest at the origin.
+ *
+ * @param field The field to initialize.
+ * @param count The number of lamps.
+ * @return      0 on success, -1 on failure with errno set.
+ */
+int fscl_lava_field_create(clavafield* field, size_t count);
+
+/**
+ * Erase a lamp field.
+ *
+ * @param field The field to erase.
+ */
+void fscl_lava_field_erase(clavafield* field);
+
+/**
+ * Copy lamps into a field of the same size.
+ *
+ * @param field The field to fill.
+ * @param lamps The lamps to copy, field->count of them.
+ */
+void fscl_lava_field_load(clavafield* field, const clavalamp* lamps);
+
+/**
+ * Copy the lamps of a field out to an array of lamps.
+ *
+ * @param field The field to copy.
+ * @param lamps Receives field->count lamps.
+ */
+void fscl_lava_field_store(const clavafield* field, clavalamp* lamps);
+
+/**
+ * Put every lamp of a field back at rest at the origin.
+ *
+ * @param field The field to reset.
+ */
+void fscl_lava_field_reset(clavafield* field);
+
+/**
+ * Add noise in [-0.5, 0.5) to every position and velocity, like
+ * fscl_lava_capture_state does for a single lamp.
+ *
+ * @param field The field to randomize.
+ * @param lanes The generator to draw from, NULL for the generator of the calling thread.
+ */
+void fscl_lava_field_randomize(clavafield* field, clavarng_lanes* lanes);
+
+/**
+ * Move every lamp along its velocity for a time step.
+ *
+ * @param field The field to update.
+ * @param dt    The length of the time step.
+ */
+void fscl_lava_field_step(clavafield* field, double dt);
+
+/**
+ * Count the lamps of a field in each category of fscl_lava_analyze, in
+ * one pass and without printing.
+ *
+ * @param field  The field to analyze.
+ * @param report Receives the counts.
+ */
+void fscl_lava_field_analyze(const clavafield* field, clavafield_report* report);
+
+/**
+ * Simulate a lamp field on several threads. At every step each lamp
+ * gets noise in [-0.5, 0.5) on its position and velocity, then moves
+ * along its velocity for dt (0 only adds noise). Lamps are split into
+ * chunks of FSCL_LAVA_CHUNK with a counter-based stream per chunk and
+ * step derived from the seed, so the result is bit-identical for any
+ * thread count, and running steps a then b from first_step a matches
+ * running a + b at once.
+ *
+ * @param field      The field to simulate.
+ * @param seed       The seed of the simulation.
+ * @param first_step The index of the first step, to continue a simulation.
+ * @param steps      The number of steps.
+ * @param dt         The length of a time step.
+ * @param threads    The number of threads, 0 for one per processor.
+ * @return           0 on success, -1 on failure with errno set.
+ */
+int fscl_lava_field_simulate(clavafield* field, uint64_t seed, uint64_t first_step, size_t steps, double dt,
+                             int threads);
+
+/**
+ * Start a streaming hash over lamp state.
+ *
+ * @param hash The hash to initialize.
+ * @param mode The hash function to use.
+ * @param key  The seed of a fast hash, or the key of a strong hash (0 for unkeyed).
+ */
+void fscl_lava_hash_init(clavahash* hash, clavahash_mode mode, uint64_t key);
+
+/**
+ * Feed bytes into a streaming hash.
+ *
+ * @param hash   The hash to feed.
+ * @param data   The bytes to hash.
+ * @param length The number of bytes.
+ */
+void fscl_lava_hash_update(clavahash* hash, const void* data, size_t length);
+
+/**
+ * Feed an array of lava lamps into a streaming hash, in the byte layout
+ * fscl_lava_combine_states would produce.
+ *
+ * @param hash     The hash to feed.
+ * @param lamps    Pointer to the array of lava lamps.
+ * @param numLamps The number of lava lamps.
+ */
+void fscl_lava_hash_lamps(clavahash* hash, const clavalamp* lamps, int numLamps);
+
+/**
+ * Feed a lamp field into a streaming hash, all positions then all velocities.
+ *
+ * @param hash  The hash to feed.
+ * @param field The field to hash.
+ */
+void fscl_lava_hash_field(clavahash* hash, const clavafield* field);
+
+/**
+ * Finish a streaming hash. The hash itself is left untouched so more
+ * bytes can be fed afterwards.
+ *
+ * @param hash The hash to finish.
+ * @param out  Receives the digest, FSCL_LAVA_HASH_SIZE bytes are enough.
+ * @return     The length of the digest: 8 for a fast hash, 32 for a strong one.
+ */
+size_t fscl_lava_hash_final(const clavahash* hash, unsigned char* out);
+
+/**
+ * Hash the state of multiple lava lamps with the fast hash.
+ *
+ * @param lamps    Pointer to the array of lava lamps.
+ * @param numLamps The number of lava lamps.
+ * @return         The 64-bit hash of the lamps.
+ */
+uint64_t fscl_lava_hash_state(const clavalamp* lamps, int numLamps);
+
+/**
+ * Derive a generator seed from the state of multiple lava lamps with
+ * the strong hash.
+ *
+ * @param lamps    Pointer to the array of lava lamps.
+ * @param numLamps The number of lava lamps.
+ * @return         A seed for fscl_lavarng_seed or fscl_lava_field_simulate.
+ */
+uint64_t fscl_lava_derive_seed(const clavalamp* lamps, int numLamps);
+
 #ifdef __cplusplus
 }
 #endif
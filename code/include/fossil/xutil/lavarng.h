@@ -0,0 +1,246 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_LAVARNG_H
+#define FSCL_LAVARNG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Random number engines
+typedef enum {
+    LAVARNG_XOSHIRO256, // xoshiro256**, fastest general purpose engine
+    LAVARNG_PCG64,      // PCG XSL-RR 128/64, 128-bit state, cheap arbitrary advance
+    LAVARNG_PHILOX      // Philox4x32-10, counter based, any position computed directly
+} clavarng_engine;
+
+// State of a random number generator. Each generator is independent, so
+// threads that own their generators never share anything.
+typedef struct {
+    clavarng_engine engine;
+    union {
+        uint64_t xoshiro[4];
+        struct {
+            uint64_t state_lo, state_hi;
+            uint64_t inc_lo, inc_hi;
+        } pcg;
+        struct {
+            uint64_t counter_lo, counter_hi;
+            uint64_t key;
+            uint64_t buffer[2]; // outputs of the current block not handed out yet
+            int available;
+        } philox;
+    } s;
+} clavarng;
+
+// Number of independent streams advanced together by a lane generator
+#define LAVARNG_LANES 8
+
+// Lane generator for bulk sampling: LAVARNG_LANES xoshiro256** streams
+// stored column-wise so one step of every lane is a handful of AVX2 or
+// AVX-512 instructions. Outputs are interleaved lane by lane and do not
+// depend on the instruction set used.
+typedef struct {
+    uint64_t s[4][LAVARNG_LANES]; // state word r of lane k is s[r][k]
+    uint64_t buffer[LAVARNG_LANES];
+    int available; // outputs at the end of buffer not handed out yet
+} clavarng_lanes;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Seed a generator. The seed is spread over the whole state with
+ * SplitMix64, so nearby seeds give unrelated sequences.
+ *
+ * @param rng    The generator to seed.
+ * @param engine The engine to use.
+ * @param seed   The seed value.
+ */
+void fscl_lavarng_seed(clavarng* rng, clavarng_engine engine, uint64_t seed);
+
+/**
+ * Generate the next 64 random bits.
+ *
+ * @param rng The generator.
+ * @return    The random value.
+ */
+uint64_t fscl_lavarng_next(clavarng* rng);
+
+/**
+ * Generate a double uniformly distributed in [0, 1), with 53 random bits.
+ *
+ * @param rng The generator.
+ * @return    The random value.
+ */
+double fscl_lavarng_double(clavarng* rng);
+
+/**
+ * Fill a buffer with random 64-bit values, the same values repeated
+ * calls to fscl_lavarng_next would give.
+ *
+ * @param rng   The generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ */
+void fscl_lavarng_fill_u64(clavarng* rng, uint64_t* out, size_t count);
+
+/**
+ * Fill a buffer with doubles uniformly distributed in [0, 1).
+ *
+ * @param rng   The generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ */
+void fscl_lavarng_fill_double(clavarng* rng, double* out, size_t count);
+
+/**
+ * Jump far ahead in the sequence: 2^128 outputs for xoshiro256**, 2^64
+ * for PCG64 and 2^65 for Philox. Copying a generator and jumping the
+ * copy gives a stream that never overlaps the original in practice.
+ *
+ * @param rng The generator.
+ */
+void fscl_lavarng_jump(clavarng* rng);
+
+/**
+ * Skip outputs as if fscl_lavarng_next had been called delta times, in
+ * logarithmic time for PCG64 and constant time for Philox.
+ *
+ * @param rng   The generator.
+ * @param delta The number of outputs to skip.
+ * @return      0 on success, -1 with errno set to ENOTSUP for xoshiro256**.
+ */
+int fscl_lavarng_advance(clavarng* rng, uint64_t delta);
+
+/**
+ * Compute one Philox4x32-10 block directly from a key and a counter,
+ * without any generator state.
+ *
+ * @param key        The key, two 32-bit words.
+ * @param counter_lo The low half of the 128-bit counter.
+ * @param counter_hi The high half of the 128-bit counter.
+ * @param out        Receives the two 64-bit outputs of the block.
+ */
+void fscl_lavarng_philox_block(uint64_t key, uint64_t counter_lo, uint64_t counter_hi, uint64_t out[2]);
+
+/**
+ * Generate an integer uniformly distributed in [0, range), without bias
+ * (Lemire's multiply and reject method).
+ *
+ * @param rng   The generator.
+ * @param range The number of possible values, 0 for the full 64 bits.
+ * @return      The random value.
+ */
+uint64_t fscl_lavarng_bounded(clavarng* rng, uint64_t range);
+
+/**
+ * Generate a standard normal variate (ziggurat method).
+ *
+ * @param rng The generator.
+ * @return    The random value.
+ */
+double fscl_lavarng_normal(clavarng* rng);
+
+/**
+ * Generate a standard exponential variate (ziggurat method).
+ *
+ * @param rng The generator.
+ * @return    The random value.
+ */
+double fscl_lavarng_exponential(clavarng* rng);
+
+/**
+ * Seed a lane generator. Lane k follows the xoshiro256** stream of
+ * fscl_lavarng_seed with the same seed, jumped k times.
+ *
+ * @param lanes The lane generator to seed.
+ * @param seed  The seed value.
+ */
+void fscl_lavarng_lanes_seed(clavarng_lanes* lanes, uint64_t seed);
+
+/**
+ * Fill a buffer with random 64-bit values from all lanes.
+ *
+ * @param lanes The lane generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ */
+void fscl_lavarng_lanes_fill_u64(clavarng_lanes* lanes, uint64_t* out, size_t count);
+
+/**
+ * Fill a buffer with doubles uniformly distributed in [0, 1).
+ *
+ * @param lanes The lane generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ */
+void fscl_lavarng_lanes_fill_double(clavarng_lanes* lanes, double* out, size_t count);
+
+/**
+ * Fill a buffer with integers uniformly distributed in [0, range).
+ *
+ * @param lanes The lane generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ * @param range The number of possible values, 0 for the full 64 bits.
+ */
+void fscl_lavarng_lanes_fill_bounded(clavarng_lanes* lanes, uint64_t* out, size_t count, uint64_t range);
+
+/**
+ * Fill a buffer with normal variates.
+ *
+ * @param lanes  The lane generator.
+ * @param out    The buffer to fill.
+ * @param count  The number of values.
+ * @param mean   The mean of the distribution.
+ * @param stddev The standard deviation of the distribution.
+ */
+void fscl_lavarng_lanes_fill_normal(clavarng_lanes* lanes, double* out, size_t count, double mean, double stddev);
+
+/**
+ * Fill a buffer with exponential variates.
+ *
+ * @param lanes The lane generator.
+ * @param out   The buffer to fill.
+ * @param count The number of values.
+ * @param rate  The rate of the distribution, the mean is 1 / rate.
+ */
+void fscl_lavarng_lanes_fill_exponential(clavarng_lanes* lanes, double* out, size_t count, double rate);
+
+/**
+ * Name the instruction set the lane generator runs on: "avx512", "avx2"
+ * or "scalar", chosen once from what the processor supports.
+ *
+ * @return The name of the instruction set.
+ */
+const char* fscl_lavarng_lanes_isa(void);
+
+/**
+ * Get the generator of the calling thread, a xoshiro256** engine seeded
+ * on first use with a stream of its own. Used by the lavalamp functions.
+ *
+ * @return The generator of the calling thread.
+ */
+clavarng* fscl_lavarng_thread(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_STATCACHE_H
+#define FSCL_STATCACHE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+// Kind of filesystem entry a cached path refers to
+typedef enum {
+    STATCACHE_MISSING,
+    STATCACHE_FILE,
+    STATCACHE_DIRECTORY,
+    STATCACHE_OTHER
+} cstatcache_type;
+
+// Cached metadata of a path
+typedef struct {
+    cstatcache_type type;
+    unsigned long long size;
+    long long mtime_sec;
+    long mtime_nsec;
+} cstatcache_info;
+
+// Running totals of a cache
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long invalidations;
+} cstatcache_counters;
+
+// Opaque metadata cache
+typedef struct cstatcache cstatcache;
+
+// =================================================================
+// Avalable functions
+// =================================================================
+
+/**
+ * Create a metadata cache keyed by path. With watching enabled, inotify
+ * invalidates entries as soon as the kernel reports a change to them or
+ * to their parent directory; the time to live bounds staleness where no
+ * notifications exist (other platforms, network filesystems). Only a
+ * path and its parent are watched, so renaming or removing a higher
+ * ancestor is not seen; give a nonzero time to live when that can happen.
+ * Watches are removed once no cached entry needs them any more.
+ *
+ * @param capacity Maximum number of cached paths, 0 for a default.
+ * @param ttl      Seconds an entry stays valid, 0 to keep it until invalidated.
+ * @param watch    1 to invalidate through filesystem notifications.
+ * @return         The new cache, or NULL on failure.
+ */
+cstatcache* fscl_statcache_create(size_t capacity, double ttl, int watch);
+
+/**
+ * Look up the metadata of a path, calling stat only on a miss. Missing
+ * paths are cached as well.
+ *
+ * @param cache The cache to query.
+ * @param path  The path to look up.
+ * @param info  Receives the metadata, may be NULL.
+ * @return      0 if the path exists, -1 if it does not.
+ */
+int fscl_statcache_lookup(cstatcache* cache, const char* path, cstatcache_info* info);
+
+/**
+ * Check if a path exists.
+ *
+ * @param cache The cache to query.
+ * @param path  The path to check.
+ * @return      1 if it exists, 0 otherwise.
+ */
+int fscl_statcache_exists(cstatcache* cache, const char* path);
+
+/**
+ * Check if a path is a directory.
+ *
+ * @param cache The cache to query.
+ * @param path  The path to check.
+ * @return      1 if it is a directory, 0 otherwise.
+ */
+int fscl_statcache_is_directory(cstatcache* cache, const char* path);
+
+/**
+ * Drop the cached metadata of a path.
+ *
+ * @param cache The cache to update.
+ * @param path  The path to forget.
+ */
+void fscl_statcache_invalidate(cstatcache* cache, const char* path);
+
+/**
+ * Drop every cached path.
+ *
+ * @param cache The cache to clear.
+ */
+void fscl_statcache_clear(cstatcache* cache);
+
+/**
+ * Read the hit, miss and invalidation counters of a cache.
+ *
+ * @param cache The cache to inspect.
+ * @return      The counters.
+ */
+cstatcache_counters fscl_statcache_counters(cstatcache* cache);
+
+/**
+ * Route fscl_filesys_exists and fscl_command_erase_exists through a cache.
+ *
+ * @param cache The cache to use, NULL to go back to plain stat calls.
+ */
+void fscl_statcache_install(cstatcache* cache);
+
+/**
+ * Get the cache installed with fscl_statcache_install.
+ *
+ * @return The installed cache, or NULL.
+ */
+cstatcache* fscl_statcache_installed(void);
+
+/**
+ * Erase a cache, stopping its watcher. Uninstalls it if installed.
+ *
+ * @param cache The cache to erase.
+ */
+void fscl_statcache_erase(cstatcache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
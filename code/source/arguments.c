@@ -11,37 +11,592 @@ Description:
 ==============================================================================
 */
 #include "fossil/xutil/arguments.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Function to display usage information
-void fscl_arg_parse_usage(const char* program_name, coption* options, int num_options) {
-    printf("Usage: %s [options]\n\nOptions:\n", program_name);
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// Option count above which parse and check build a temporary index
+#define ARG_INDEX_THRESHOLD 16
+
+// Hash of an option name (FNV-1a)
+static unsigned int arg_hash(const char* name, size_t length) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Find an option by name, through the index when there is one
+static int arg_lookup_n(const coption* options, int num_options, const coption_index* index, const char* name, size_t length) {
+    if (index) {
+        return fscl_arg_index_find(index, name, length);
+    }
+    for (int j = 0; j < num_options; ++j) {
+        if (strncmp(name, options[j].name, length) == 0 && options[j].name[length] == '\0') {
+            return j;
+        }
+    }
+    return -1;
+}
+
+static int arg_lookup(const coption* options, int num_options, const coption_index* index, const char* name) {
+    return arg_lookup_n(options, num_options, index, name, strlen(name));
+}
+
+// Result of the value parsers when the value was accepted
+#define ARG_VALUE_OK (-1)
+
+// Parse the digits of a decimal or 0x hex number up to limit, without locale lookups
+static int arg_parse_digits(const char** text, unsigned long long limit, unsigned long long* out) {
+    const char* cursor = *text;
+    unsigned base = 10;
+    if (cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X')) {
+        base = 16;
+        cursor += 2;
+    }
+    unsigned long long value = 0;
+    int digits = 0;
+    int overflow = 0;
+    for (;; ++cursor) {
+        unsigned digit;
+        if (*cursor >= '0' && *cursor <= '9') {
+            digit = (unsigned)(*cursor - '0');
+        } else if (base == 16 && *cursor >= 'a' && *cursor <= 'f') {
+            digit = (unsigned)(*cursor - 'a' + 10);
+        } else if (base == 16 && *cursor >= 'A' && *cursor <= 'F') {
+            digit = (unsigned)(*cursor - 'A' + 10);
+        } else {
+            break;
+        }
+        if (value > (limit - digit) / base) {
+            overflow = 1;
+        } else {
+            value = value * base + digit;
+        }
+        ++digits;
+    }
+    *text = cursor;
+    if (digits == 0) {
+        return CARG_ERROR_INVALID_VALUE;
+    }
+    *out = value;
+    return overflow ? CARG_ERROR_OUT_OF_RANGE : ARG_VALUE_OK;
+}
+
+static int arg_parse_integer(const char* text, long long min, long long max, long long* out) {
+    int negative = 0;
+    if (*text == '+' || *text == '-') {
+        negative = *text++ == '-';
+    }
+    // The magnitude limit for the sign given, checked against both bounds below
+    unsigned long long limit;
+    if (negative) {
+        limit = min < 0 ? (unsigned long long)(-(min + 1)) + 1 : 0;
+    } else {
+        limit = max < 0 ? 0 : (unsigned long long)max;
+    }
+    unsigned long long value = 0;
+    int status = arg_parse_digits(&text, limit, &value);
+    if (status == ARG_VALUE_OK && *text != '\0') {
+        status = CARG_ERROR_INVALID_VALUE;
+    }
+    if (status != ARG_VALUE_OK) {
+        return status;
+    }
+    long long result = !negative ? (long long)value : value == 0 ? 0 : -(long long)(value - 1) - 1;
+    if (result < min || result > max) {
+        return CARG_ERROR_OUT_OF_RANGE;
+    }
+    *out = result;
+    return ARG_VALUE_OK;
+}
+
+static int arg_parse_size(const char* text, size_t* out) {
+    unsigned long long value = 0;
+    int status = arg_parse_digits(&text, (unsigned long long)(size_t)-1, &value);
+    if (status != ARG_VALUE_OK) {
+        return status;
+    }
+    static const char units[] = "kmgtp";
+    unsigned shift = 0;
+    const char* unit = *text ? strchr(units, *text | 0x20) : NULL;
+    if (unit) {
+        shift = 10 * (unsigned)(unit - units + 1);
+        ++text;
+        if (*text == 'i') {
+            ++text;
+        }
+    }
+    if (*text == 'B' || *text == 'b') {
+        ++text;
+    }
+    if (*text != '\0') {
+        return CARG_ERROR_INVALID_VALUE;
+    }
+    if (value > ((unsigned long long)(size_t)-1 >> shift)) {
+        return CARG_ERROR_OUT_OF_RANGE;
+    }
+    *out = (size_t)(value << shift);
+    return ARG_VALUE_OK;
+}
+
+static int arg_parse_bool(const char* text, int* out) {
+    static const char* const truths[] = {"1", "true", "yes", "on"};
+    static const char* const lies[] = {"0", "false", "no", "off"};
+    for (int i = 0; i < 4; ++i) {
+        if (strcmp(text, truths[i]) == 0) {
+            *out = 1;
+            return ARG_VALUE_OK;
+        }
+        if (strcmp(text, lies[i]) == 0) {
+            *out = 0;
+            return ARG_VALUE_OK;
+        }
+    }
+    return CARG_ERROR_INVALID_VALUE;
+}
+
+// Parse a value for an option into out, which is untouched when the value is rejected
+static int arg_apply_value(const coption* option, coption_value* out, const char* value) {
+    long long number;
+    int status = ARG_VALUE_OK;
+    switch (option->type) {
+        case COPTION_TYPE_INT:
+            status = arg_parse_integer(value, INT_MIN, INT_MAX, &number);
+            if (status == ARG_VALUE_OK) {
+                out->int_val = (int)number;
+            }
+            break;
+        case COPTION_TYPE_INT64:
+            status = arg_parse_integer(value, LLONG_MIN, LLONG_MAX, &number);
+            if (status == ARG_VALUE_OK) {
+                out->int64_val = number;
+            }
+            break;
+        case COPTION_TYPE_SIZE:
+            status = arg_parse_size(value, &out->size_val);
+            break;
+        case COPTION_TYPE_DOUBLE: {
+            char* end;
+            errno = 0;
+            double parsed = strtod(value, &end);
+            if (end == value || *end != '\0') {
+                status = CARG_ERROR_INVALID_VALUE;
+            } else if (errno == ERANGE && (parsed > 1.0 || parsed < -1.0)) {
+                status = CARG_ERROR_OUT_OF_RANGE;
+            } else {
+                out->double_val = parsed;
+            }
+            break;
+        }
+        case COPTION_TYPE_STRING:
+            out->str_val = (char*)value;
+            break;
+        case COPTION_TYPE_BOOL:
+            status = arg_parse_bool(value, &out->bool_val);
+            break;
+        case COPTION_TYPE_COMBO:
+            status = CARG_ERROR_INVALID_VALUE;
+            for (int k = 0; k < option->num_choices; ++k) {
+                if (strcmp(value, ((combo_choice*)option->extra_data)[k].name) == 0) {
+                    out->combo_val = ((combo_choice*)option->extra_data)[k].value;
+                    status = ARG_VALUE_OK;
+                    break;
+                }
+            }
+            break;
+        case COPTION_TYPE_FEATURE:
+            if (strcmp(value, "enable") == 0) {
+                out->feature_val = FEATURE_ENABLE;
+            } else if (strcmp(value, "disable") == 0) {
+                out->feature_val = FEATURE_DISABLE;
+            } else if (strcmp(value, "auto") == 0) {
+                out->feature_val = FEATURE_AUTO;
+            } else {
+                status = CARG_ERROR_INVALID_VALUE;
+            }
+            break;
+    }
+    return status;
+}
+
+// Build a temporary index for large option arrays, NULL when not worth it
+static const coption_index* arg_temporary_index(coption_index* storage, const coption* options, int num_options) {
+    if (num_options <= ARG_INDEX_THRESHOLD || fscl_arg_index_build(storage, options, num_options) != 0) {
+        return NULL;
+    }
+    return storage;
+}
+
+// Make room for count more bytes plus a terminator
+static int arg_render_reserve(carg_render* render, size_t count) {
+    if (render->failed) {
+        return -1;
+    }
+    if (render->length + count + 1 <= render->capacity) {
+        return 0;
+    }
+    size_t capacity = render->capacity ? render->capacity : 4096;
+    while (capacity < render->length + count + 1) {
+        capacity *= 2;
+    }
+    char* grown = realloc(render->data, capacity);
+    if (!grown) {
+        render->failed = 1;
+        return -1;
+    }
+    render->data = grown;
+    render->capacity = capacity;
+    return 0;
+}
+
+static void arg_render_append(carg_render* render, const char* text, size_t length) {
+    if (arg_render_reserve(render, length) == 0) {
+        memcpy(render->data + render->length, text, length);
+        render->length += length;
+        render->data[render->length] = '\0';
+    }
+}
+
+static void arg_render_text(carg_render* render, const char* text) {
+    arg_render_append(render, text, strlen(text));
+}
+
+static void arg_render_fill(carg_render* render, char c, size_t count) {
+    if (arg_render_reserve(render, count) == 0) {
+        memset(render->data + render->length, c, count);
+        render->length += count;
+        render->data[render->length] = '\0';
+    }
+}
+
+static void arg_render_format(carg_render* render, const char* format, ...) {
+    char small[64];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (length < 0) {
+        return;
+    }
+    if ((size_t)length < sizeof(small)) {
+        arg_render_append(render, small, (size_t)length);
+        return;
+    }
+    if (arg_render_reserve(render, (size_t)length) == 0) {
+        va_start(args, format);
+        vsnprintf(render->data + render->length, (size_t)length + 1, format, args);
+        va_end(args);
+        render->length += (size_t)length;
+    }
+}
+
+// Name and value hint of an option, the left column of the usage text
+static void arg_render_hint(carg_render* render, const coption* option) {
+    arg_render_text(render, "  -");
+    arg_render_text(render, option->name);
+    switch (option->type) {
+        case COPTION_TYPE_INT:
+            arg_render_text(render, " <int>");
+            break;
+        case COPTION_TYPE_STRING:
+            arg_render_text(render, " <string>");
+            break;
+        case COPTION_TYPE_BOOL:
+            arg_render_text(render, " (flag)");
+            break;
+        case COPTION_TYPE_COMBO: {
+            const combo_choice* choices = (const combo_choice*)option->extra_data;
+            for (int j = 0; j < option->num_choices; ++j) {
+                arg_render_text(render, j == 0 ? " {" : "|");
+                arg_render_text(render, choices[j].name);
+            }
+            arg_render_text(render, option->num_choices > 0 ? "}" : " {}");
+            break;
+        }
+        case COPTION_TYPE_FEATURE:
+            arg_render_text(render, " {enable|disable|auto}");
+            break;
+        case COPTION_TYPE_INT64:
+            arg_render_text(render, " <int64>");
+            break;
+        case COPTION_TYPE_DOUBLE:
+            arg_render_text(render, " <number>");
+            break;
+        case COPTION_TYPE_SIZE:
+            arg_render_text(render, " <size>");
+            break;
+    }
+}
+
+// Append help text wrapped to width, continuation lines indented by column
+static void arg_render_wrapped(carg_render* render, const char* text, size_t column, size_t width) {
+    size_t room = width > column + 20 ? width - column : 20;
+    size_t used = 0;
+    while (*text) {
+        while (*text == ' ') {
+            ++text;
+        }
+        size_t word = strcspn(text, " ");
+        if (word == 0) {
+            break;
+        }
+        if (used > 0 && used + 1 + word > room) {
+            arg_render_text(render, "\n");
+            arg_render_fill(render, ' ', column);
+            used = 0;
+        } else if (used > 0) {
+            arg_render_text(render, " ");
+            ++used;
+        }
+        arg_render_append(render, text, word);
+        used += word;
+        text += word;
+    }
+}
+
+// Function to get the width of a terminal
+int fscl_arg_terminal_width(int fd) {
+#if !defined(_WIN32) && defined(TIOCGWINSZ)
+    struct winsize size;
+    if (ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) {
+        return size.ws_col;
+    }
+#else
+    (void)fd;
+#endif
+    const char* columns = getenv("COLUMNS");
+    long long width;
+    if (columns && arg_parse_integer(columns, 1, INT_MAX, &width) == ARG_VALUE_OK) {
+        return (int)width;
+    }
+    return 80;
+}
+
+// Function to render the usage text
+int fscl_arg_render_usage(carg_render* render, const char* program_name, const coption* options, int num_options,
+                          int width) {
+    if (width <= 0) {
+        width = fscl_arg_terminal_width(1);
+    }
+    // Measure the left column by rendering it and rolling back
+    size_t start = render->length;
+    size_t column = 0;
+    for (int i = 0; i < num_options; ++i) {
+        arg_render_hint(render, &options[i]);
+        if (render->length - start > column) {
+            column = render->length - start;
+        }
+        render->length = start;
+    }
+    column += 2;
+    size_t limit = (size_t)width / 2;
+    if (column > limit) {
+        column = limit; // longer entries put their help on the next line
+    }
+
+    arg_render_format(render, "Usage: %s [options]\n\nOptions:\n", program_name);
     for (int i = 0; i < num_options; ++i) {
-        printf("  -%s", options[i].name);
-        switch (options[i].type) {
-            case COPTION_TYPE_INT:
-                printf(" <int>");
+        size_t line = render->length;
+        arg_render_hint(render, &options[i]);
+        if (options[i].help && options[i].help[0]) {
+            size_t length = render->length - line;
+            if (length + 2 > column) {
+                arg_render_text(render, "\n");
+                length = 0;
+            }
+            arg_render_fill(render, ' ', column - length);
+            arg_render_wrapped(render, options[i].help, column, (size_t)width);
+        }
+        arg_render_text(render, "\n");
+    }
+    return render->failed ? -1 : 0;
+}
+
+static const char* arg_type_name(coption_type type) {
+    static const char* const names[] = {"int", "string", "bool", "combo", "feature", "int64", "double", "size"};
+    return (unsigned)type < sizeof(names) / sizeof(names[0]) ? names[type] : "unknown";
+}
+
+static const char* arg_source_name(carg_source source) {
+    static const char* const names[] = {"default", "config", "environment", "command line"};
+    return (unsigned)source < sizeof(names) / sizeof(names[0]) ? names[source] : "unknown";
+}
+
+// Append a string as a JSON string literal
+static void arg_render_json_string(carg_render* render, const char* text) {
+    arg_render_text(render, "\"");
+    for (const char* run = text;;) {
+        size_t plain = strcspn(run, "\"\\\b\f\n\r\t\x01\x02\x03\x04\x05\x06\x07\x0b\x0e\x0f"
+                                   "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f");
+        arg_render_append(render, run, plain);
+        run += plain;
+        if (*run == '\0') {
+            break;
+        }
+        switch (*run) {
+            case '"':
+                arg_render_text(render, "\\\"");
                 break;
-            case COPTION_TYPE_STRING:
-                printf(" <string>");
+            case '\\':
+                arg_render_text(render, "\\\\");
                 break;
-            case COPTION_TYPE_BOOL:
-                printf(" (flag)");
+            case '\n':
+                arg_render_text(render, "\\n");
                 break;
-            case COPTION_TYPE_COMBO:
-                printf(" {%s}", ((combo_choice*)options[i].extra_data)[0].name);
-                for (int j = 1; j < options[i].num_choices; ++j) {
-                    printf("|%s", ((combo_choice*)options[i].extra_data)[j].name);
-                }
+            case '\r':
+                arg_render_text(render, "\\r");
+                break;
+            case '\t':
+                arg_render_text(render, "\\t");
                 break;
-            case COPTION_TYPE_FEATURE:
-                printf(" {enable|disable|auto}");
+            default:
+                arg_render_format(render, "\\u%04x", (unsigned char)*run);
                 break;
         }
-        printf("\n");
+        ++run;
+    }
+    arg_render_text(render, "\"");
+}
+
+// Append the value of an option, strings and names quoted for JSON
+static void arg_render_value(carg_render* render, const coption* option, int json) {
+    static const char* const features[] = {"enable", "disable", "auto"};
+    const char* name = NULL;
+    switch (option->type) {
+        case COPTION_TYPE_INT:
+            arg_render_format(render, "%d", option->value.int_val);
+            return;
+        case COPTION_TYPE_INT64:
+            arg_render_format(render, "%lld", option->value.int64_val);
+            return;
+        case COPTION_TYPE_SIZE:
+            arg_render_format(render, "%zu", option->value.size_val);
+            return;
+        case COPTION_TYPE_DOUBLE: {
+            double value = option->value.double_val;
+            if (json && value - value != 0) {
+                arg_render_text(render, "null"); // infinity or NaN
+            } else {
+                arg_render_format(render, "%.17g", value);
+            }
+            return;
+        }
+        case COPTION_TYPE_BOOL:
+            arg_render_text(render, option->value.bool_val ? "true" : "false");
+            return;
+        case COPTION_TYPE_STRING:
+            name = option->value.str_val;
+            break;
+        case COPTION_TYPE_COMBO: {
+            const combo_choice* choices = (const combo_choice*)option->extra_data;
+            for (int j = 0; j < option->num_choices; ++j) {
+                if (choices[j].value == option->value.combo_val) {
+                    name = choices[j].name;
+                    break;
+                }
+            }
+            if (!name) {
+                arg_render_format(render, "%d", option->value.combo_val);
+                return;
+            }
+            break;
+        }
+        case COPTION_TYPE_FEATURE:
+            if ((unsigned)option->value.feature_val < 3) {
+                name = features[option->value.feature_val];
+            }
+            break;
+    }
+    if (!name) {
+        arg_render_text(render, json ? "null" : "(none)");
+    } else if (json) {
+        arg_render_json_string(render, name);
+    } else {
+        arg_render_text(render, name);
+    }
+}
+
+// Function to render the options with their values
+int fscl_arg_render_options(carg_render* render, const coption* options, int num_options, carg_render_format format) {
+    if (format == CARG_RENDER_JSON) {
+        arg_render_text(render, "{");
+        for (int i = 0; i < num_options; ++i) {
+            arg_render_text(render, i == 0 ? "\n  " : ",\n  ");
+            arg_render_json_string(render, options[i].name);
+            arg_render_format(render, ": {\"type\": \"%s\", \"value\": ", arg_type_name(options[i].type));
+            arg_render_value(render, &options[i], 1);
+            arg_render_format(render, ", \"parsed\": %s, \"source\": \"%s\"}", options[i].parsed ? "true" : "false",
+                              arg_source_name(options[i].source));
+        }
+        arg_render_text(render, num_options > 0 ? "\n}\n" : "}\n");
+    } else {
+        for (int i = 0; i < num_options; ++i) {
+            arg_render_format(render, "Option: %s, Parsed: %s, Value: ", options[i].name,
+                              options[i].parsed ? "true" : "false");
+            arg_render_value(render, &options[i], 0);
+            arg_render_format(render, ", Source: %s\n", arg_source_name(options[i].source));
+        }
+    }
+    return render->failed ? -1 : 0;
+}
+
+// Function to write a rendered buffer to a descriptor
+int fscl_arg_render_flush(carg_render* render, int fd) {
+    size_t done = 0;
+    while (done < render->length) {
+        size_t count = render->length - done;
+        long n = (long)write(fd, render->data + done, (unsigned)(count < ((size_t)1 << 30) ? count : (size_t)1 << 30));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    render->length = 0;
+    if (render->failed) {
+        render->failed = 0;
+        errno = ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+// Function to release a render buffer
+void fscl_arg_render_erase(carg_render* render) {
+    if (render) {
+        free(render->data);
+        render->data = NULL;
+        render->length = 0;
+        render->capacity = 0;
+        render->failed = 0;
+    }
+}
+
+// Function to display usage information
+void fscl_arg_parse_usage(const char* program_name, coption* options, int num_options) {
+    carg_render render = {0};
+    fscl_arg_render_usage(&render, program_name, options, num_options, 0);
+    if (render.length > 0) {
+        fwrite(render.data, 1, render.length, stdout);
     }
+    fscl_arg_render_erase(&render);
 }
 
 // Function to check if an option has been parsed
@@ -54,80 +609,115 @@ int fscl_arg_parse_has(coption* options, int num_options, const char* option_nam
     return 0; // Option not found or not parsed
 }
 
-// Function to parse command line arguments
-void fscl_arg_parse(ccommandline* cmd, coption* options, int num_options) {
-    for (int i = 1; i < cmd->argc; ++i) {
-        const char* arg = cmd->argv[i];
+// Walks the arguments of a ccommandline, skipping the program name
+typedef struct {
+    ccommandline* cmd;
+    int position;
+} arg_vector;
+
+static const char* arg_vector_next(void* source) {
+    arg_vector* vector = (arg_vector*)source;
+    return vector->position < vector->cmd->argc ? vector->cmd->argv[vector->position++] : NULL;
+}
+
+// Parse tokens into the options, shared by every parse entry point. An
+// option missing its value at the end of the input is left untouched.
+static void arg_parse_options(carg_next_token next, void* source, coption* options, int num_options,
+                              const coption_index* index) {
+    const char* arg;
+    while ((arg = next(source)) != NULL) {
         if (arg[0] == '-') {
             // Parse options
-            for (int j = 0; j < num_options; ++j) {
-                if (strcmp(arg + 1, options[j].name) == 0) {
-                    options[j].parsed = 1; // Mark the option as parsed
-                    switch (options[j].type) {
-                        case COPTION_TYPE_INT:
-                            options[j].value.int_val = atoi(cmd->argv[++i]);
-                            break;
-                        case COPTION_TYPE_STRING:
-                            options[j].value.str_val = cmd->argv[++i];
-                            break;
-                        case COPTION_TYPE_BOOL:
-                            options[j].value.bool_val = 1;
-                            break;
-                        case COPTION_TYPE_COMBO: {
-                            const char* choice_str = cmd->argv[++i];
-                            for (int k = 0; k < options[j].num_choices; ++k) {
-                                if (strcmp(choice_str, ((combo_choice*)options[j].extra_data)[k].name) == 0) {
-                                    options[j].value.combo_val = ((combo_choice*)options[j].extra_data)[k].value;
-                                    break;
-                                }
-                            }
+            int j = arg_lookup(options, num_options, index, arg + 1);
+            if (j < 0) {
+                continue;
+            }
+            if (options[j].type == COPTION_TYPE_BOOL) {
+                options[j].value.bool_val = 1;
+                options[j].parsed = 1; // Mark the option as parsed
+                options[j].source = CARG_SOURCE_COMMAND_LINE;
+                continue;
+            }
+            const char* value = next(source);
+            if (!value) {
+                break;
+            }
+            options[j].parsed = 1;
+            options[j].source = CARG_SOURCE_COMMAND_LINE;
+            switch (options[j].type) {
+                case COPTION_TYPE_INT:
+                    options[j].value.int_val = atoi(value);
+                    break;
+                case COPTION_TYPE_STRING:
+                    options[j].value.str_val = (char*)value;
+                    break;
+                case COPTION_TYPE_COMBO:
+                    for (int k = 0; k < options[j].num_choices; ++k) {
+                        if (strcmp(value, ((combo_choice*)options[j].extra_data)[k].name) == 0) {
+                            options[j].value.combo_val = ((combo_choice*)options[j].extra_data)[k].value;
                             break;
                         }
-                        case COPTION_TYPE_FEATURE:
-                            // Parse feature value
-                            ++i;
-                            if (strcmp(cmd->argv[i], "enable") == 0) {
-                                options[j].value.feature_val = FEATURE_ENABLE;
-                            } else if (strcmp(cmd->argv[i], "disable") == 0) {
-                                options[j].value.feature_val = FEATURE_DISABLE;
-                            } else if (strcmp(cmd->argv[i], "auto") == 0) {
-                                options[j].value.feature_val = FEATURE_AUTO;
-                            } else {
-                                fprintf(stderr, "Error: Invalid value for feature.\n");
-                                exit(EXIT_FAILURE);
-                            }
-                            break;
                     }
-                    break; // Found and parsed the option, move to the next argument
-                }
+                    break;
+                case COPTION_TYPE_FEATURE:
+                    // Parse feature value
+                    if (strcmp(value, "enable") == 0) {
+                        options[j].value.feature_val = FEATURE_ENABLE;
+                    } else if (strcmp(value, "disable") == 0) {
+                        options[j].value.feature_val = FEATURE_DISABLE;
+                    } else if (strcmp(value, "auto") == 0) {
+                        options[j].value.feature_val = FEATURE_AUTO;
+                    } else {
+                        fprintf(stderr, "Error: Invalid value for feature.\n");
+                        exit(EXIT_FAILURE);
+                    }
+                    break;
+                default:
+                    arg_apply_value(&options[j], &options[j].value, value);
+                    break;
             }
         }
     }
 }
 
-void fscl_arg_check_unrecognized(ccommandline* cmd, coption* options, int num_options) {
+// Function to parse command line arguments
+void fscl_arg_parse(ccommandline* cmd, coption* options, int num_options) {
+    coption_index storage;
+    const coption_index* index = arg_temporary_index(&storage, options, num_options);
+    arg_vector vector = {cmd, 1};
+    arg_parse_options(arg_vector_next, &vector, options, num_options, index);
+    if (index) {
+        fscl_arg_index_erase(&storage);
+    }
+}
+
+// Report the first argument naming no option and exit
+static void arg_check_options(ccommandline* cmd, const coption* options, int num_options, const coption_index* index) {
     for (int i = 1; i < cmd->argc; ++i) {
         const char* arg = cmd->argv[i];
-        if (arg[0] == '-') {
-            int recognized = 0;
-            for (int j = 0; j < num_options; ++j) {
-                if (strcmp(arg + 1, options[j].name) == 0) {
-                    recognized = 1;
-                    break;
-                }
-            }
-            if (!recognized) {
-                fprintf(stderr, "Error: Unrecognized option '%s'\n", arg);
-                exit(EXIT_FAILURE);
-            }
+        if (arg[0] == '-' && arg_lookup(options, num_options, index, arg + 1) < 0) {
+            fprintf(stderr, "Error: Unrecognized option '%s'\n", arg);
+            exit(EXIT_FAILURE);
         }
     }
 }
 
+void fscl_arg_check_unrecognized(ccommandline* cmd, coption* options, int num_options) {
+    coption_index storage;
+    const coption_index* index = arg_temporary_index(&storage, options, num_options);
+    arg_check_options(cmd, options, num_options, index);
+    if (index) {
+        fscl_arg_index_erase(&storage);
+    }
+}
+
 void fscl_arg_print_parsed_options(coption* options, int num_options) {
-    for (int i = 0; i < num_options; ++i) {
-        printf("Option: %s, Parsed: %s\n", options[i].name, options[i].parsed ? "true" : "false");
+    carg_render render = {0};
+    fscl_arg_render_options(&render, options, num_options, CARG_RENDER_TEXT);
+    if (render.length > 0) {
+        fwrite(render.data, 1, render.length, stdout);
     }
+    fscl_arg_render_erase(&render);
 }
 
 void fscl_arg_reset_parsed_flags(coption* options, int num_options) {
@@ -167,7 +757,910 @@ coption* fscl_arg_create_options(const char* names[], coption_type types[], copt
         options[i].extra_data = extra_data[i];
         options[i].parsed = 0;
         options[i].num_choices = 0;
+        options[i].help = NULL;
+        options[i].source = CARG_SOURCE_DEFAULT;
     }
 
     return options;
 }
+
+// Name of entry i of an array whose elements start with their name
+#define ARG_ENTRY_NAME(items, stride, i) (*(const char* const*)((const char*)(items) + (size_t)(i) * (stride)))
+
+// Fill a hash table over the names of an array, shared by option indexes
+// and subcommand registries
+static void arg_slots_fill(coption_slot* slots, int capacity, const void* items, size_t stride, int count) {
+    for (int i = 0; i < capacity; ++i) {
+        slots[i].hash = 0;
+        slots[i].option = -1;
+    }
+    for (int j = 0; j < count; ++j) {
+        const char* name = ARG_ENTRY_NAME(items, stride, j);
+        unsigned int hash = arg_hash(name, strlen(name));
+        unsigned int slot = hash % (unsigned int)capacity;
+        while (slots[slot].option >= 0) {
+            // Keep the first of duplicate names, like the linear scan did
+            if (slots[slot].hash == hash && strcmp(ARG_ENTRY_NAME(items, stride, slots[slot].option), name) == 0) {
+                break;
+            }
+            slot = (slot + 1) % (unsigned int)capacity;
+        }
+        if (slots[slot].option < 0) {
+            slots[slot].hash = hash;
+            slots[slot].option = j;
+        }
+    }
+}
+
+static int arg_slots_find(const coption_slot* slots, int capacity, const void* items, size_t stride,
+                          const char* name, size_t length) {
+    if (!slots || capacity <= 0) {
+        return -1;
+    }
+    unsigned int hash = arg_hash(name, length);
+    unsigned int slot = hash % (unsigned int)capacity;
+    while (slots[slot].option >= 0) {
+        if (slots[slot].hash == hash) {
+            const char* candidate = ARG_ENTRY_NAME(items, stride, slots[slot].option);
+            if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0') {
+                return slots[slot].option;
+            }
+        }
+        slot = (slot + 1) % (unsigned int)capacity;
+    }
+    return -1;
+}
+
+// Function to build an option index into caller storage
+void fscl_arg_index_init(coption_index* index, const coption* options, int num_options, coption_slot* slots, int capacity) {
+    index->options = options;
+    index->num_options = num_options;
+    index->slots = slots;
+    index->capacity = capacity;
+    index->owned = 0;
+    arg_slots_fill(slots, capacity, options, sizeof(coption), num_options);
+}
+
+// Function to build an option index
+int fscl_arg_index_build(coption_index* index, const coption* options, int num_options) {
+    // Load factor of at most one half keeps probe chains short
+    int capacity = num_options * 2 + 1;
+    coption_slot* slots = malloc((size_t)capacity * sizeof(coption_slot));
+    if (!slots) {
+        index->slots = NULL;
+        index->capacity = 0;
+        index->owned = 0;
+        return -1;
+    }
+    fscl_arg_index_init(index, options, num_options, slots, capacity);
+    index->owned = 1;
+    return 0;
+}
+
+// Function to look up an option by name
+int fscl_arg_index_find(const coption_index* index, const char* name, size_t length) {
+    if (!index) {
+        return -1;
+    }
+    return arg_slots_find(index->slots, index->capacity, index->options, sizeof(coption), name, length);
+}
+
+// Function to release an option index
+void fscl_arg_index_erase(coption_index* index) {
+    if (index && index->owned) {
+        free(index->slots);
+    }
+    if (index) {
+        index->slots = NULL;
+        index->capacity = 0;
+        index->owned = 0;
+    }
+}
+
+// Function to parse command line arguments with a prebuilt index
+void fscl_arg_parse_indexed(ccommandline* cmd, coption* options, const coption_index* index) {
+    arg_vector vector = {cmd, 1};
+    arg_parse_options(arg_vector_next, &vector, options, index->num_options, index);
+}
+
+// Function to check if an option has been parsed, with a prebuilt index
+int fscl_arg_parse_has_indexed(const coption* options, const coption_index* index, const char* option_name) {
+    int j = fscl_arg_index_find(index, option_name, strlen(option_name));
+    return j >= 0 && options[j].parsed;
+}
+
+// Function to check for unrecognized arguments with a prebuilt index
+void fscl_arg_check_unrecognized_indexed(ccommandline* cmd, const coption_index* index) {
+    arg_check_options(cmd, index->options, index->num_options, index);
+}
+
+// Function to parse arguments from a token source
+void fscl_arg_parse_stream(carg_next_token next, void* source, coption* options, int num_options, const coption_index* index) {
+    coption_index storage;
+    const coption_index* temporary = NULL;
+    if (!index) {
+        temporary = arg_temporary_index(&storage, options, num_options);
+        index = temporary;
+    }
+    arg_parse_options(next, source, options, num_options, index);
+    if (temporary) {
+        fscl_arg_index_erase(&storage);
+    }
+}
+
+// Function to open a response file
+int fscl_arg_response_open(carg_response* response, const char* path) {
+    response->cursor = NULL;
+    response->end = NULL;
+    response->tail = NULL;
+    if (fscl_filemap_open(&response->map, path, FILEMAP_PRIVATE, 0) != 0) {
+        return -1;
+    }
+    fscl_filemap_advise(&response->map, FILEMAP_ADVICE_SEQUENTIAL);
+    response->cursor = response->map.data;
+    response->end = response->map.data + response->map.length;
+    return 0;
+}
+
+static int arg_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Function to cut the next token out of a response file
+const char* fscl_arg_response_next(carg_response* response) {
+    char* cursor = response->cursor;
+    char* end = response->end;
+    while (cursor < end && arg_is_space(*cursor)) {
+        ++cursor;
+    }
+    if (cursor >= end) {
+        response->cursor = cursor;
+        return NULL;
+    }
+
+    // Unquoting only ever shrinks the token, so it is written over itself
+    char* start = cursor;
+    char* out = cursor;
+    char quote = 0;
+    while (cursor < end) {
+        char c = *cursor;
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            } else if (quote == '"' && c == '\\' && cursor + 1 < end && (cursor[1] == '"' || cursor[1] == '\\')) {
+                *out++ = *++cursor;
+            } else {
+                *out++ = c;
+            }
+            ++cursor;
+            continue;
+        }
+        if (arg_is_space(c)) {
+            break;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+        } else if (c == '\\' && cursor + 1 < end) {
+            *out++ = *++cursor;
+        } else {
+            *out++ = c;
+        }
+        ++cursor;
+    }
+
+    if (out < end) {
+        *out = '\0';
+        response->cursor = cursor < end ? cursor + 1 : cursor;
+        return start;
+    }
+
+    // The view ends right after the token, there is no byte left for the NUL
+    size_t length = (size_t)(out - start);
+    free(response->tail);
+    response->tail = malloc(length + 1);
+    response->cursor = end;
+    if (!response->tail) {
+        return NULL;
+    }
+    memcpy(response->tail, start, length);
+    response->tail[length] = '\0';
+    return response->tail;
+}
+
+// Function to close a response file
+void fscl_arg_response_close(carg_response* response) {
+    fscl_filemap_close(&response->map);
+    free(response->tail);
+    response->tail = NULL;
+    response->cursor = NULL;
+    response->end = NULL;
+}
+
+// Function to start reading the arguments of a command line
+void fscl_arg_tokens_init(carg_tokens* tokens, const ccommandline* cmd) {
+    tokens->argc = cmd->argc;
+    tokens->argv = cmd->argv;
+    tokens->position = 1;
+    tokens->files = NULL;
+    tokens->file_count = 0;
+    tokens->file_capacity = 0;
+    tokens->depth = 0;
+}
+
+// Open a response file and make it the innermost source
+static int arg_tokens_push(carg_tokens* tokens, const char* path) {
+    if (tokens->depth == FSCL_ARG_RESPONSE_DEPTH) {
+        return -1;
+    }
+    if (tokens->file_count == tokens->file_capacity) {
+        int capacity = tokens->file_capacity ? tokens->file_capacity * 2 : 4;
+        carg_response* files = realloc(tokens->files, (size_t)capacity * sizeof(carg_response));
+        if (!files) {
+            return -1;
+        }
+        tokens->files = files;
+        tokens->file_capacity = capacity;
+    }
+    if (fscl_arg_response_open(&tokens->files[tokens->file_count], path) != 0) {
+        return -1;
+    }
+    tokens->stack[tokens->depth++] = tokens->file_count++;
+    return 0;
+}
+
+// Function to get the next argument of a command line
+const char* fscl_arg_tokens_next(void* source) {
+    carg_tokens* tokens = (carg_tokens*)source;
+    for (;;) {
+        const char* token;
+        if (tokens->depth > 0) {
+            token = fscl_arg_response_next(&tokens->files[tokens->stack[tokens->depth - 1]]);
+            if (!token) {
+                tokens->depth--;
+                continue;
+            }
+        } else if (tokens->position < tokens->argc) {
+            token = tokens->argv[tokens->position++];
+        } else {
+            return NULL;
+        }
+        if (token[0] == '@' && token[1] != '\0' && arg_tokens_push(tokens, token + 1) == 0) {
+            continue;
+        }
+        return token;
+    }
+}
+
+// Function to close the response files of a token source
+void fscl_arg_tokens_close(carg_tokens* tokens) {
+    for (int i = 0; i < tokens->file_count; ++i) {
+        fscl_arg_response_close(&tokens->files[i]);
+    }
+    free(tokens->files);
+    tokens->files = NULL;
+    tokens->file_count = 0;
+    tokens->file_capacity = 0;
+    tokens->depth = 0;
+}
+
+static void arg_record(carg_errors* errors, carg_error_code code, int position, const char* argument, int option,
+                       carg_source source) {
+    if (!errors) {
+        return;
+    }
+    if (errors->count == errors->capacity) {
+        int capacity = errors->capacity ? errors->capacity * 2 : 8;
+        carg_error* grown = realloc(errors->errors, (size_t)capacity * sizeof(carg_error));
+        if (!grown) {
+            return; // the problem is still counted by the caller
+        }
+        errors->errors = grown;
+        errors->capacity = capacity;
+    }
+    carg_error* error = &errors->errors[errors->count++];
+    error->code = code;
+    error->position = position;
+    error->argument = argument;
+    error->option = option;
+    error->source = source;
+}
+
+// Take the value of an option: attached after '=' or in the next token
+static const char* arg_take_value(carg_next_token next, void* source, const char* attached, int* position) {
+    if (attached) {
+        return attached;
+    }
+    const char* value = next(source);
+    if (value) {
+        ++*position;
+    }
+    return value;
+}
+
+// Where a checked parse stores values: into the options themselves, or
+// into a separate result when the options are a shared schema
+typedef struct {
+    coption* options;
+    carg_value* values;
+} arg_target;
+
+static coption_value* arg_target_value(const arg_target* target, int j) {
+    return target->values ? &target->values[j].value : &target->options[j].value;
+}
+
+static void arg_target_mark(const arg_target* target, int j) {
+    if (target->values) {
+        target->values[j].parsed = 1;
+        target->values[j].source = CARG_SOURCE_COMMAND_LINE;
+    } else {
+        target->options[j].parsed = 1;
+        target->options[j].source = CARG_SOURCE_COMMAND_LINE;
+    }
+}
+
+// Parse a group of single letter options such as "-vx" or "-j4"
+static int arg_parse_bundle(carg_next_token next, void* source, const coption* options, int num_options,
+                            const coption_index* index, const arg_target* target, const char* arg, int* position,
+                            carg_errors* errors) {
+    int problems = 0;
+    int start = *position;
+    for (const char* letter = arg + 1; *letter; ++letter) {
+        int j = arg_lookup_n(options, num_options, index, letter, 1);
+        if (j < 0) {
+            arg_record(errors, CARG_ERROR_UNKNOWN_OPTION, start, arg, -1, CARG_SOURCE_COMMAND_LINE);
+            return problems + 1;
+        }
+        if (options[j].type == COPTION_TYPE_BOOL) {
+            if (letter[1] == '=') {
+                // A flag in a bundle cannot carry a value ("-v=1")
+                arg_record(errors, CARG_ERROR_UNEXPECTED_VALUE, start, arg, j, CARG_SOURCE_COMMAND_LINE);
+                return problems + 1;
+            }
+            arg_target_value(target, j)->bool_val = 1;
+            arg_target_mark(target, j);
+            continue;
+        }
+        // The rest of the argument, if any, is the value of this letter
+        const char* attached = letter[1] ? letter + 1 + (letter[1] == '=') : NULL;
+        const char* value = arg_take_value(next, source, attached, position);
+        int status = value ? arg_apply_value(&options[j], arg_target_value(target, j), value) : CARG_ERROR_MISSING_VALUE;
+        if (status == ARG_VALUE_OK) {
+            arg_target_mark(target, j);
+        } else {
+            arg_record(errors, (carg_error_code)status, start, arg, j, CARG_SOURCE_COMMAND_LINE);
+            ++problems;
+        }
+        break;
+    }
+    return problems;
+}
+
+static int arg_parse_checked(carg_next_token next, void* source, const coption* options, int num_options,
+                             const coption_index* index, const arg_target* target, carg_errors* errors) {
+    int problems = 0;
+    int position = 0;
+    int positional_only = 0;
+    const char* arg;
+    while ((arg = next(source)) != NULL) {
+        ++position;
+        if (positional_only || arg[0] != '-' || arg[1] == '\0') {
+            continue; // positional argument, "-" usually means stdin
+        }
+        int double_dash = arg[1] == '-';
+        if (double_dash && arg[2] == '\0') {
+            positional_only = 1;
+            continue;
+        }
+        const char* name = arg + 1 + double_dash;
+        const char* equals = strchr(name, '=');
+        size_t length = equals ? (size_t)(equals - name) : strlen(name);
+        int j = arg_lookup_n(options, num_options, index, name, length);
+        if (j < 0) {
+            if (!double_dash && length > 1 && arg_lookup_n(options, num_options, index, name, 1) >= 0) {
+                problems += arg_parse_bundle(next, source, options, num_options, index, target, arg, &position, errors);
+            } else {
+                arg_record(errors, CARG_ERROR_UNKNOWN_OPTION, position, arg, -1, CARG_SOURCE_COMMAND_LINE);
+                ++problems;
+            }
+            continue;
+        }
+
+        int start = position;
+        int status = ARG_VALUE_OK;
+        if (options[j].type == COPTION_TYPE_BOOL && !equals) {
+            arg_target_value(target, j)->bool_val = 1;
+        } else if (options[j].type == COPTION_TYPE_BOOL) {
+            // A flag takes no value, only an explicit on/off spelling
+            int flag;
+            status = arg_parse_bool(equals + 1, &flag);
+            if (status == ARG_VALUE_OK) {
+                arg_target_value(target, j)->bool_val = flag;
+            } else {
+                status = CARG_ERROR_UNEXPECTED_VALUE;
+            }
+        } else {
+            const char* value = arg_take_value(next, source, equals ? equals + 1 : NULL, &position);
+            status = value ? arg_apply_value(&options[j], arg_target_value(target, j), value) : CARG_ERROR_MISSING_VALUE;
+        }
+        if (status == ARG_VALUE_OK) {
+            arg_target_mark(target, j);
+        } else {
+            arg_record(errors, (carg_error_code)status, start, arg, j, CARG_SOURCE_COMMAND_LINE);
+            ++problems;
+        }
+    }
+    return problems;
+}
+
+// Function to parse arguments from a token source without exiting
+int fscl_arg_parse_stream_checked(carg_next_token next, void* source, coption* options, int num_options,
+                                  const coption_index* index, carg_errors* errors) {
+    errors->errors = NULL;
+    errors->count = 0;
+    errors->capacity = 0;
+    coption_index storage;
+    const coption_index* temporary = NULL;
+    if (!index) {
+        temporary = arg_temporary_index(&storage, options, num_options);
+        index = temporary;
+    }
+    arg_target target = {options, NULL};
+    int problems = arg_parse_checked(next, source, options, num_options, index, &target, errors);
+    if (temporary) {
+        fscl_arg_index_erase(&storage);
+    }
+    return problems;
+}
+
+// Function to parse command line arguments without exiting
+int fscl_arg_parse_checked(ccommandline* cmd, coption* options, int num_options, const coption_index* index, carg_errors* errors) {
+    arg_vector vector = {cmd, 1};
+    return fscl_arg_parse_stream_checked(arg_vector_next, &vector, options, num_options, index, errors);
+}
+
+// Function to set up an arena over caller memory
+void fscl_arg_arena_init(carg_arena* arena, void* buffer, size_t capacity) {
+    arena->data = (char*)buffer;
+    arena->capacity = buffer ? capacity : 0;
+    arena->used = 0;
+}
+
+// Function to release everything carved from an arena
+void fscl_arg_arena_reset(carg_arena* arena) {
+    arena->used = 0;
+}
+
+static void* arg_arena_alloc(carg_arena* arena, size_t size) {
+    size_t align = _Alignof(max_align_t);
+    size_t start = (size_t)((uintptr_t)(arena->data + arena->used) % align);
+    start = start ? arena->used + (align - start) : arena->used;
+    if (start > arena->capacity || size > arena->capacity - start) {
+        return NULL;
+    }
+    arena->used = start + size;
+    return arena->data + start;
+}
+
+// Function to parse a token source against a shared schema
+int fscl_arg_parse_result_stream(const coption_index* schema, carg_next_token next, void* source, carg_arena* arena,
+                                 carg_result* result, carg_errors* errors) {
+    if (errors) {
+        errors->errors = NULL;
+        errors->count = 0;
+        errors->capacity = 0;
+    }
+    result->schema = schema;
+    result->values = NULL;
+    if (!schema || !arena) {
+        errno = EINVAL;
+        return -1;
+    }
+    carg_value* values = arg_arena_alloc(arena, (size_t)schema->num_options * sizeof(carg_value));
+    if (!values && schema->num_options > 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    for (int j = 0; j < schema->num_options; ++j) {
+        values[j].value = schema->options[j].value;
+        values[j].source = CARG_SOURCE_DEFAULT;
+        values[j].parsed = 0;
+    }
+    result->values = values;
+    arg_target target = {NULL, values};
+    return arg_parse_checked(next, source, schema->options, schema->num_options, schema, &target, errors);
+}
+
+// Function to parse a command line against a shared schema
+int fscl_arg_parse_result(const coption_index* schema, ccommandline* cmd, carg_arena* arena, carg_result* result,
+                          carg_errors* errors) {
+    arg_vector vector = {cmd, 1};
+    return fscl_arg_parse_result_stream(schema, arg_vector_next, &vector, arena, result, errors);
+}
+
+// Function to look up the value of an option in a parse result
+const coption_value* fscl_arg_result_get(const carg_result* result, const char* name) {
+    if (!result->values) {
+        return NULL;
+    }
+    int j = fscl_arg_index_find(result->schema, name, strlen(name));
+    return j >= 0 ? &result->values[j].value : NULL;
+}
+
+// Function to check if an option was given in a parse result
+int fscl_arg_result_has(const carg_result* result, const char* name) {
+    if (!result->values) {
+        return 0;
+    }
+    int j = fscl_arg_index_find(result->schema, name, strlen(name));
+    return j >= 0 && result->values[j].parsed;
+}
+
+// Function to describe an error code
+const char* fscl_arg_error_string(carg_error_code code) {
+    switch (code) {
+        case CARG_ERROR_UNKNOWN_OPTION:
+            return "unrecognized option";
+        case CARG_ERROR_MISSING_VALUE:
+            return "missing value";
+        case CARG_ERROR_INVALID_VALUE:
+            return "invalid value";
+        case CARG_ERROR_OUT_OF_RANGE:
+            return "value out of range";
+        case CARG_ERROR_UNEXPECTED_VALUE:
+            return "option takes no value";
+    }
+    return "unknown error";
+}
+
+// Function to release the error list of a checked parse
+void fscl_arg_errors_erase(carg_errors* errors) {
+    if (errors) {
+        free(errors->errors);
+        errors->errors = NULL;
+        errors->count = 0;
+        errors->capacity = 0;
+    }
+}
+
+// Apply one "key = value" line of a config file, the line ends at stop
+// and stop may be overwritten
+static int arg_config_line(char* first, char* stop, int line, coption* options, int num_options,
+                           const coption_index* index, carg_errors* errors) {
+    char* last = stop;
+    while (last > first && arg_is_space(last[-1])) {
+        --last;
+    }
+    char* equals = memchr(first, '=', (size_t)(last - first));
+    char* key_end = equals ? equals : last;
+    while (key_end > first && arg_is_space(key_end[-1])) {
+        --key_end;
+    }
+    int j = arg_lookup_n(options, num_options, index, first, (size_t)(key_end - first));
+
+    char* value = NULL;
+    if (equals) {
+        value = equals + 1;
+        while (value < last && arg_is_space(*value)) {
+            ++value;
+        }
+        if (last - value >= 2 && (*value == '"' || *value == '\'') && last[-1] == *value) {
+            ++value;
+            --last;
+        }
+        *last = '\0';
+    }
+    *key_end = '\0';
+
+    int status = ARG_VALUE_OK;
+    if (j < 0) {
+        status = CARG_ERROR_UNKNOWN_OPTION;
+    } else if (value) {
+        status = arg_apply_value(&options[j], &options[j].value, value);
+    } else if (options[j].type == COPTION_TYPE_BOOL) {
+        options[j].value.bool_val = 1;
+    } else {
+        status = CARG_ERROR_MISSING_VALUE;
+    }
+    if (status != ARG_VALUE_OK) {
+        arg_record(errors, (carg_error_code)status, line, first, j, CARG_SOURCE_CONFIG);
+        return 1;
+    }
+    options[j].source = CARG_SOURCE_CONFIG;
+    return 0;
+}
+
+// Read the config file layer in one pass over a private view of the file
+static int arg_resolve_config(carg_layers* layers, coption* options, int num_options, const coption_index* index,
+                              carg_errors* errors) {
+    if (fscl_filemap_open(&layers->config, layers->config_path, FILEMAP_PRIVATE, 0) != 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    layers->loaded = 1;
+    fscl_filemap_advise(&layers->config, FILEMAP_ADVICE_SEQUENTIAL);
+
+    size_t section_length = layers->section ? strlen(layers->section) : 0;
+    int in_section = 1; // top level keys always apply
+    int problems = 0;
+    int line = 0;
+    char* cursor = layers->config.data;
+    char* end = cursor + layers->config.length;
+    while (cursor < end) {
+        ++line;
+        char* first = cursor;
+        char* stop = memchr(cursor, '\n', (size_t)(end - cursor));
+        if (stop) {
+            cursor = stop + 1;
+        } else {
+            // The view may end exactly on a page, so the last line is copied
+            // to have room for its terminator
+            size_t length = (size_t)(end - cursor);
+            layers->tail = malloc(length + 1);
+            if (!layers->tail) {
+                return -1;
+            }
+            memcpy(layers->tail, cursor, length);
+            layers->tail[length] = '\0';
+            first = layers->tail;
+            stop = layers->tail + length;
+            cursor = end;
+        }
+
+        while (first < stop && arg_is_space(*first)) {
+            ++first;
+        }
+        if (first == stop || *first == '#' || *first == ';') {
+            continue;
+        }
+        if (*first == '[') {
+            char* close = memchr(first, ']', (size_t)(stop - first));
+            in_section = close && layers->section && (size_t)(close - first - 1) == section_length &&
+                         strncmp(first + 1, layers->section, section_length) == 0;
+            continue;
+        }
+        if (in_section) {
+            problems += arg_config_line(first, stop, line, options, num_options, index, errors);
+        }
+    }
+    return problems;
+}
+
+// Read the PREFIX_NAME environment variables of the options
+static int arg_resolve_environment(const char* prefix, coption* options, int num_options, carg_errors* errors) {
+    char name[256];
+    size_t prefix_length = strlen(prefix);
+    int problems = 0;
+    for (int j = 0; j < num_options; ++j) {
+        size_t length = strlen(options[j].name);
+        if (prefix_length + 1 + length >= sizeof(name)) {
+            continue;
+        }
+        memcpy(name, prefix, prefix_length);
+        name[prefix_length] = '_';
+        for (size_t i = 0; i < length; ++i) {
+            char c = options[j].name[i];
+            if (c >= 'a' && c <= 'z') {
+                c = (char)(c - 'a' + 'A');
+            } else if (!(c >= 'A' && c <= 'Z') && !(c >= '0' && c <= '9')) {
+                c = '_';
+            }
+            name[prefix_length + 1 + i] = c;
+        }
+        name[prefix_length + 1 + length] = '\0';
+
+        const char* value = getenv(name);
+        if (!value) {
+            continue;
+        }
+        int status = arg_apply_value(&options[j], &options[j].value, value);
+        if (status == ARG_VALUE_OK) {
+            options[j].source = CARG_SOURCE_ENVIRONMENT;
+        } else {
+            arg_record(errors, (carg_error_code)status, 0, value, j, CARG_SOURCE_ENVIRONMENT);
+            ++problems;
+        }
+    }
+    return problems;
+}
+
+// Function to resolve options from defaults, config file, environment and command line
+int fscl_arg_resolve(carg_layers* layers, ccommandline* cmd, coption* options, int num_options,
+                     const coption_index* index, carg_errors* errors) {
+    errors->errors = NULL;
+    errors->count = 0;
+    errors->capacity = 0;
+    layers->tail = NULL;
+    layers->loaded = 0;
+    for (int j = 0; j < num_options; ++j) {
+        options[j].source = CARG_SOURCE_DEFAULT;
+    }
+
+    coption_index storage;
+    const coption_index* temporary = NULL;
+    if (!index) {
+        temporary = arg_temporary_index(&storage, options, num_options);
+        index = temporary;
+    }
+    int problems = 0;
+    if (layers->config_path) {
+        problems = arg_resolve_config(layers, options, num_options, index, errors);
+    }
+    if (problems >= 0 && layers->env_prefix) {
+        problems += arg_resolve_environment(layers->env_prefix, options, num_options, errors);
+    }
+    if (problems >= 0 && cmd) {
+        arg_vector vector = {cmd, 1};
+        arg_target target = {options, NULL};
+        problems += arg_parse_checked(arg_vector_next, &vector, options, num_options, index, &target, errors);
+    }
+    if (temporary) {
+        fscl_arg_index_erase(&storage);
+    }
+    return problems;
+}
+
+// Function to release the config file of resolved layers
+void fscl_arg_layers_close(carg_layers* layers) {
+    if (!layers) {
+        return;
+    }
+    if (layers->loaded) {
+        fscl_filemap_close(&layers->config);
+        layers->loaded = 0;
+    }
+    free(layers->tail);
+    layers->tail = NULL;
+}
+
+// Function to build a subcommand registry into caller storage
+void fscl_arg_registry_init(csubcommand_registry* registry, const csubcommand* commands, int num_commands,
+                            coption_slot* slots, int capacity) {
+    registry->commands = commands;
+    registry->num_commands = num_commands;
+    registry->slots = slots;
+    registry->capacity = capacity;
+    registry->owned = 0;
+    arg_slots_fill(slots, capacity, commands, sizeof(csubcommand), num_commands);
+}
+
+// Function to build a subcommand registry
+int fscl_arg_registry_build(csubcommand_registry* registry, const csubcommand* commands, int num_commands) {
+    int capacity = num_commands * 2 + 1;
+    coption_slot* slots = malloc((size_t)capacity * sizeof(coption_slot));
+    if (!slots) {
+        registry->slots = NULL;
+        registry->capacity = 0;
+        registry->owned = 0;
+        return -1;
+    }
+    fscl_arg_registry_init(registry, commands, num_commands, slots, capacity);
+    registry->owned = 1;
+    return 0;
+}
+
+// Function to look up a subcommand by name
+const csubcommand* fscl_arg_registry_find(const csubcommand_registry* registry, const char* name, size_t length) {
+    if (!registry) {
+        return NULL;
+    }
+    int j = arg_slots_find(registry->slots, registry->capacity, registry->commands, sizeof(csubcommand), name, length);
+    return j >= 0 ? &registry->commands[j] : NULL;
+}
+
+// Function to select the subcommand named by the leading arguments
+const csubcommand* fscl_arg_registry_select(const csubcommand_registry* registry, const ccommandline* cmd, int* consumed) {
+    const csubcommand* selected = NULL;
+    int words = 0;
+    while (registry && 1 + words < cmd->argc) {
+        const char* word = cmd->argv[1 + words];
+        const csubcommand* command = fscl_arg_registry_find(registry, word, strlen(word));
+        if (!command) {
+            break;
+        }
+        selected = command;
+        registry = command->children;
+        ++words;
+    }
+    if (consumed) {
+        *consumed = words;
+    }
+    return selected;
+}
+
+// Function to run the subcommand named by the leading arguments
+int fscl_arg_dispatch(const csubcommand_registry* registry, ccommandline* cmd, void* user, int* status,
+                      carg_errors* errors) {
+    carg_errors local;
+    if (!errors) {
+        errors = &local;
+    }
+    errors->errors = NULL;
+    errors->count = 0;
+    errors->capacity = 0;
+    int words = 0;
+    const csubcommand* command = fscl_arg_registry_select(registry, cmd, &words);
+    if (!command || !command->handler) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    // The handler sees the last subcommand word as its program name
+    ccommandline sub = {cmd->argc - words, cmd->argv + words};
+    if (command->options && command->num_options > 0) {
+        arg_vector vector = {&sub, 1};
+        int problems = fscl_arg_parse_stream_checked(arg_vector_next, &vector, command->options, command->num_options,
+                                                     command->index ? command->index() : NULL, errors);
+        if (problems != 0) {
+            if (errors == &local) {
+                fscl_arg_errors_erase(&local);
+            }
+            errno = EINVAL;
+            return -1;
+        }
+    }
+    int result = command->handler(&sub, command->options, command->num_options, user);
+    if (status) {
+        *status = result;
+    }
+    return 0;
+}
+
+// Function to render the subcommands of a registry
+int fscl_arg_render_registry(carg_render* render, const char* program_name, const csubcommand_registry* registry,
+                             int width) {
+    if (width <= 0) {
+        width = fscl_arg_terminal_width(1);
+    }
+    size_t column = 0;
+    for (int i = 0; i < registry->num_commands; ++i) {
+        size_t length = strlen(registry->commands[i].name);
+        if (length > column) {
+            column = length;
+        }
+    }
+    column += 4; // indent before the name, gap before the help text
+    size_t limit = (size_t)width / 2;
+    if (column > limit) {
+        column = limit;
+    }
+
+    arg_render_format(render, "Usage: %s <command> [options]\n\nCommands:\n", program_name);
+    for (int i = 0; i < registry->num_commands; ++i) {
+        const csubcommand* command = &registry->commands[i];
+        size_t line = render->length;
+        arg_render_text(render, "  ");
+        arg_render_text(render, command->name);
+        if (command->help && command->help[0]) {
+            size_t length = render->length - line;
+            if (length + 2 > column) {
+                arg_render_text(render, "\n");
+                length = 0;
+            }
+            arg_render_fill(render, ' ', column - length);
+            arg_render_wrapped(render, command->help, column, (size_t)width);
+        }
+        arg_render_text(render, "\n");
+    }
+    return render->failed ? -1 : 0;
+}
+
+// Function to display the subcommands of a registry
+void fscl_arg_registry_usage(const char* program_name, const csubcommand_registry* registry) {
+    carg_render render = {0};
+    fscl_arg_render_registry(&render, program_name, registry, 0);
+    if (render.length > 0) {
+        fwrite(render.data, 1, render.length, stdout);
+    }
+    fscl_arg_render_erase(&render);
+}
+
+// Function to release a subcommand registry
+void fscl_arg_registry_erase(csubcommand_registry* registry) {
+    if (registry && registry->owned) {
+        free(registry->slots);
+    }
+    if (registry) {
+        registry->slots = NULL;
+        registry->capacity = 0;
+        registry->owned = 0;
+    }
+}
@@ -11,6 +11,7 @@ Description:
 ==============================================================================
 */
 #include "fossil/xutil/command.h"
+#include "fossil/xutil/statcache.h"
 #include <sys/stat.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -170,6 +171,10 @@ int fscl_command_exists(ccommand process) {
 
 // Function to check if a directory exists
 int fscl_command_erase_exists(ccommand path) {
+    cstatcache* cache = fscl_statcache_installed();
+    if (cache) {
+        return fscl_statcache_is_directory(cache, path);
+    }
     struct stat info;
     return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
 } // end of func
@@ -0,0 +1,530 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/diskusage.h"
+#include "workers.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(STATX_SIZE)
+#define FSCL_DISKUSAGE_STATX 1
+#endif
+
+// Shards of the hard link set, each with its own lock
+#define DISKUSAGE_LINK_SHARDS 64
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t* keys;   // device and inode pairs, inode 0 marks a free slot
+    size_t count;
+    size_t capacity;  // pairs
+} diskusage_links;
+
+// A directory that gets a node in the result
+typedef struct diskusage_dir {
+    struct diskusage_dir* parent;
+    struct diskusage_dir* children; // pushed concurrently, sorted when flattened
+    struct diskusage_dir* sibling;
+    size_t index;
+    int depth;
+    uint64_t apparent_size;         // own entries and collapsed subdirectories
+    uint64_t disk_usage;
+    uint64_t files;
+    uint64_t directories;
+    char name[];
+} diskusage_dir;
+
+// Shared state of one scan
+typedef struct {
+    fscl_workers* workers;
+    int limit;        // queued directories before subtrees are walked inline
+    int queued;       // submitted directories no worker has started yet
+    int max_depth;
+    size_t nodes;
+    size_t name_bytes;
+    uint64_t errors;
+    int error;        // fatal errno, allocation failures
+    diskusage_links links[DISKUSAGE_LINK_SHARDS];
+} diskusage_scan;
+
+// One directory to list
+typedef struct {
+    diskusage_scan* scan;
+    diskusage_dir* owner; // node the totals of this directory go to
+    int fd;
+    int depth;
+} diskusage_job;
+
+// Size information of one entry
+typedef struct {
+    uint64_t size;
+    uint64_t blocks;
+    uint64_t device;
+    uint64_t inode;
+    uint64_t links;
+    int is_directory;
+} diskusage_info;
+
+static int diskusage_stat(int dir_fd, const char* name, diskusage_info* info) {
+#ifdef FSCL_DISKUSAGE_STATX
+    struct statx buffer;
+    int flags = AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC | (*name ? 0 : AT_EMPTY_PATH);
+    if (statx(dir_fd, name, flags, STATX_TYPE | STATX_SIZE | STATX_BLOCKS | STATX_NLINK | STATX_INO, &buffer) != 0) {
+        return -1;
+    }
+    info->size = buffer.stx_size;
+    info->blocks = buffer.stx_blocks;
+    info->device = ((uint64_t)buffer.stx_dev_major << 32) | buffer.stx_dev_minor;
+    info->inode = buffer.stx_ino;
+    info->links = buffer.stx_nlink;
+    info->is_directory = S_ISDIR(buffer.stx_mode);
+#else
+    struct stat buffer;
+    if ((*name ? fstatat(dir_fd, name, &buffer, AT_SYMLINK_NOFOLLOW) : fstat(dir_fd, &buffer)) != 0) {
+        return -1;
+    }
+    info->size = (uint64_t)buffer.st_size;
+    info->blocks = (uint64_t)buffer.st_blocks;
+    info->device = (uint64_t)buffer.st_dev;
+    info->inode = (uint64_t)buffer.st_ino;
+    info->links = (uint64_t)buffer.st_nlink;
+    info->is_directory = S_ISDIR(buffer.st_mode);
+#endif
+    return 0;
+} // end of func
+
+static void diskusage_fail(diskusage_scan* scan, int error) {
+    int expected = 0;
+    __atomic_compare_exchange_n(&scan->error, &expected, error, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+} // end of func
+
+// Record a hard linked file, returns 1 the first time it is seen
+static int diskusage_first_link(diskusage_scan* scan, uint64_t device, uint64_t inode) {
+    uint64_t hash = (inode ^ (device * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL;
+    diskusage_links* shard = &scan->links[(hash >> 58) % DISKUSAGE_LINK_SHARDS];
+    int first = 1;
+    pthread_mutex_lock(&shard->lock);
+    if ((shard->count + 1) * 2 > shard->capacity) {
+        size_t capacity = shard->capacity ? shard->capacity * 2 : 64;
+        uint64_t* keys = (uint64_t*)calloc(capacity * 2, sizeof(uint64_t));
+        if (!keys) {
+            pthread_mutex_unlock(&shard->lock);
+            diskusage_fail(scan, ENOMEM);
+            return 1;
+        }
+        for (size_t i = 0; i < shard->capacity; ++i) {
+            if (shard->keys[i * 2 + 1] == 0) {
+                continue;
+            }
+            uint64_t rehash = (shard->keys[i * 2 + 1] ^ (shard->keys[i * 2] * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL;
+            size_t slot = rehash & (capacity - 1);
+            while (keys[slot * 2 + 1] != 0) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            keys[slot * 2] = shard->keys[i * 2];
+            keys[slot * 2 + 1] = shard->keys[i * 2 + 1];
+        }
+        free(shard->keys);
+        shard->keys = keys;
+        shard->capacity = capacity;
+    }
+    size_t slot = hash & (shard->capacity - 1);
+    while (shard->keys[slot * 2 + 1] != 0) {
+        if (shard->keys[slot * 2] == device && shard->keys[slot * 2 + 1] == inode) {
+            first = 0;
+            break;
+        }
+        slot = (slot + 1) & (shard->capacity - 1);
+    }
+    if (first) {
+        shard->keys[slot * 2] = device;
+        shard->keys[slot * 2 + 1] = inode ? inode : 1;
+        shard->count++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return first;
+} // end of func
+
+static diskusage_dir* diskusage_dir_create(diskusage_scan* scan, diskusage_dir* parent, const char* name, int depth) {
+    size_t length = strlen(name);
+    diskusage_dir* dir = (diskusage_dir*)calloc(1, sizeof(diskusage_dir) + length + 1);
+    if (!dir) {
+        diskusage_fail(scan, ENOMEM);
+        return NULL;
+    }
+    dir->parent = parent;
+    dir->depth = depth;
+    memcpy(dir->name, name, length + 1);
+    __atomic_add_fetch(&scan->nodes, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&scan->name_bytes, length + 1, __ATOMIC_RELAXED);
+    if (parent) {
+        diskusage_dir* head = __atomic_load_n(&parent->children, __ATOMIC_RELAXED);
+        do {
+            dir->sibling = head;
+        } while (!__atomic_compare_exchange_n(&parent->children, &head, dir, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+    return dir;
+} // end of func
+
+static void diskusage_task(void* arg);
+
+// A queued directory leaves the queue as soon as a worker picks it up
+static void diskusage_queued_task(void* arg) {
+    diskusage_job* job = (diskusage_job*)arg;
+    __atomic_sub_fetch(&job->scan->queued, 1, __ATOMIC_RELAXED);
+    diskusage_task(job);
+} // end of func
+
+static void diskusage_task(void* arg) {
+    diskusage_job* job = (diskusage_job*)arg;
+    diskusage_scan* scan = job->scan;
+    uint64_t apparent_size = 0;
+    uint64_t blocks = 0;
+    uint64_t files = 0;
+    uint64_t directories = 1;
+    uint64_t errors = 0;
+
+    diskusage_info info;
+    if (diskusage_stat(job->fd, "", &info) == 0) {
+        apparent_size += info.size;
+        blocks += info.blocks;
+    } else {
+        errors++;
+    }
+
+    DIR* dir = fdopendir(job->fd);
+    if (!dir) {
+        close(job->fd);
+        errors++;
+    }
+    struct dirent* entry;
+    while (dir && (entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        int is_directory = 0;
+#ifdef DT_DIR
+        is_directory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN)
+#endif
+        {
+            if (diskusage_stat(dirfd(dir), name, &info) != 0) {
+                errors++;
+                continue;
+            }
+            is_directory = info.is_directory;
+        }
+
+        if (is_directory) {
+            int child_fd = openat(dirfd(dir), name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (child_fd < 0) {
+                errors++;
+                continue;
+            }
+            diskusage_job* child = (diskusage_job*)malloc(sizeof(diskusage_job));
+            diskusage_dir* owner = job->owner;
+            if (child && (scan->max_depth < 0 || job->depth + 1 <= scan->max_depth)) {
+                owner = diskusage_dir_create(scan, job->owner, name, job->depth + 1);
+            }
+            if (!child || !owner) {
+                free(child);
+                close(child_fd);
+                diskusage_fail(scan, ENOMEM);
+                continue;
+            }
+            child->scan = scan;
+            child->owner = owner;
+            child->fd = child_fd;
+            child->depth = job->depth + 1;
+
+            // Hand subtrees to idle workers, keep descending inline when they are busy
+            if (__atomic_add_fetch(&scan->queued, 1, __ATOMIC_RELAXED) <= scan->limit &&
+                fscl_workers_submit(scan->workers, diskusage_queued_task, child) == 0) {
+                continue;
+            }
+            __atomic_sub_fetch(&scan->queued, 1, __ATOMIC_RELAXED);
+            diskusage_task(child);
+            continue;
+        }
+
+#ifdef DT_DIR
+        if (entry->d_type != DT_UNKNOWN && diskusage_stat(dirfd(dir), name, &info) != 0) {
+            errors++;
+            continue;
+        }
+#endif
+        if (info.links > 1 && !diskusage_first_link(scan, info.device, info.inode)) {
+            continue;
+        }
+        apparent_size += info.size;
+        blocks += info.blocks;
+        files++;
+    }
+    if (dir) {
+        closedir(dir);
+    }
+
+    diskusage_dir* owner = job->owner;
+    __atomic_add_fetch(&owner->apparent_size, apparent_size, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&owner->disk_usage, blocks * 512, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&owner->files, files, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&owner->directories, directories, __ATOMIC_RELAXED);
+    if (errors) {
+        __atomic_add_fetch(&scan->errors, errors, __ATOMIC_RELAXED);
+    }
+    free(job);
+} // end of func
+
+static int diskusage_compare(const void* left, const void* right) {
+    const diskusage_dir* a = *(const diskusage_dir* const*)left;
+    const diskusage_dir* b = *(const diskusage_dir* const*)right;
+    return strcmp(a->name, b->name);
+} // end of func
+
+// Sort the children of a directory by name, relinking the list
+static int diskusage_sort_children(diskusage_dir* dir, diskusage_dir*** scratch, size_t* scratch_capacity) {
+    size_t count = 0;
+    for (diskusage_dir* child = dir->children; child; child = child->sibling) {
+        if (count == *scratch_capacity) {
+            size_t capacity = *scratch_capacity ? *scratch_capacity * 2 : 64;
+            diskusage_dir** grown = (diskusage_dir**)realloc(*scratch, capacity * sizeof(diskusage_dir*));
+            if (!grown) {
+                return -1;
+            }
+            *scratch = grown;
+            *scratch_capacity = capacity;
+        }
+        (*scratch)[count++] = child;
+    }
+    if (count < 2) {
+        return 0;
+    }
+    qsort(*scratch, count, sizeof(diskusage_dir*), diskusage_compare);
+    for (size_t i = 0; i < count; ++i) {
+        (*scratch)[i]->sibling = i + 1 < count ? (*scratch)[i + 1] : NULL;
+    }
+    dir->children = (*scratch)[0];
+    return 0;
+} // end of func
+
+// Turn the linked directories into the preorder array and sum the totals upward
+static int diskusage_flatten(diskusage_scan* scan, diskusage_dir* root, cdiskusage_tree* tree) {
+    tree->nodes = (cdiskusage_node*)malloc(scan->nodes * sizeof(cdiskusage_node));
+    tree->names = (char*)malloc(scan->name_bytes);
+    diskusage_dir** order = (diskusage_dir**)malloc(scan->nodes * sizeof(diskusage_dir*));
+    diskusage_dir** stack = (diskusage_dir**)malloc(scan->nodes * sizeof(diskusage_dir*));
+    diskusage_dir** scratch = NULL;
+    size_t scratch_capacity = 0;
+    int result = -1;
+    if (!tree->nodes || !tree->names || !order || !stack) {
+        goto done;
+    }
+
+    size_t count = 0;
+    size_t depth = 0;
+    size_t used = 0;
+    stack[depth++] = root;
+    while (depth > 0) {
+        diskusage_dir* dir = stack[--depth];
+        if (diskusage_sort_children(dir, &scratch, &scratch_capacity) != 0) {
+            goto done;
+        }
+        dir->index = count;
+        order[count++] = dir;
+        size_t first = depth;
+        for (diskusage_dir* child = dir->children; child; child = child->sibling) {
+            stack[depth++] = child;
+        }
+        // Reverse so the smallest name is popped first
+        for (size_t i = first, j = depth; i + 1 < j; ++i, --j) {
+            diskusage_dir* swap = stack[i];
+            stack[i] = stack[j - 1];
+            stack[j - 1] = swap;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        diskusage_dir* dir = order[i];
+        cdiskusage_node* node = &tree->nodes[i];
+        size_t length = strlen(dir->name);
+        memcpy(tree->names + used, dir->name, length + 1);
+        node->name = tree->names + used;
+        used += length + 1;
+        node->parent = dir->parent ? dir->parent->index : FSCL_DISKUSAGE_NONE;
+        node->first_child = dir->children ? dir->children->index : FSCL_DISKUSAGE_NONE;
+        node->next_sibling = dir->sibling ? dir->sibling->index : FSCL_DISKUSAGE_NONE;
+        node->depth = dir->depth;
+        node->apparent_size = dir->apparent_size;
+        node->disk_usage = dir->disk_usage;
+        node->files = dir->files;
+        node->directories = dir->directories;
+    }
+    // Parents come before their children, so one backward pass sums everything
+    for (size_t i = count; i-- > 1;) {
+        cdiskusage_node* parent = &tree->nodes[tree->nodes[i].parent];
+        parent->apparent_size += tree->nodes[i].apparent_size;
+        parent->disk_usage += tree->nodes[i].disk_usage;
+        parent->files += tree->nodes[i].files;
+        parent->directories += tree->nodes[i].directories;
+    }
+    tree->count = count;
+    result = 0;
+
+done:
+    free(order);
+    free(stack);
+    free(scratch);
+    if (result != 0) {
+        errno = ENOMEM;
+    }
+    return result;
+} // end of func
+
+static void diskusage_free_dirs(diskusage_dir* root) {
+    // Reuse the sibling links as a work list to free without recursion
+    root->sibling = NULL;
+    diskusage_dir* pending = root;
+    while (pending) {
+        diskusage_dir* dir = pending;
+        pending = dir->sibling;
+        for (diskusage_dir* child = dir->children; child;) {
+            diskusage_dir* next = child->sibling;
+            child->sibling = pending;
+            pending = child;
+            child = next;
+        }
+        free(dir);
+    }
+} // end of func
+#endif
+
+// Function to measure the disk usage of a tree
+int fscl_diskusage_scan(const cfilesystem* root, int max_depth, int threads, cdiskusage_tree* tree) {
+    if (!root || !root->path || !*root->path || !tree) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(tree, 0, sizeof(*tree));
+#ifdef _WIN32
+    (void)max_depth;
+    (void)threads;
+    errno = ENOSYS;
+    return -1;
+#else
+    int fd = open(root->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    diskusage_scan* scan = (diskusage_scan*)calloc(1, sizeof(diskusage_scan));
+    if (!scan) {
+        close(fd);
+        errno = ENOMEM;
+        return -1;
+    }
+    for (int i = 0; i < DISKUSAGE_LINK_SHARDS; ++i) {
+        pthread_mutex_init(&scan->links[i].lock, NULL);
+    }
+    scan->max_depth = max_depth;
+    scan->workers = fscl_workers_create(threads);
+    diskusage_dir* top = diskusage_dir_create(scan, NULL, root->path, 0);
+    diskusage_job* job = (diskusage_job*)malloc(sizeof(diskusage_job));
+    int result = -1;
+    if (scan->workers && top && job) {
+        scan->limit = fscl_workers_count(scan->workers) * 4;
+        job->scan = scan;
+        job->owner = top;
+        job->fd = fd;
+        job->depth = 0;
+        diskusage_task(job);
+        fscl_workers_wait(scan->workers);
+        if (scan->error == 0) {
+            result = diskusage_flatten(scan, top, tree);
+        } else {
+            errno = scan->error;
+        }
+        tree->errors = scan->errors;
+    } else {
+        free(job);
+        close(fd);
+        errno = ENOMEM;
+    }
+    int error = errno;
+
+    fscl_workers_erase(scan->workers);
+    if (top) {
+        diskusage_free_dirs(top);
+    }
+    for (int i = 0; i < DISKUSAGE_LINK_SHARDS; ++i) {
+        pthread_mutex_destroy(&scan->links[i].lock);
+        free(scan->links[i].keys);
+    }
+    free(scan);
+    if (result != 0) {
+        fscl_diskusage_erase(tree);
+    }
+    errno = error;
+    return result;
+#endif
+} // end of func
+
+// Function to find a node by relative path
+const cdiskusage_node* fscl_diskusage_find(const cdiskusage_tree* tree, const char* path) {
+    if (!tree || tree->count == 0 || !path) {
+        return NULL;
+    }
+    size_t index = 0;
+    while (*path) {
+        while (*path == '/') {
+            ++path;
+        }
+        size_t length = strcspn(path, "/");
+        if (length == 0 || (length == 1 && path[0] == '.')) {
+            path += length;
+            continue;
+        }
+        size_t child = tree->nodes[index].first_child;
+        while (child != FSCL_DISKUSAGE_NONE &&
+               (strncmp(tree->nodes[child].name, path, length) != 0 || tree->nodes[child].name[length] != '\0')) {
+            child = tree->nodes[child].next_sibling;
+        }
+        if (child == FSCL_DISKUSAGE_NONE) {
+            return NULL;
+        }
+        index = child;
+        path += length;
+    }
+    return &tree->nodes[index];
+} // end of func
+
+// Function to release a disk usage tree
+void fscl_diskusage_erase(cdiskusage_tree* tree) {
+    if (tree) {
+        free(tree->nodes);
+        free(tree->names);
+        tree->nodes = NULL;
+        tree->names = NULL;
+        tree->count = 0;
+    }
+} // end of func
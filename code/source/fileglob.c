@@ -0,0 +1,704 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/fileglob.h"
+#include "fossil/xutil/filepath.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+// Kinds of compiled path components
+#define FILEGLOB_LITERAL 0  // plain name, compared as a string
+#define FILEGLOB_WILDCARD 1 // name with '*', '?' or classes, run as a program
+#define FILEGLOB_GLOBSTAR 2 // "**", any number of directories
+
+// Instructions of a wildcard program
+#define FILEGLOB_OP_CHAR 1  // followed by the byte to match
+#define FILEGLOB_OP_ANY 2
+#define FILEGLOB_OP_STAR 3
+#define FILEGLOB_OP_CLASS 4 // followed by a 256 bit set
+
+// Alternatives a single pattern may expand to through braces
+#define FILEGLOB_MAX_EXPANSION 4096
+
+#define FILEGLOB_NO_MATCH ((size_t)-1)
+
+typedef struct {
+    unsigned char kind;
+    unsigned char last;     // final component of its alternative
+    size_t pattern;         // index of the source pattern
+    size_t offset;          // literal text or program in the byte pool
+    size_t length;
+} fileglob_segment;
+
+struct cfileglob {
+    fileglob_segment* segments; // components of each alternative, in order
+    size_t count;
+    size_t capacity;
+    unsigned char* bytes;       // pool of literal texts and programs
+    size_t bytes_used;
+    size_t bytes_capacity;
+    size_t* starts;             // first component of each alternative
+    size_t start_count;
+    size_t start_capacity;
+};
+
+// An active position in some pattern, literals carry their text for lookup
+typedef struct {
+    const char* text;
+    size_t segment;
+} fileglob_state;
+
+// States active in one directory, literal ones first and sorted by text
+typedef struct {
+    fileglob_state* states;
+    size_t count;
+    size_t literal_count;
+} fileglob_set;
+
+static int fileglob_reserve(void** data, size_t* capacity, size_t needed, size_t size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    size_t grown = *capacity ? *capacity : 16;
+    while (grown < needed) {
+        grown *= 2;
+    }
+    void* memory = realloc(*data, grown * size);
+    if (!memory) {
+        errno = ENOMEM;
+        return -1;
+    }
+    *data = memory;
+    *capacity = grown;
+    return 0;
+} // end of func
+
+static int fileglob_emit(cfileglob* glob, const void* data, size_t length) {
+    if (fileglob_reserve((void**)&glob->bytes, &glob->bytes_capacity, glob->bytes_used + length, 1) != 0) {
+        return -1;
+    }
+    memcpy(glob->bytes + glob->bytes_used, data, length);
+    glob->bytes_used += length;
+    return 0;
+} // end of func
+
+// Parse a bracket class starting after '[', returns the bytes consumed or 0
+static size_t fileglob_class(const char* text, size_t length, unsigned char set[32]) {
+    size_t i = 0;
+    int negate = 0;
+    memset(set, 0, 32);
+    if (i < length && (text[i] == '!' || text[i] == '^')) {
+        negate = 1;
+        ++i;
+    }
+    size_t first = i;
+    while (i < length && (text[i] != ']' || i == first)) {
+        unsigned char low = (unsigned char)text[i];
+        if (low == '\\' && i + 1 < length) {
+            low = (unsigned char)text[++i];
+        }
+        unsigned char high = low;
+        if (i + 2 < length && text[i + 1] == '-' && text[i + 2] != ']') {
+            high = (unsigned char)text[i + 2];
+            if (high == '\\' && i + 3 < length) {
+                high = (unsigned char)text[++i + 2];
+            }
+            i += 2;
+        }
+        for (unsigned value = low; value <= high; ++value) {
+            set[value >> 3] |= (unsigned char)(1u << (value & 7));
+        }
+        ++i;
+    }
+    if (i >= length) {
+        return 0; // no closing bracket, the '[' is literal
+    }
+    if (negate) {
+        for (int b = 0; b < 32; ++b) {
+            set[b] = (unsigned char)~set[b];
+        }
+    }
+    return i + 1;
+} // end of func
+
+// Compile one path component of an expanded pattern
+static int fileglob_segment_add(cfileglob* glob, size_t pattern, const char* text, size_t length) {
+    if (fileglob_reserve((void**)&glob->segments, &glob->capacity, glob->count + 1, sizeof(fileglob_segment)) != 0) {
+        return -1;
+    }
+    fileglob_segment* segment = &glob->segments[glob->count];
+    segment->pattern = pattern;
+    segment->last = 0;
+    segment->offset = glob->bytes_used;
+    if (length == 2 && text[0] == '*' && text[1] == '*') {
+        segment->kind = FILEGLOB_GLOBSTAR;
+        segment->length = 0;
+        glob->count++;
+        return 0;
+    }
+
+    int wild = 0;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char op[2 + 32];
+        size_t op_length = 2;
+        op[0] = FILEGLOB_OP_CHAR;
+        op[1] = (unsigned char)text[i];
+        if (text[i] == '\\' && i + 1 < length) {
+            op[1] = (unsigned char)text[++i];
+        } else if (text[i] == '*') {
+            while (i + 1 < length && text[i + 1] == '*') {
+                ++i;
+            }
+            op[0] = FILEGLOB_OP_STAR;
+            op_length = 1;
+            wild = 1;
+        } else if (text[i] == '?') {
+            op[0] = FILEGLOB_OP_ANY;
+            op_length = 1;
+            wild = 1;
+        } else if (text[i] == '[') {
+            size_t used = fileglob_class(text + i + 1, length - i - 1, op + 1);
+            if (used) {
+                op[0] = FILEGLOB_OP_CLASS;
+                op_length = 33;
+                i += used;
+                wild = 1;
+            }
+        }
+        if (fileglob_emit(glob, op, op_length) != 0) {
+            return -1;
+        }
+    }
+
+    if (!wild) {
+        // Every instruction is a CHAR pair, keep the plain text instead
+        size_t chars = (glob->bytes_used - segment->offset) / 2;
+        unsigned char* program = glob->bytes + segment->offset;
+        for (size_t i = 0; i < chars; ++i) {
+            program[i] = program[i * 2 + 1];
+        }
+        program[chars] = '\0';
+        glob->bytes_used = segment->offset + chars + 1;
+        segment->kind = FILEGLOB_LITERAL;
+        segment->length = chars;
+    } else {
+        segment->kind = FILEGLOB_WILDCARD;
+        segment->length = glob->bytes_used - segment->offset;
+    }
+    glob->count++;
+    return 0;
+} // end of func
+
+// Compile one brace free alternative of a pattern
+static int fileglob_alternative(cfileglob* glob, size_t pattern, const char* text, size_t length) {
+    size_t first = glob->count;
+    size_t i = 0;
+    while (i < length) {
+        size_t start = i;
+        while (i < length && text[i] != '/') {
+            i += (text[i] == '\\' && i + 1 < length) ? 2 : 1;
+        }
+        size_t size = i - start;
+        if (size > 0 && !(size == 1 && text[start] == '.')) {
+            if (fileglob_segment_add(glob, pattern, text + start, size) != 0) {
+                return -1;
+            }
+        }
+        ++i;
+    }
+    if (glob->count == first) {
+        errno = EINVAL;
+        return -1;
+    }
+    glob->segments[glob->count - 1].last = 1;
+    if (fileglob_reserve((void**)&glob->starts, &glob->start_capacity, glob->start_count + 1, sizeof(size_t)) != 0) {
+        return -1;
+    }
+    glob->starts[glob->start_count++] = first;
+    return 0;
+} // end of func
+
+// Expand the first brace group and recurse, compile once none are left
+static int fileglob_expand(cfileglob* glob, size_t pattern, const char* text, size_t length, int* budget) {
+    for (size_t i = 0; i < length; ++i) {
+        if (text[i] == '\\') {
+            ++i;
+            continue;
+        }
+        if (text[i] != '{') {
+            continue;
+        }
+        // Find the matching brace and whether it holds alternatives
+        size_t close = 0;
+        int depth = 0;
+        int commas = 0;
+        for (size_t j = i; j < length; ++j) {
+            if (text[j] == '\\') {
+                ++j;
+            } else if (text[j] == '{') {
+                ++depth;
+            } else if (text[j] == '}' && --depth == 0) {
+                close = j;
+                break;
+            } else if (text[j] == ',' && depth == 1) {
+                ++commas;
+            }
+        }
+        if (close == 0 || commas == 0) {
+            continue; // not a brace group, keep the characters
+        }
+
+        char small[512];
+        char* buffer = length < sizeof(small) ? small : (char*)malloc(length);
+        if (!buffer) {
+            errno = ENOMEM;
+            return -1;
+        }
+        memcpy(buffer, text, i);
+        size_t start = i + 1;
+        depth = 0;
+        int result = 0;
+        for (size_t j = start; j <= close && result == 0; ++j) {
+            if (text[j] == '\\') {
+                ++j;
+                continue;
+            }
+            if (text[j] == '{') {
+                ++depth;
+            } else if (text[j] == '}' && depth > 0) {
+                --depth;
+            } else if ((text[j] == ',' && depth == 0) || j == close) {
+                size_t alt = j - start;
+                size_t tail = length - close - 1;
+                memcpy(buffer + i, text + start, alt);
+                memcpy(buffer + i + alt, text + close + 1, tail);
+                result = fileglob_expand(glob, pattern, buffer, i + alt + tail, budget);
+                start = j + 1;
+            }
+        }
+        if (buffer != small) {
+            free(buffer);
+        }
+        return result;
+    }
+    if (--*budget < 0) {
+        errno = E2BIG;
+        return -1;
+    }
+    return fileglob_alternative(glob, pattern, text, length);
+} // end of func
+
+// Run a wildcard program against a name, backtracking only to the last star
+static int fileglob_run(const unsigned char* program, size_t length, const char* name) {
+    size_t p = 0;
+    const char* n = name;
+    size_t star = (size_t)-1;
+    const char* star_name = NULL;
+    while (*n) {
+        if (p < length) {
+            unsigned char op = program[p];
+            unsigned char c = (unsigned char)*n;
+            if (op == FILEGLOB_OP_STAR) {
+                star = ++p;
+                star_name = n;
+                continue;
+            }
+            if (op == FILEGLOB_OP_ANY) {
+                ++p;
+                ++n;
+                continue;
+            }
+            if (op == FILEGLOB_OP_CHAR && program[p + 1] == c) {
+                p += 2;
+                ++n;
+                continue;
+            }
+            if (op == FILEGLOB_OP_CLASS && (program[p + 1 + (c >> 3)] & (1u << (c & 7)))) {
+                p += 33;
+                ++n;
+                continue;
+            }
+        }
+        if (star == (size_t)-1) {
+            return 0;
+        }
+        p = star;
+        n = ++star_name;
+    }
+    while (p < length && program[p] == FILEGLOB_OP_STAR) {
+        ++p;
+    }
+    return p == length;
+} // end of func
+
+static int fileglob_state_compare(const void* left, const void* right) {
+    const fileglob_state* a = (const fileglob_state*)left;
+    const fileglob_state* b = (const fileglob_state*)right;
+    if (a->text && b->text) {
+        int order = strcmp(a->text, b->text);
+        if (order != 0) {
+            return order;
+        }
+    } else if (a->text || b->text) {
+        return a->text ? -1 : 1;
+    }
+    return a->segment < b->segment ? -1 : a->segment > b->segment;
+} // end of func
+
+// Build the state set for a directory: follow "**" to the component after
+// it, drop duplicates and sort literal components for binary search
+static int fileglob_closure(const cfileglob* glob, const size_t* segments, size_t count, fileglob_set* set) {
+    set->states = NULL;
+    set->count = 0;
+    set->literal_count = 0;
+    if (count == 0) {
+        return 0;
+    }
+    size_t capacity = 0;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t s = segments[i];; ++s) {
+            if (fileglob_reserve((void**)&set->states, &capacity, set->count + 1, sizeof(fileglob_state)) != 0) {
+                free(set->states);
+                set->states = NULL;
+                return -1;
+            }
+            const fileglob_segment* segment = &glob->segments[s];
+            set->states[set->count].segment = s;
+            set->states[set->count].text =
+                segment->kind == FILEGLOB_LITERAL ? (const char*)glob->bytes + segment->offset : NULL;
+            set->count++;
+            if (segment->kind != FILEGLOB_GLOBSTAR || segment->last) {
+                break;
+            }
+        }
+    }
+    qsort(set->states, set->count, sizeof(fileglob_state), fileglob_state_compare);
+    size_t unique = 0;
+    for (size_t i = 0; i < set->count; ++i) {
+        if (unique > 0 && set->states[unique - 1].segment == set->states[i].segment) {
+            continue;
+        }
+        set->states[unique++] = set->states[i];
+    }
+    set->count = unique;
+    while (set->literal_count < set->count && set->states[set->literal_count].text) {
+        set->literal_count++;
+    }
+    return 0;
+} // end of func
+
+typedef struct {
+    size_t* items;
+    size_t count;
+    size_t capacity;
+} fileglob_list;
+
+static int fileglob_push(fileglob_list* list, size_t segment) {
+    if (fileglob_reserve((void**)&list->items, &list->capacity, list->count + 1, sizeof(size_t)) != 0) {
+        return -1;
+    }
+    list->items[list->count++] = segment;
+    return 0;
+} // end of func
+
+// Advance every state of a directory over one entry. Returns the first
+// pattern the entry completes and collects the states for its children.
+static size_t fileglob_step(const cfileglob* glob, const fileglob_set* set, const char* name, int is_directory,
+                            fileglob_list* next, int* failed) {
+    size_t best = FILEGLOB_NO_MATCH;
+    next->count = 0;
+
+    // Literal components: binary search for the first state with this name
+    size_t low = 0;
+    size_t high = set->literal_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (strcmp(set->states[middle].text, name) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (size_t i = low; i < set->literal_count && strcmp(set->states[i].text, name) == 0; ++i) {
+        const fileglob_segment* segment = &glob->segments[set->states[i].segment];
+        if (segment->last) {
+            best = segment->pattern < best ? segment->pattern : best;
+        } else if (is_directory && fileglob_push(next, set->states[i].segment + 1) != 0) {
+            *failed = 1;
+        }
+    }
+
+    for (size_t i = set->literal_count; i < set->count; ++i) {
+        size_t s = set->states[i].segment;
+        const fileglob_segment* segment = &glob->segments[s];
+        if (segment->kind == FILEGLOB_GLOBSTAR) {
+            if (segment->last) {
+                best = segment->pattern < best ? segment->pattern : best;
+            }
+            if (is_directory && fileglob_push(next, s) != 0) {
+                *failed = 1;
+            }
+            continue;
+        }
+        if (!fileglob_run(glob->bytes + segment->offset, segment->length, name)) {
+            continue;
+        }
+        if (segment->last) {
+            best = segment->pattern < best ? segment->pattern : best;
+        } else if (is_directory && fileglob_push(next, s + 1) != 0) {
+            *failed = 1;
+        }
+    }
+    return best;
+} // end of func
+
+// Function to compile glob patterns
+cfileglob* fscl_fileglob_compile(const char* const* patterns, size_t count) {
+    if (!patterns && count != 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    cfileglob* glob = (cfileglob*)calloc(1, sizeof(cfileglob));
+    if (!glob) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        int budget = FILEGLOB_MAX_EXPANSION;
+        if (!patterns[i] || fileglob_expand(glob, i, patterns[i], strlen(patterns[i]), &budget) != 0) {
+            int error = patterns[i] ? errno : EINVAL;
+            fscl_fileglob_erase(glob);
+            errno = error;
+            return NULL;
+        }
+    }
+    return glob;
+} // end of func
+
+// Function to match a relative path against compiled patterns
+long fscl_fileglob_match(const cfileglob* glob, const char* path) {
+    if (!glob || !path) {
+        return -1;
+    }
+    fileglob_set set;
+    fileglob_list next = {NULL, 0, 0};
+    if (fileglob_closure(glob, glob->starts, glob->start_count, &set) != 0) {
+        return -1;
+    }
+    long result = -1;
+    char small[256];
+    char* name = small;
+    size_t name_capacity = sizeof(small);
+    while (*path && set.count > 0) {
+        while (*path == '/') {
+            ++path;
+        }
+        size_t length = strcspn(path, "/");
+        const char* rest = path + length;
+        while (*rest == '/') {
+            ++rest;
+        }
+        if (length == 0 || (length == 1 && path[0] == '.')) {
+            path = rest;
+            continue;
+        }
+        if (length >= name_capacity) {
+            char* grown = (char*)(name == small ? malloc(length + 1) : realloc(name, length + 1));
+            if (!grown) {
+                break;
+            }
+            name = grown;
+            name_capacity = length + 1;
+        }
+        memcpy(name, path, length);
+        name[length] = '\0';
+
+        int failed = 0;
+        int is_directory = *rest != '\0';
+        size_t best = fileglob_step(glob, &set, name, is_directory, &next, &failed);
+        free(set.states);
+        set.states = NULL;
+        if (failed) {
+            break;
+        }
+        if (!is_directory) {
+            result = best == FILEGLOB_NO_MATCH ? -1 : (long)best;
+            break;
+        }
+        if (fileglob_closure(glob, next.items, next.count, &set) != 0) {
+            break;
+        }
+        path = rest;
+    }
+    free(set.states);
+    free(next.items);
+    if (name != small) {
+        free(name);
+    }
+    return result;
+} // end of func
+
+#ifndef _WIN32
+typedef struct {
+    const cfileglob* glob;
+    cfileglob_callback callback;
+    void* user;
+    cfilepath path;
+    long matches;
+    int stop;
+    int error;
+} fileglob_walk;
+
+static void fileglob_walk_dir(fileglob_walk* walk, int dir_fd, const fileglob_set* set);
+
+// Handle one entry of a directory
+static void fileglob_walk_entry(fileglob_walk* walk, int dir_fd, const fileglob_set* set, const char* name, int is_directory) {
+    fileglob_list next = {NULL, 0, 0};
+    int failed = 0;
+    size_t best = fileglob_step(walk->glob, set, name, is_directory, &next, &failed);
+    if (failed) {
+        walk->error = ENOMEM;
+        free(next.items);
+        return;
+    }
+    if (best == FILEGLOB_NO_MATCH && next.count == 0) {
+        free(next.items);
+        return; // nothing below can match, the directory is never opened
+    }
+
+    size_t length = walk->path.length;
+    if (fscl_filepath_join(&walk->path, name) != 0) {
+        walk->error = ENOMEM;
+        free(next.items);
+        return;
+    }
+    if (best != FILEGLOB_NO_MATCH) {
+        walk->matches++;
+        if (walk->callback && walk->callback(fscl_filepath_cstr(&walk->path), is_directory, best, walk->user) != 0) {
+            walk->stop = 1;
+        }
+    }
+    if (!walk->stop && next.count > 0) {
+        fileglob_set child;
+        if (fileglob_closure(walk->glob, next.items, next.count, &child) != 0) {
+            walk->error = ENOMEM;
+        } else {
+            int child_fd = openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (child_fd >= 0) {
+                fileglob_walk_dir(walk, child_fd, &child);
+            }
+            free(child.states);
+        }
+    }
+    fscl_filepath_truncate(&walk->path, length);
+    free(next.items);
+} // end of func
+
+// Walk one directory, takes ownership of dir_fd
+static void fileglob_walk_dir(fileglob_walk* walk, int dir_fd, const fileglob_set* set) {
+    if (set->literal_count == set->count) {
+        // Only plain names can match here: look them up instead of listing
+        for (size_t i = 0; i < set->count && !walk->stop && !walk->error; ++i) {
+            if (i > 0 && strcmp(set->states[i].text, set->states[i - 1].text) == 0) {
+                continue;
+            }
+            struct stat info;
+            if (fstatat(dir_fd, set->states[i].text, &info, AT_SYMLINK_NOFOLLOW) == 0) {
+                fileglob_walk_entry(walk, dir_fd, set, set->states[i].text, S_ISDIR(info.st_mode));
+            }
+        }
+        close(dir_fd);
+        return;
+    }
+
+    DIR* dir = fdopendir(dir_fd);
+    if (!dir) {
+        close(dir_fd);
+        return;
+    }
+    struct dirent* entry;
+    while (!walk->stop && !walk->error && (entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        int is_directory = 0;
+#ifdef DT_DIR
+        is_directory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN)
+#endif
+        {
+            struct stat info;
+            is_directory = fstatat(dirfd(dir), name, &info, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(info.st_mode);
+        }
+        fileglob_walk_entry(walk, dirfd(dir), set, name, is_directory);
+    }
+    closedir(dir);
+} // end of func
+#endif
+
+// Function to walk a tree and report matching entries
+long fscl_fileglob_walk(const cfileglob* glob, const char* root, cfileglob_callback callback, void* user) {
+    if (!glob || !root) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef _WIN32
+    (void)callback;
+    (void)user;
+    errno = ENOSYS;
+    return -1;
+#else
+    int fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    fileglob_walk walk = {glob, callback, user, {0}, 0, 0, 0};
+    fscl_filepath_init(&walk.path);
+    fileglob_set set;
+    if (fileglob_closure(glob, glob->starts, glob->start_count, &set) != 0) {
+        close(fd);
+        return -1;
+    }
+    fileglob_walk_dir(&walk, fd, &set);
+    free(set.states);
+    fscl_filepath_erase(&walk.path);
+    if (walk.error) {
+        errno = walk.error;
+        return -1;
+    }
+    return walk.matches;
+#endif
+} // end of func
+
+// Function to release compiled patterns
+void fscl_fileglob_erase(cfileglob* glob) {
+    if (glob) {
+        free(glob->segments);
+        free(glob->bytes);
+        free(glob->starts);
+        free(glob);
+    }
+} // end of func
@@ -0,0 +1,671 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/fileio.h"
+#include "workers.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <pthread.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define FSCL_FILEIO_THREADED 1
+#endif
+
+// io_uring needs UNLINKAT/MKDIRAT in the headers, present since Linux 5.15
+#if defined(__linux__) && !defined(FSCL_FILEIO_NO_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(IORING_FEAT_CQE_SKIP) && defined(__NR_io_uring_setup)
+#define FSCL_FILEIO_URING 1
+#endif
+#endif
+#endif
+
+// Default number of operations in flight on the ring
+#define FILEIO_DEFAULT_DEPTH 256
+
+// Largest number of requests a worker handles per task
+#define FILEIO_CHUNK 64
+
+// Largest single read or write request, longer ones become short transfers
+#define FILEIO_IO_LIMIT ((size_t)1 << 30)
+#define FILEIO_IO_COUNT(n) ((unsigned)((n) < FILEIO_IO_LIMIT ? (n) : FILEIO_IO_LIMIT))
+
+// Number of distinct cfileio_op values
+#define FILEIO_OP_COUNT (FILEIO_OP_RMDIR + 1)
+
+// A group of requests executed by one worker task
+typedef struct fileio_chunk {
+    struct fileio_chunk* next;
+    cfileio* io;
+    size_t count;
+    cfileio_request* items[FILEIO_CHUNK];
+} fileio_chunk;
+
+#ifdef FSCL_FILEIO_URING
+// Per in-flight operation state, indexed by the sqe user_data
+typedef struct {
+    cfileio_request* request;
+    struct statx info;
+} fileio_slot;
+
+typedef struct {
+    int fd;
+    unsigned depth;
+    unsigned inflight;
+    unsigned unsubmitted;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+    void* sq_ptr;
+    size_t sq_len;
+    void* cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+    fileio_slot* slots;
+    unsigned* free_slots;
+    unsigned free_count;
+    unsigned char supported[FILEIO_OP_COUNT];
+} fileio_ring;
+#endif
+
+struct cfileio {
+    cfileio_backend backend;
+    int threads;
+    fscl_workers* workers;      // started on first use
+    long failures;
+    cfileio_request** pending;  // requests waiting for ring space
+    size_t pending_head;
+    size_t pending_count;
+    size_t pending_capacity;
+    fileio_chunk* completed;    // chunks finished by workers
+    size_t outstanding;         // chunks handed to workers and not yet drained
+#ifdef FSCL_FILEIO_THREADED
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+#endif
+#ifdef FSCL_FILEIO_URING
+    fileio_ring ring;
+#endif
+};
+
+// =================================================================
+// Blocking execution used by the workers
+// =================================================================
+
+static void fileio_fill_stat(cfileio_stat* out, const struct stat* info) {
+    out->size = (unsigned long long)info->st_size;
+    out->inode = (unsigned long long)info->st_ino;
+    out->mode = (unsigned int)info->st_mode;
+#if defined(__APPLE__)
+    out->mtime_sec = (long long)info->st_mtimespec.tv_sec;
+    out->mtime_nsec = (long)info->st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    out->mtime_sec = (long long)info->st_mtime;
+    out->mtime_nsec = 0;
+#else
+    out->mtime_sec = (long long)info->st_mtim.tv_sec;
+    out->mtime_nsec = (long)info->st_mtim.tv_nsec;
+#endif
+} // end of func
+
+static long long fileio_execute(cfileio_request* request) {
+    long long result = -1;
+    switch (request->op) {
+        case FILEIO_OP_OPEN:
+#ifdef _WIN32
+            result = _open(request->path, request->flags | _O_BINARY, (int)request->mode);
+#else
+            result = open(request->path, request->flags | O_CLOEXEC, (mode_t)request->mode);
+#endif
+            break;
+        case FILEIO_OP_CLOSE:
+            result = close(request->fd);
+            break;
+        case FILEIO_OP_STAT: {
+            struct stat info;
+            result = stat(request->path, &info);
+            if (result == 0 && request->info) {
+                fileio_fill_stat(request->info, &info);
+            }
+            break;
+        }
+        case FILEIO_OP_READ:
+#ifdef _WIN32
+            if (_lseeki64(request->fd, request->offset, SEEK_SET) >= 0) {
+                result = _read(request->fd, request->buffer, FILEIO_IO_COUNT(request->length));
+            }
+#else
+            result = pread(request->fd, request->buffer, FILEIO_IO_COUNT(request->length), (off_t)request->offset);
+#endif
+            break;
+        case FILEIO_OP_WRITE:
+#ifdef _WIN32
+            if (_lseeki64(request->fd, request->offset, SEEK_SET) >= 0) {
+                result = _write(request->fd, request->buffer, FILEIO_IO_COUNT(request->length));
+            }
+#else
+            result = pwrite(request->fd, request->buffer, FILEIO_IO_COUNT(request->length), (off_t)request->offset);
+#endif
+            break;
+        case FILEIO_OP_UNLINK:
+            result = unlink(request->path);
+            break;
+        case FILEIO_OP_MKDIR:
+#ifdef _WIN32
+            result = _mkdir(request->path);
+#else
+            result = mkdir(request->path, (mode_t)request->mode);
+#endif
+            break;
+        case FILEIO_OP_RMDIR:
+            result = rmdir(request->path);
+            break;
+        default:
+            errno = EINVAL;
+            break;
+    }
+    return result < 0 ? -(long long)errno : result;
+} // end of func
+
+static void fileio_worker(void* arg) {
+    fileio_chunk* chunk = (fileio_chunk*)arg;
+    for (size_t i = 0; i < chunk->count; ++i) {
+        chunk->items[i]->result = fileio_execute(chunk->items[i]);
+    }
+
+    cfileio* io = chunk->io;
+#ifdef FSCL_FILEIO_THREADED
+    pthread_mutex_lock(&io->lock);
+#endif
+    chunk->next = io->completed;
+    io->completed = chunk;
+#ifdef FSCL_FILEIO_THREADED
+    pthread_cond_signal(&io->done);
+    pthread_mutex_unlock(&io->lock);
+#endif
+} // end of func
+
+// Hand a chunk to the workers, or run it here when no worker can take it
+// so a chunk once filled is never lost
+static void fileio_dispatch(cfileio* io, fileio_chunk* chunk) {
+    if (!io->workers) {
+        io->workers = fscl_workers_create(io->threads);
+    }
+    io->outstanding++;
+    if (!io->workers || fscl_workers_submit(io->workers, fileio_worker, chunk) != 0) {
+        fileio_worker(chunk);
+    }
+} // end of func
+
+static void fileio_complete(cfileio* io, cfileio_request* request) {
+    if (request->result < 0) {
+        io->failures++;
+    }
+    if (request->callback) {
+        request->callback(request, request->user);
+    }
+} // end of func
+
+// Run callbacks for every chunk the workers finished so far
+static int fileio_drain(cfileio* io, int block) {
+#ifdef FSCL_FILEIO_THREADED
+    pthread_mutex_lock(&io->lock);
+    while (block && !io->completed) {
+        pthread_cond_wait(&io->done, &io->lock);
+    }
+#else
+    (void)block;
+#endif
+    fileio_chunk* chunk = io->completed;
+    io->completed = NULL;
+#ifdef FSCL_FILEIO_THREADED
+    pthread_mutex_unlock(&io->lock);
+#endif
+
+    int drained = 0;
+    while (chunk) {
+        fileio_chunk* next = chunk->next;
+        io->outstanding--;
+        for (size_t i = 0; i < chunk->count; ++i) {
+            fileio_complete(io, chunk->items[i]);
+        }
+        free(chunk);
+        chunk = next;
+        drained = 1;
+    }
+    return drained;
+} // end of func
+
+// =================================================================
+// io_uring engine
+// =================================================================
+
+#ifdef FSCL_FILEIO_URING
+static int fileio_ring_setup(fileio_ring* ring, unsigned depth) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+
+    int fd = (int)syscall(__NR_io_uring_setup, depth, &params);
+    if (fd < 0) {
+        return -1;
+    }
+    ring->fd = fd;
+
+    ring->sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_len > ring->sq_len) {
+            ring->sq_len = ring->cq_len;
+        }
+        ring->cq_len = ring->sq_len;
+    }
+
+    ring->sq_ptr = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED) {
+        ring->sq_ptr = NULL;
+        return -1;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ring->cq_ptr = mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ptr == MAP_FAILED) {
+            ring->cq_ptr = NULL;
+            return -1;
+        }
+    }
+    ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        return -1;
+    }
+
+    char* sq = (char*)ring->sq_ptr;
+    char* cq = (char*)ring->cq_ptr;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    // Never keep more in flight than the completion ring can hold
+    ring->depth = params.sq_entries;
+    ring->slots = (fileio_slot*)malloc(ring->depth * sizeof(fileio_slot));
+    ring->free_slots = (unsigned*)malloc(ring->depth * sizeof(unsigned));
+    if (!ring->slots || !ring->free_slots) {
+        return -1;
+    }
+    for (unsigned i = 0; i < ring->depth; ++i) {
+        ring->free_slots[i] = ring->depth - 1 - i;
+    }
+    ring->free_count = ring->depth;
+
+    // Ask the kernel which opcodes it implements, older kernels lack some
+    static const unsigned char opcodes[FILEIO_OP_COUNT] = {
+        IORING_OP_OPENAT, IORING_OP_CLOSE, IORING_OP_STATX, IORING_OP_READ,
+        IORING_OP_WRITE, IORING_OP_UNLINKAT, IORING_OP_MKDIRAT, IORING_OP_UNLINKAT
+    };
+    size_t probe_size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*)calloc(1, probe_size);
+    if (!probe) {
+        return -1;
+    }
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) == 0) {
+        for (int op = 0; op < FILEIO_OP_COUNT; ++op) {
+            unsigned code = opcodes[op];
+            ring->supported[op] = code < probe->ops_len && (probe->ops[code].flags & IO_URING_OP_SUPPORTED);
+        }
+    }
+    free(probe);
+    return 0;
+} // end of func
+
+static void fileio_ring_teardown(fileio_ring* ring) {
+    if (ring->sqes) {
+        munmap(ring->sqes, ring->sqes_len);
+    }
+    if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr) {
+        munmap(ring->cq_ptr, ring->cq_len);
+    }
+    if (ring->sq_ptr) {
+        munmap(ring->sq_ptr, ring->sq_len);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    free(ring->slots);
+    free(ring->free_slots);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+} // end of func
+
+static void fileio_ring_prepare(fileio_ring* ring, struct io_uring_sqe* sqe, unsigned slot_index) {
+    fileio_slot* slot = &ring->slots[slot_index];
+    cfileio_request* request = slot->request;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = slot_index;
+    switch (request->op) {
+        case FILEIO_OP_OPEN:
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long)(uintptr_t)request->path;
+            sqe->len = request->mode;
+            sqe->open_flags = (unsigned)(request->flags | O_CLOEXEC);
+            break;
+        case FILEIO_OP_CLOSE:
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = request->fd;
+            break;
+        case FILEIO_OP_STAT:
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long)(uintptr_t)request->path;
+            sqe->len = STATX_BASIC_STATS;
+            sqe->off = (unsigned long long)(uintptr_t)&slot->info;
+            break;
+        case FILEIO_OP_READ:
+        case FILEIO_OP_WRITE:
+            sqe->opcode = request->op == FILEIO_OP_READ ? IORING_OP_READ : IORING_OP_WRITE;
+            sqe->fd = request->fd;
+            sqe->addr = (unsigned long long)(uintptr_t)request->buffer;
+            sqe->len = FILEIO_IO_COUNT(request->length);
+            sqe->off = (unsigned long long)request->offset;
+            break;
+        case FILEIO_OP_UNLINK:
+        case FILEIO_OP_RMDIR:
+            sqe->opcode = IORING_OP_UNLINKAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long)(uintptr_t)request->path;
+            sqe->unlink_flags = request->op == FILEIO_OP_RMDIR ? AT_REMOVEDIR : 0;
+            break;
+        case FILEIO_OP_MKDIR:
+            sqe->opcode = IORING_OP_MKDIRAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (unsigned long long)(uintptr_t)request->path;
+            sqe->len = request->mode;
+            break;
+    }
+} // end of func
+
+// Move pending requests into free submission slots
+static void fileio_ring_fill(cfileio* io) {
+    fileio_ring* ring = &io->ring;
+    unsigned tail = *ring->sq_tail;
+    unsigned mask = *ring->sq_mask;
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+
+    while (io->pending_count > 0 && ring->free_count > 0 && tail - head < ring->depth) {
+        cfileio_request* request = io->pending[io->pending_head];
+        io->pending_head = (io->pending_head + 1) % io->pending_capacity;
+        io->pending_count--;
+
+        unsigned slot = ring->free_slots[--ring->free_count];
+        ring->slots[slot].request = request;
+        unsigned index = tail & mask;
+        fileio_ring_prepare(ring, &ring->sqes[index], slot);
+        ring->sq_array[index] = index;
+        tail++;
+        ring->inflight++;
+        ring->unsubmitted++;
+    }
+    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+} // end of func
+
+static void fileio_ring_reap(cfileio* io) {
+    fileio_ring* ring = &io->ring;
+    unsigned head = *ring->cq_head;
+    unsigned mask = *ring->cq_mask;
+
+    while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & mask];
+        unsigned slot_index = (unsigned)cqe->user_data;
+        fileio_slot* slot = &ring->slots[slot_index];
+        cfileio_request* request = slot->request;
+
+        request->result = cqe->res;
+        if (request->op == FILEIO_OP_STAT && cqe->res == 0 && request->info) {
+            request->info->size = slot->info.stx_size;
+            request->info->inode = slot->info.stx_ino;
+            request->info->mode = slot->info.stx_mode;
+            request->info->mtime_sec = slot->info.stx_mtime.tv_sec;
+            request->info->mtime_nsec = (long)slot->info.stx_mtime.tv_nsec;
+        }
+        ring->free_slots[ring->free_count++] = slot_index;
+        ring->inflight--;
+        __atomic_store_n(ring->cq_head, ++head, __ATOMIC_RELEASE);
+
+        fileio_complete(io, request);
+    }
+} // end of func
+
+static int fileio_ring_enter(cfileio* io) {
+    fileio_ring* ring = &io->ring;
+    for (;;) {
+        long submitted = syscall(__NR_io_uring_enter, ring->fd, ring->unsubmitted, 1,
+                                 IORING_ENTER_GETEVENTS, NULL, 0);
+        if (submitted >= 0) {
+            ring->unsubmitted -= (unsigned)submitted;
+            return 0;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return -1;
+        }
+        fileio_ring_reap(io); // make room in the completion ring and retry
+    }
+} // end of func
+
+// Start what fits on the ring without waiting for completions. A busy
+// ring keeps the rest for fscl_fileio_wait, which also reports errors.
+static void fileio_ring_push(cfileio* io) {
+    fileio_ring* ring = &io->ring;
+    fileio_ring_fill(io);
+    if (ring->unsubmitted > 0) {
+        long submitted = syscall(__NR_io_uring_enter, ring->fd, ring->unsubmitted, 0, 0, NULL, 0);
+        if (submitted > 0) {
+            ring->unsubmitted -= (unsigned)submitted;
+        }
+    }
+} // end of func
+#endif
+
+// =================================================================
+// Public interface
+// =================================================================
+
+// Function to create a batch context
+cfileio* fscl_fileio_create(unsigned int depth, int threads) {
+    cfileio* io = (cfileio*)calloc(1, sizeof(cfileio));
+    if (!io) {
+        return NULL;
+    }
+    io->backend = FILEIO_BACKEND_THREADS;
+    io->threads = threads;
+#ifdef FSCL_FILEIO_THREADED
+    pthread_mutex_init(&io->lock, NULL);
+    pthread_cond_init(&io->done, NULL);
+#endif
+#ifdef FSCL_FILEIO_URING
+    if (fileio_ring_setup(&io->ring, depth ? depth : FILEIO_DEFAULT_DEPTH) == 0) {
+        io->backend = FILEIO_BACKEND_URING;
+    } else {
+        fileio_ring_teardown(&io->ring);
+    }
+#else
+    (void)depth;
+#endif
+    return io;
+} // end of func
+
+// Function to report the engine a context runs on
+cfileio_backend fscl_fileio_backend(const cfileio* io) {
+    return io ? io->backend : FILEIO_BACKEND_THREADS;
+} // end of func
+
+#ifdef FSCL_FILEIO_URING
+// Append a request to the queue waiting for ring space
+static int fileio_queue(cfileio* io, cfileio_request* request) {
+    if (io->pending_count == io->pending_capacity) {
+        size_t capacity = io->pending_capacity ? io->pending_capacity * 2 : 256;
+        cfileio_request** pending = (cfileio_request**)malloc(capacity * sizeof(*pending));
+        if (!pending) {
+            return -1;
+        }
+        for (size_t i = 0; i < io->pending_count; ++i) {
+            pending[i] = io->pending[(io->pending_head + i) % io->pending_capacity];
+        }
+        free(io->pending);
+        io->pending = pending;
+        io->pending_capacity = capacity;
+        io->pending_head = 0;
+    }
+    io->pending[(io->pending_head + io->pending_count) % io->pending_capacity] = request;
+    io->pending_count++;
+    return 0;
+} // end of func
+#endif
+
+// Function to start operations
+long fscl_fileio_submit(cfileio* io, cfileio_request* requests, size_t count) {
+    if (!io || (!requests && count)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Spread small batches across the workers, cap chunk size for large ones
+    int workers = io->threads > 0 ? io->threads : fscl_workers_cpu_count();
+    size_t chunk_size = count / ((size_t)workers * 4);
+    if (chunk_size < 1) {
+        chunk_size = 1;
+    } else if (chunk_size > FILEIO_CHUNK) {
+        chunk_size = FILEIO_CHUNK;
+    }
+
+    // Requests before the first one that could not be queued are accepted
+    fileio_chunk* chunk = NULL;
+    size_t accepted = 0;
+    int error = 0;
+    for (; accepted < count; ++accepted) {
+        cfileio_request* request = &requests[accepted];
+        request->result = 0;
+#ifdef FSCL_FILEIO_URING
+        if (io->backend == FILEIO_BACKEND_URING && (unsigned)request->op < FILEIO_OP_COUNT &&
+            io->ring.supported[request->op]) {
+            if (fileio_queue(io, request) != 0) {
+                error = ENOMEM;
+                break;
+            }
+            continue;
+        }
+#endif
+        if (!chunk) {
+            chunk = (fileio_chunk*)malloc(sizeof(fileio_chunk));
+            if (!chunk) {
+                error = ENOMEM;
+                break;
+            }
+            chunk->io = io;
+            chunk->count = 0;
+        }
+        chunk->items[chunk->count++] = request;
+        if (chunk->count == chunk_size) {
+            fileio_dispatch(io, chunk);
+            chunk = NULL;
+        }
+    }
+    if (chunk) {
+        fileio_dispatch(io, chunk);
+    }
+#ifdef FSCL_FILEIO_URING
+    if (io->backend == FILEIO_BACKEND_URING && io->pending_count > 0) {
+        fileio_ring_push(io);
+    }
+#endif
+    if (error) {
+        errno = error;
+    }
+    return (long)accepted;
+} // end of func
+
+// Function to drive queued operations to completion
+long fscl_fileio_wait(cfileio* io) {
+    if (!io) {
+        return -1;
+    }
+    for (;;) {
+        fileio_drain(io, 0);
+#ifdef FSCL_FILEIO_URING
+        if (io->backend == FILEIO_BACKEND_URING && (io->pending_count > 0 || io->ring.inflight > 0)) {
+            fileio_ring_fill(io);
+            if (fileio_ring_enter(io) != 0) {
+                return -1;
+            }
+            fileio_ring_reap(io);
+            continue;
+        }
+#endif
+        if (io->outstanding == 0) {
+            break;
+        }
+        fileio_drain(io, 1);
+    }
+    long failures = io->failures;
+    io->failures = 0;
+    return failures;
+} // end of func
+
+// Function to free a batch context
+void fscl_fileio_erase(cfileio* io) {
+    if (!io) {
+        return;
+    }
+    fscl_fileio_wait(io);
+    fscl_workers_erase(io->workers);
+#ifdef FSCL_FILEIO_URING
+    if (io->backend == FILEIO_BACKEND_URING) {
+        fileio_ring_teardown(&io->ring);
+    }
+#endif
+#ifdef FSCL_FILEIO_THREADED
+    pthread_cond_destroy(&io->done);
+    pthread_mutex_destroy(&io->lock);
+#endif
+    free(io->pending);
+    free(io);
+} // end of func
@@ -0,0 +1,342 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/filemap.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define open _open
+#define read _read
+#define write _write
+#define close _close
+#define lseek _lseeki64
+#else
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+// Size of the chunks used when the file size is unknown (pipes, procfs)
+#define FILEMAP_READ_CHUNK (64 * 1024)
+
+// Largest single read or write request, keeps counts inside an int
+#define FILEMAP_IO_LIMIT ((size_t)1 << 30)
+#define FILEMAP_IO_COUNT(n) ((unsigned)((n) < FILEMAP_IO_LIMIT ? (n) : FILEMAP_IO_LIMIT))
+
+static size_t filemap_page_size(void) {
+#ifdef _WIN32
+    return 4096;
+#else
+    static size_t page = 0;
+    if (page == 0) {
+        long value = sysconf(_SC_PAGESIZE);
+        page = value > 0 ? (size_t)value : 4096;
+    }
+    return page;
+#endif
+} // end of func
+
+// Release whatever currently backs the window
+static void filemap_release(cfilemap* map) {
+#ifndef _WIN32
+    if (map->mapped && map->base) {
+        munmap(map->base, map->base_length);
+    } else
+#endif
+    {
+        free(map->base);
+    }
+    map->base = NULL;
+    map->base_length = 0;
+    map->data = NULL;
+    map->length = 0;
+    map->mapped = 0;
+} // end of func
+
+// Write the fallback buffer of a read-write view back to the file
+static int filemap_write_back(cfilemap* map) {
+    if (map->mapped || map->mode != FILEMAP_READ_WRITE || map->length == 0) {
+        return 0;
+    }
+    if (lseek(map->fd, (long long)map->offset, SEEK_SET) < 0) {
+        return -1;
+    }
+    size_t done = 0;
+    while (done < map->length) {
+        long n = (long)write(map->fd, map->data + done, FILEMAP_IO_COUNT(map->length - done));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    return 0;
+} // end of func
+
+// Buffered fallback: one read loop straight into the view buffer
+static int filemap_load(cfilemap* map, size_t offset, size_t length, int size_known) {
+    size_t capacity = size_known ? length : FILEMAP_READ_CHUNK;
+    char* buffer = (char*)malloc(capacity + 1);
+    if (!buffer) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (size_known && lseek(map->fd, (long long)offset, SEEK_SET) < 0) {
+        free(buffer);
+        return -1;
+    }
+
+    size_t used = 0;
+    for (;;) {
+        if (used == capacity) {
+            if (size_known) {
+                break;
+            }
+            char* grown = (char*)realloc(buffer, capacity * 2 + 1);
+            if (!grown) {
+                free(buffer);
+                errno = ENOMEM;
+                return -1;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+        long n = (long)read(map->fd, buffer + used, FILEMAP_IO_COUNT(capacity - used));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            free(buffer);
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        used += (size_t)n;
+    }
+    buffer[used] = '\0';
+
+    map->base = buffer;
+    map->base_length = capacity + 1;
+    map->data = buffer;
+    map->offset = offset;
+    map->length = used;
+    map->mapped = 0;
+    if (!size_known) {
+        map->size = used;
+    }
+    return 0;
+} // end of func
+
+// Map [offset, offset + length) of the file, falling back to a buffered read
+static int filemap_place(cfilemap* map, size_t offset, size_t length) {
+    if (length == 0) {
+        map->offset = offset;
+        return 0;
+    }
+#ifndef _WIN32
+    size_t page = filemap_page_size();
+    size_t aligned = offset & ~(page - 1);
+    size_t span = length + (offset - aligned);
+    int prot = map->mode == FILEMAP_READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = map->mode == FILEMAP_READ_WRITE ? MAP_SHARED : MAP_PRIVATE;
+
+    void* base = mmap(NULL, span, prot, flags, map->fd, (off_t)aligned);
+    if (base != MAP_FAILED) {
+        map->base = base;
+        map->base_length = span;
+        map->data = (char*)base + (offset - aligned);
+        map->offset = offset;
+        map->length = length;
+        map->mapped = 1;
+        return 0;
+    }
+#endif
+    return filemap_load(map, offset, length, 1);
+} // end of func
+
+// Function to open a memory view of a file
+int fscl_filemap_open(cfilemap* map, const char* path, cfilemap_mode mode, size_t window) {
+    if (!map || !path) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    map->mode = mode;
+
+    // Keep windows page aligned so remapping never splits a page
+    size_t page = filemap_page_size();
+    if (window != 0) {
+        window = (window + page - 1) & ~(page - 1);
+    }
+    map->window = window;
+
+    int flags = (mode == FILEMAP_READ_WRITE ? O_RDWR : O_RDONLY) | O_BINARY | O_CLOEXEC;
+    map->fd = open(path, flags);
+    if (map->fd < 0) {
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(map->fd, &info) != 0) {
+        close(map->fd);
+        map->fd = -1;
+        return -1;
+    }
+
+    // Files reporting no size may still produce data when read (procfs, pipes)
+    if (!S_ISREG(info.st_mode) || info.st_size == 0) {
+        if (filemap_load(map, 0, 0, 0) != 0) {
+            close(map->fd);
+            map->fd = -1;
+            return -1;
+        }
+        return 0;
+    }
+
+    map->size = (size_t)info.st_size;
+    size_t length = (window != 0 && window < map->size) ? window : map->size;
+    if (filemap_place(map, 0, length) != 0) {
+        close(map->fd);
+        map->fd = -1;
+        return -1;
+    }
+    return 0;
+} // end of func
+
+// Function to pass an access pattern hint to the kernel
+int fscl_filemap_advise(cfilemap* map, cfilemap_advice advice) {
+    if (!map || map->fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (!map->mapped || map->length == 0) {
+        return 0; // nothing left to read ahead for a buffered view
+    }
+#ifdef _WIN32
+    (void)advice;
+    return 0;
+#else
+    int hint;
+    switch (advice) {
+        case FILEMAP_ADVICE_SEQUENTIAL:
+            hint = MADV_SEQUENTIAL;
+            break;
+        case FILEMAP_ADVICE_RANDOM:
+            hint = MADV_RANDOM;
+            break;
+        case FILEMAP_ADVICE_WILLNEED:
+            hint = MADV_WILLNEED;
+            break;
+        case FILEMAP_ADVICE_HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+            hint = MADV_HUGEPAGE;
+            break;
+#else
+            errno = ENOTSUP;
+            return -1;
+#endif
+        default:
+            hint = MADV_NORMAL;
+            break;
+    }
+    return madvise(map->base, map->base_length, hint);
+#endif
+} // end of func
+
+// Function to move the window of a view to another region of the file
+int fscl_filemap_window(cfilemap* map, size_t offset, size_t length) {
+    if (!map || map->fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (offset > map->size) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (length == 0) {
+        length = map->window != 0 ? map->window : map->size;
+    }
+    if (length > map->size - offset) {
+        length = map->size - offset;
+    }
+
+    // Serve the request from the current mapping when it already covers it
+    if (map->mapped) {
+        size_t start = (size_t)(map->data - (char*)map->base);
+        size_t base_offset = map->offset - start;
+        if (offset >= base_offset && offset + length <= base_offset + map->base_length) {
+            map->data = (char*)map->base + (offset - base_offset);
+            map->offset = offset;
+            map->length = length;
+            return 0;
+        }
+    }
+
+    if (filemap_write_back(map) != 0) {
+        return -1;
+    }
+    filemap_release(map);
+    return filemap_place(map, offset, length);
+} // end of func
+
+// Function to flush changes made through a read-write view
+int fscl_filemap_sync(cfilemap* map) {
+    if (!map || map->fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (map->mode != FILEMAP_READ_WRITE) {
+        return 0;
+    }
+#ifndef _WIN32
+    if (map->mapped) {
+        return map->base ? msync(map->base, map->base_length, MS_SYNC) : 0;
+    }
+#endif
+    return filemap_write_back(map);
+} // end of func
+
+// Function to close a view
+void fscl_filemap_close(cfilemap* map) {
+    if (!map) {
+        return;
+    }
+    if (map->fd >= 0) {
+        filemap_write_back(map);
+    }
+    filemap_release(map);
+    if (map->fd >= 0) {
+        close(map->fd);
+    }
+    map->fd = -1;
+    map->size = 0;
+    map->offset = 0;
+} // end of func
@@ -0,0 +1,372 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/filepath.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#define PATH_SEPARATOR '\\'
+#define IS_PATH_SEPARATOR(c) ((c) == '\\' || (c) == '/')
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#define PATH_SEPARATOR '/'
+#define IS_PATH_SEPARATOR(c) ((c) == '/')
+#endif
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+#ifndef O_DIRECTORY
+#define O_DIRECTORY 0
+#endif
+
+static char* filepath_data(cfilepath* path) {
+    return path->heap ? path->heap : path->inline_path;
+} // end of func
+
+// Length of the root prefix that normalize and dirname never remove
+static size_t filepath_root(const char* text, size_t length) {
+    size_t root = 0;
+#ifdef _WIN32
+    if (length >= 2 && text[1] == ':' &&
+        ((text[0] >= 'A' && text[0] <= 'Z') || (text[0] >= 'a' && text[0] <= 'z'))) {
+        root = 2;
+    }
+#endif
+    if (root < length && IS_PATH_SEPARATOR(text[root])) {
+        ++root;
+    }
+    return root;
+} // end of func
+
+// Make room for a path of the given length
+static int filepath_reserve(cfilepath* path, size_t length) {
+    if (!path->heap && length < FSCL_FILEPATH_INLINE) {
+        return 0;
+    }
+    if (path->heap && length < path->capacity) {
+        return 0;
+    }
+    size_t capacity = path->heap ? path->capacity : FSCL_FILEPATH_INLINE;
+    while (capacity <= length) {
+        capacity *= 2;
+    }
+    char* heap = (char*)realloc(path->heap, capacity);
+    if (!heap) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (!path->heap) {
+        memcpy(heap, path->inline_path, path->length + 1);
+    }
+    path->heap = heap;
+    path->capacity = capacity;
+    return 0;
+} // end of func
+
+// Function to initialize an empty path builder
+void fscl_filepath_init(cfilepath* path) {
+    if (!path) {
+        return;
+    }
+    path->heap = NULL;
+    path->length = 0;
+    path->capacity = 0;
+    path->inline_path[0] = '\0';
+} // end of func
+
+// Function to replace the contents of a path builder
+int fscl_filepath_set(cfilepath* path, const char* text) {
+    if (!path || !text) {
+        errno = EINVAL;
+        return -1;
+    }
+    size_t length = strlen(text);
+    if (filepath_reserve(path, length) != 0) {
+        return -1;
+    }
+    memmove(filepath_data(path), text, length + 1);
+    path->length = length;
+    return 0;
+} // end of func
+
+// Function to append a component to a path
+int fscl_filepath_join(cfilepath* path, const char* component) {
+    if (!path || !component) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (filepath_root(component, strlen(component)) > 0) {
+        return fscl_filepath_set(path, component);
+    }
+    size_t length = strlen(component);
+    char* data = filepath_data(path);
+    int separator = path->length > 0 && !IS_PATH_SEPARATOR(data[path->length - 1]);
+    if (filepath_reserve(path, path->length + separator + length) != 0) {
+        return -1;
+    }
+    data = filepath_data(path);
+    if (separator) {
+        data[path->length++] = PATH_SEPARATOR;
+    }
+    memcpy(data + path->length, component, length + 1);
+    path->length += length;
+    return 0;
+} // end of func
+
+// Function to cut a path back to an earlier length
+void fscl_filepath_truncate(cfilepath* path, size_t length) {
+    if (path && length < path->length) {
+        path->length = length;
+        filepath_data(path)[length] = '\0';
+    }
+} // end of func
+
+// Function to normalize a path in place
+void fscl_filepath_normalize(cfilepath* path) {
+    if (!path) {
+        return;
+    }
+    char* data = filepath_data(path);
+    size_t length = path->length;
+    size_t base = filepath_root(data, length);
+    int absolute = base > 0 && IS_PATH_SEPARATOR(data[base - 1]);
+    if (absolute) {
+        data[base - 1] = PATH_SEPARATOR;
+    }
+
+    // The write cursor never passes the read cursor, so this works in place
+    size_t out = base;
+    size_t read = base;
+    size_t depth = 0; // components that a ".." may remove
+    while (read < length) {
+        while (read < length && IS_PATH_SEPARATOR(data[read])) {
+            ++read;
+        }
+        size_t start = read;
+        while (read < length && !IS_PATH_SEPARATOR(data[read])) {
+            ++read;
+        }
+        size_t size = read - start;
+        if (size == 0 || (size == 1 && data[start] == '.')) {
+            continue;
+        }
+        if (size == 2 && data[start] == '.' && data[start + 1] == '.') {
+            if (depth > 0) {
+                while (out > base && !IS_PATH_SEPARATOR(data[out - 1])) {
+                    --out;
+                }
+                if (out > base) {
+                    --out;
+                }
+                --depth;
+                continue;
+            }
+            if (absolute) {
+                continue; // nothing above the root
+            }
+        } else {
+            ++depth;
+        }
+        if (out > base) {
+            data[out++] = PATH_SEPARATOR;
+        }
+        memmove(data + out, data + start, size);
+        out += size;
+    }
+    if (out == 0) {
+        data[out++] = '.';
+    }
+    data[out] = '\0';
+    path->length = out;
+} // end of func
+
+// Function to reduce a path to its parent directory
+void fscl_filepath_dirname(cfilepath* path) {
+    if (!path) {
+        return;
+    }
+    char* data = filepath_data(path);
+    size_t root = filepath_root(data, path->length);
+    size_t end = path->length;
+    while (end > root && IS_PATH_SEPARATOR(data[end - 1])) {
+        --end;
+    }
+    while (end > root && !IS_PATH_SEPARATOR(data[end - 1])) {
+        --end;
+    }
+    while (end > root && IS_PATH_SEPARATOR(data[end - 1])) {
+        --end;
+    }
+    if (end == 0) {
+        data[end++] = '.';
+    }
+    data[end] = '\0';
+    path->length = end;
+} // end of func
+
+// Function to reduce a path to its final component
+void fscl_filepath_basename(cfilepath* path) {
+    if (!path) {
+        return;
+    }
+    char* data = filepath_data(path);
+    size_t root = filepath_root(data, path->length);
+    size_t end = path->length;
+    while (end > root && IS_PATH_SEPARATOR(data[end - 1])) {
+        --end;
+    }
+    if (end == root) {
+        data[root] = '\0'; // the root is its own base name
+        path->length = root;
+        return;
+    }
+    size_t start = end;
+    while (start > root && !IS_PATH_SEPARATOR(data[start - 1])) {
+        --start;
+    }
+    memmove(data, data + start, end - start);
+    data[end - start] = '\0';
+    path->length = end - start;
+} // end of func
+
+// Function to get the text of a path builder
+const char* fscl_filepath_cstr(const cfilepath* path) {
+    if (!path) {
+        return "";
+    }
+    return path->heap ? path->heap : path->inline_path;
+} // end of func
+
+// Function to release a path builder
+void fscl_filepath_erase(cfilepath* path) {
+    if (path) {
+        free(path->heap);
+        fscl_filepath_init(path);
+    }
+} // end of func
+
+#ifndef _WIN32
+static int filepath_dirfd(int dirfd) {
+    return dirfd == FSCL_FILEPATH_CWD ? AT_FDCWD : dirfd;
+} // end of func
+#else
+// Only the working directory can be used as a handle here
+static int filepath_check_dirfd(int dirfd) {
+    if (dirfd != FSCL_FILEPATH_CWD) {
+        errno = ENOSYS;
+        return -1;
+    }
+    return 0;
+} // end of func
+#endif
+
+// Function to open a directory handle
+int fscl_filepath_open_dir(int dirfd, const char* name) {
+    if (!name) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef _WIN32
+    (void)dirfd;
+    errno = ENOSYS;
+    return -1;
+#else
+    return openat(filepath_dirfd(dirfd), name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+} // end of func
+
+// Function to open a file relative to a directory handle
+int fscl_filepath_openat(int dirfd, const char* name, int flags, int mode) {
+    if (!name) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef _WIN32
+    if (filepath_check_dirfd(dirfd) != 0) {
+        return -1;
+    }
+    return _open(name, flags | _O_BINARY, mode);
+#else
+    return openat(filepath_dirfd(dirfd), name, flags | O_CLOEXEC, (mode_t)mode);
+#endif
+} // end of func
+
+// Function to create a directory relative to a directory handle
+int fscl_filepath_mkdirat(int dirfd, const char* name) {
+    if (!name) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef _WIN32
+    return filepath_check_dirfd(dirfd) != 0 ? -1 : _mkdir(name);
+#else
+    return mkdirat(filepath_dirfd(dirfd), name, 0777);
+#endif
+} // end of func
+
+// Function to remove an entry relative to a directory handle
+int fscl_filepath_unlinkat(int dirfd, const char* name, int is_directory) {
+    if (!name) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef _WIN32
+    if (filepath_check_dirfd(dirfd) != 0) {
+        return -1;
+    }
+    return is_directory ? _rmdir(name) : _unlink(name);
+#else
+    return unlinkat(filepath_dirfd(dirfd), name, is_directory ? AT_REMOVEDIR : 0);
+#endif
+} // end of func
+
+// Function to check an entry relative to a directory handle
+int fscl_filepath_existsat(int dirfd, const char* name) {
+    if (!name) {
+        return 0;
+    }
+#ifdef _WIN32
+    struct _stat info;
+    if (filepath_check_dirfd(dirfd) != 0 || _stat(name, &info) != 0) {
+        return 0;
+    }
+    return (info.st_mode & _S_IFDIR) ? 2 : 1;
+#else
+    struct stat info;
+    if (fstatat(filepath_dirfd(dirfd), name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+        return 0;
+    }
+    return S_ISDIR(info.st_mode) ? 2 : 1;
+#endif
+} // end of func
+
+// Function to close a directory handle
+void fscl_filepath_close_dir(int dirfd) {
+#ifdef _WIN32
+    (void)dirfd;
+#else
+    if (dirfd >= 0) {
+        close(dirfd);
+    }
+#endif
+} // end of func
@@ -10,28 +10,54 @@ Description:
     feel free to contact Michael at michaelbrockus@gmail.com.
 ==============================================================================
 */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include "fossil/xutil/filesystem.h"
+#include "fossil/xutil/filepath.h"
+#include "fossil/xutil/statcache.h"
+#include "workers.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 
 #ifdef _WIN32
+#include <windows.h>
 #include <direct.h>
 #include <io.h>
-#define PATH_SEPARATOR '\\'
+#define IS_PATH_SEPARATOR(c) ((c) == '\\' || (c) == '/')
+#define filesys_mkdir(path) _mkdir(path)
 #else
 #include <sys/types.h>
 #include <dirent.h>
 #include <unistd.h>
-#define PATH_SEPARATOR '/'
+#define IS_PATH_SEPARATOR(c) ((c) == '/')
+#define filesys_mkdir(path) mkdir(path, 0777)
+#endif
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
 #endif
+#endif
+
+// Size of the bounce buffer for the read/write copy loop
+#define FILESYS_COPY_BUFFER (1024 * 1024)
 
 // Function to create a new directory
 cfilesystem fscl_filesys_create(const char* path) {
     cfilesystem new_directory;
-    new_directory.path = (char*)malloc(strlen(path) + 1);
-    strcpy(new_directory.path, path);
+    size_t length = strlen(path);
+    new_directory.path = (char*)malloc(length + 1);
+    if (new_directory.path) {
+        memcpy(new_directory.path, path, length + 1);
+    }
     return new_directory;
 } // end of func
 
@@ -52,12 +78,16 @@ void fscl_filesys_list_files(const cfilesystem* directory) {
         // Windows-specific listing logic
         intptr_t handle;
         struct _finddata_t file_info;
-        if ((handle = _findfirst(strcat(directory->path, "\\*"), &file_info)) != -1L) {
+        cfilepath pattern;
+        fscl_filepath_init(&pattern);
+        if (fscl_filepath_set(&pattern, directory->path) == 0 && fscl_filepath_join(&pattern, "*") == 0 &&
+            (handle = _findfirst(fscl_filepath_cstr(&pattern), &file_info)) != -1L) {
             do {
                 printf("%s\n", file_info.name);
             } while (_findnext(handle, &file_info) == 0);
             _findclose(handle);
         }
+        fscl_filepath_erase(&pattern);
 #else
         // POSIX-specific listing logic
         DIR* dir;
@@ -72,27 +102,74 @@ void fscl_filesys_list_files(const cfilesystem* directory) {
     }
 } // end of func
 
+// Drop a changed path, and its ancestors when tree is set, from the
+// installed metadata cache. Watch events arrive asynchronously and a
+// cache without watches never hears of the change, so every mutating
+// call invalidates synchronously before it returns.
+static void filesys_invalidate(const char* path, int tree) {
+    cstatcache* cache = fscl_statcache_installed();
+    if (!cache || !path || !*path) {
+        return;
+    }
+    fscl_statcache_invalidate(cache, path);
+
+    size_t length = strlen(path);
+    char small[256];
+    char* prefix = length < sizeof(small) ? small : (char*)malloc(length + 1);
+    if (!prefix) {
+        fscl_statcache_clear(cache);
+        return;
+    }
+    memcpy(prefix, path, length + 1);
+    int parents = 0;
+    for (;;) {
+        while (length > 0 && IS_PATH_SEPARATOR(prefix[length - 1])) {
+            --length;
+        }
+        while (length > 0 && !IS_PATH_SEPARATOR(prefix[length - 1])) {
+            --length;
+        }
+        if (length == 0) {
+            if (parents == 0) {
+                fscl_statcache_invalidate(cache, ".");
+            }
+            break;
+        }
+        prefix[length] = '\0';
+        fscl_statcache_invalidate(cache, prefix);
+        ++parents;
+        if (!tree) {
+            break;
+        }
+    }
+    if (prefix != small) {
+        free(prefix);
+    }
+} // end of func
+
 // Function to create a subdirectory
 void fscl_filesys_create_subdirectory(const cfilesystem* parent, const char* subfscl_filesys_name) {
     if (parent) {
         printf("Creating subdirectory %s in %s\n", subfscl_filesys_name, parent->path);
 
-#ifdef _WIN32
-        // Windows-specific subdirectory creation logic
-        _mkdir(strcat(parent->path, "\\"));
-        _mkdir(strcat(parent->path, subfscl_filesys_name));
-#else
-        // POSIX-specific subdirectory creation logic
-        char subfscl_filesys_path[256];
-        snprintf(subfscl_filesys_path, sizeof(subfscl_filesys_path), "%s/%s", parent->path, subfscl_filesys_name);
-        mkdir(subfscl_filesys_path, 0777);
-#endif
+        cfilepath subfscl_filesys_path;
+        fscl_filepath_init(&subfscl_filesys_path);
+        if (fscl_filepath_set(&subfscl_filesys_path, parent->path) == 0 &&
+            fscl_filepath_join(&subfscl_filesys_path, subfscl_filesys_name) == 0) {
+            filesys_mkdir(fscl_filepath_cstr(&subfscl_filesys_path));
+            filesys_invalidate(fscl_filepath_cstr(&subfscl_filesys_path), 0);
+        }
+        fscl_filepath_erase(&subfscl_filesys_path);
     }
 } // end of func
 
 // Function to check if a directory exists
 int fscl_filesys_exists(const cfilesystem* directory) {
     if (directory) {
+        cstatcache* cache = fscl_statcache_installed();
+        if (cache) {
+            return fscl_statcache_is_directory(cache, directory->path);
+        }
 #ifdef _WIN32
         struct _stat info;
         return (_stat(directory->path, &info) == 0 && S_ISDIR(info.st_mode));
@@ -107,18 +184,598 @@ int fscl_filesys_exists(const cfilesystem* directory) {
 // Function to remove a file within a directory
 void fscl_filesys_remove_file(const cfilesystem* directory, const char* filename) {
     if (directory) {
-        char filepath[256];
-        snprintf(filepath, sizeof(filepath), "%s%c%s", directory->path, PATH_SEPARATOR, filename);
-        printf("Removing file: %s\n", filepath);
-        remove(filepath);
+        cfilepath filepath;
+        fscl_filepath_init(&filepath);
+        if (fscl_filepath_set(&filepath, directory->path) == 0 && fscl_filepath_join(&filepath, filename) == 0) {
+            printf("Removing file: %s\n", fscl_filepath_cstr(&filepath));
+            remove(fscl_filepath_cstr(&filepath));
+            filesys_invalidate(fscl_filepath_cstr(&filepath), 0);
+        }
+        fscl_filepath_erase(&filepath);
     }
 } // end of func
 
 // Function to navigate to a different directory
 void fscl_filesys_change_directory(cfilesystem* directory, const char* new_path) {
-    if (directory) {
-        fscl_filesys_erase(directory);
-        directory->path = (char*)malloc(strlen(new_path) + 1);
-        strcpy(directory->path, new_path);
+    if (directory && new_path) {
+        // A suffix of the current path already fits where it is
+        size_t length = strlen(new_path);
+        if (directory->path && new_path >= directory->path &&
+            new_path <= directory->path + strlen(directory->path)) {
+            memmove(directory->path, new_path, length + 1);
+            return;
+        }
+        char* path = (char*)realloc(directory->path, length + 1);
+        if (!path) {
+            return;
+        }
+        directory->path = path;
+        memcpy(directory->path, new_path, length + 1);
+    }
+} // end of func
+
+static int filesys_create_directories(const char* original) {
+
+    // Optimistic first attempt: one mkdir for a new leaf, plus a stat
+    // when the path already exists to confirm it is a directory
+    if (filesys_mkdir(original) == 0) {
+        return 0;
+    }
+    if (errno == EEXIST) {
+        struct stat info;
+        if (stat(original, &info) == 0 && S_ISDIR(info.st_mode)) {
+            return 0;
+        }
+        errno = EEXIST;
+        return -1;
+    }
+    if (errno != ENOENT) {
+        return -1;
+    }
+
+    size_t length = strlen(original);
+    while (length > 1 && IS_PATH_SEPARATOR(original[length - 1])) {
+        --length;
+    }
+    char small[256];
+    char* path = length < sizeof(small) ? small : (char*)malloc(length + 1);
+    if (!path) {
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(path, original, length);
+    path[length] = '\0';
+
+    // Walk up by cutting components until mkdir stops reporting ENOENT
+    int result = -1;
+    size_t cut = length;
+    for (;;) {
+        size_t start = cut;
+        while (start > 0 && !IS_PATH_SEPARATOR(path[start - 1])) {
+            --start;
+        }
+        size_t separator = start;
+        while (separator > 0 && IS_PATH_SEPARATOR(path[separator - 1])) {
+            --separator;
+        }
+        if (separator == 0) {
+            goto done; // no existing ancestor left to build on
+        }
+        path[separator] = '\0';
+        if (filesys_mkdir(path) == 0 || errno == EEXIST) {
+            break;
+        }
+        if (errno != ENOENT) {
+            goto done;
+        }
+        cut = separator;
+    }
+
+    // Walk back down creating each component that was cut off
+    for (size_t end = strlen(path); end < length; end = strlen(path)) {
+        path[end] = original[end];
+        if (filesys_mkdir(path) != 0 && errno != EEXIST) {
+            goto done;
+        }
+    }
+    result = 0;
+
+done:
+    if (path != small) {
+        free(path);
+    }
+    return result;
+} // end of func
+
+// Function to create a directory along with any missing parents
+int fscl_filesys_create_directories(const cfilesystem* directory) {
+    if (!directory || !directory->path || !*directory->path) {
+        errno = EINVAL;
+        return -1;
+    }
+    int result = filesys_create_directories(directory->path);
+    int error = errno;
+    filesys_invalidate(directory->path, 1); // any missing ancestor may exist now
+    errno = error;
+    return result;
+} // end of func
+
+#ifndef _WIN32
+// Shared state of one recursive removal
+typedef struct {
+    fscl_workers* workers;
+    int limit;   // queued directories before subtrees are removed inline
+    int queued;
+    int error;   // first errno seen
+} filesys_removal;
+
+// A directory being emptied, removed once its listing and children are done
+typedef struct filesys_remove_node {
+    struct filesys_remove_node* parent;
+    filesys_removal* removal;
+    int fd;
+    int pending; // own listing plus unfinished child directories
+    char name[];
+} filesys_remove_node;
+
+static void filesys_remove_error(filesys_removal* removal, int error) {
+    int expected = 0;
+    if (error != ENOENT) {
+        __atomic_compare_exchange_n(&removal->error, &expected, error, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+} // end of func
+
+static filesys_remove_node* filesys_remove_node_create(filesys_remove_node* parent, filesys_removal* removal, const char* name) {
+    size_t length = strlen(name);
+    filesys_remove_node* node = (filesys_remove_node*)malloc(sizeof(filesys_remove_node) + length + 1);
+    if (!node) {
+        filesys_remove_error(removal, ENOMEM);
+        return NULL;
+    }
+    node->parent = parent;
+    node->removal = removal;
+    node->fd = -1;
+    node->pending = 1;
+    memcpy(node->name, name, length + 1);
+    return node;
+} // end of func
+
+// Drop one reference; the last one removes the directory and walks upward
+static void filesys_remove_release(filesys_remove_node* node) {
+    while (node && __atomic_sub_fetch(&node->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        filesys_remove_node* parent = node->parent;
+        if (node->fd >= 0) {
+            close(node->fd);
+        }
+        int parent_fd = parent ? parent->fd : AT_FDCWD;
+        if (unlinkat(parent_fd, node->name, AT_REMOVEDIR) != 0) {
+            filesys_remove_error(node->removal, errno);
+        }
+        free(node);
+        node = parent;
+    }
+} // end of func
+
+static void filesys_remove_task(void* arg) {
+    filesys_remove_node* node = (filesys_remove_node*)arg;
+    filesys_removal* removal = node->removal;
+    if (node->parent) {
+        __atomic_sub_fetch(&removal->queued, 1, __ATOMIC_RELAXED);
+    }
+
+    int parent_fd = node->parent ? node->parent->fd : AT_FDCWD;
+    node->fd = openat(parent_fd, node->name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    int listing = node->fd >= 0 ? dup(node->fd) : -1;
+    DIR* dir = listing >= 0 ? fdopendir(listing) : NULL;
+    if (!dir) {
+        filesys_remove_error(removal, errno);
+        if (listing >= 0) {
+            close(listing);
+        }
+        filesys_remove_release(node);
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        int is_dir = 0;
+#ifdef DT_DIR
+        if (entry->d_type == DT_DIR) {
+            is_dir = 1;
+        } else if (entry->d_type == DT_UNKNOWN)
+#endif
+        {
+            struct stat info;
+            is_dir = fstatat(node->fd, name, &info, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(info.st_mode);
+        }
+        if (!is_dir) {
+            if (unlinkat(node->fd, name, 0) != 0) {
+                filesys_remove_error(removal, errno);
+            }
+            continue;
+        }
+
+        filesys_remove_node* child = filesys_remove_node_create(node, removal, name);
+        if (!child) {
+            continue;
+        }
+        __atomic_add_fetch(&node->pending, 1, __ATOMIC_RELAXED);
+
+        // Hand subtrees to idle workers, keep descending inline when they are busy
+        if (__atomic_add_fetch(&removal->queued, 1, __ATOMIC_RELAXED) <= removal->limit &&
+            fscl_workers_submit(removal->workers, filesys_remove_task, child) == 0) {
+            continue;
+        }
+        filesys_remove_task(child);
+    }
+    closedir(dir);
+    filesys_remove_release(node);
+} // end of func
+#else
+static int filesys_remove_tree(cfilepath* path) {
+    size_t length = path->length;
+    if (fscl_filepath_join(path, "*") != 0) {
+        return -1;
+    }
+
+    int result = 0;
+    struct _finddata_t file_info;
+    intptr_t handle = _findfirst(fscl_filepath_cstr(path), &file_info);
+    fscl_filepath_truncate(path, length);
+    if (handle != -1) {
+        do {
+            const char* name = file_info.name;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+                continue;
+            }
+            if (fscl_filepath_join(path, name) != 0) {
+                result = -1;
+                continue;
+            }
+            if (file_info.attrib & _A_SUBDIR) {
+                result |= filesys_remove_tree(path);
+            } else if (_unlink(fscl_filepath_cstr(path)) != 0) {
+                result = -1;
+            }
+            fscl_filepath_truncate(path, length);
+        } while (_findnext(handle, &file_info) == 0);
+        _findclose(handle);
+    }
+    if (_rmdir(fscl_filepath_cstr(path)) != 0) {
+        result = -1;
+    }
+    return result;
+} // end of func
+#endif
+
+static int filesys_remove_all(const cfilesystem* directory, int threads) {
+    struct stat info;
+#ifdef _WIN32
+    (void)threads;
+    if (stat(directory->path, &info) != 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        return remove(directory->path);
+    }
+    cfilepath path;
+    fscl_filepath_init(&path);
+    int result = fscl_filepath_set(&path, directory->path) == 0 ? filesys_remove_tree(&path) : -1;
+    fscl_filepath_erase(&path);
+    return result;
+#else
+    if (lstat(directory->path, &info) != 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        return unlink(directory->path);
+    }
+
+    filesys_removal removal = {NULL, 0, 0, 0};
+    removal.workers = fscl_workers_create(threads);
+    if (!removal.workers) {
+        errno = ENOMEM;
+        return -1;
+    }
+    removal.limit = fscl_workers_count(removal.workers) * 4;
+
+    filesys_remove_node* root = filesys_remove_node_create(NULL, &removal, directory->path);
+    if (root) {
+        filesys_remove_task(root);
+    }
+    fscl_workers_wait(removal.workers);
+    fscl_workers_erase(removal.workers);
+
+    if (removal.error != 0) {
+        errno = removal.error;
+        return -1;
+    }
+    return 0;
+#endif
+} // end of func
+
+// Function to remove a directory tree
+int fscl_filesys_remove_all(const cfilesystem* directory, int threads) {
+    if (!directory || !directory->path || !*directory->path) {
+        errno = EINVAL;
+        return -1;
+    }
+    int result = filesys_remove_all(directory, threads);
+    int error = errno;
+    // Any path below may be cached, and the cache has no prefix lookup
+    cstatcache* cache = fscl_statcache_installed();
+    if (cache) {
+        fscl_statcache_clear(cache);
+    }
+    errno = error;
+    return result;
+} // end of func
+
+#ifndef _WIN32
+// Copy engines, from cheapest to most expensive
+enum {
+    FILESYS_COPY_RANGE,
+    FILESYS_COPY_SENDFILE,
+    FILESYS_COPY_BUFFERED
+};
+
+// Errors that mean an engine cannot handle this pair of files at all
+static int filesys_copy_unsupported(int error) {
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP ||
+           error == ENOTSUP || error == EBADF || error == EPERM;
+} // end of func
+
+// Copy [offset, offset + length) to the same offsets of out
+static int filesys_copy_range(int in, int out, off_t offset, off_t length, int* engine, char** buffer) {
+    while (length > 0) {
+        size_t chunk = length > (off_t)1 << 30 ? (size_t)1 << 30 : (size_t)length;
+        ssize_t copied = -1;
+#ifdef __linux__
+        if (*engine == FILESYS_COPY_RANGE) {
+#ifdef __NR_copy_file_range
+            loff_t in_offset = offset;
+            loff_t out_offset = offset;
+            copied = syscall(__NR_copy_file_range, in, &in_offset, out, &out_offset, chunk, 0);
+#else
+            errno = ENOSYS;
+#endif
+            if (copied <= 0 && (copied == 0 || filesys_copy_unsupported(errno))) {
+                *engine = FILESYS_COPY_SENDFILE;
+                continue;
+            }
+        } else if (*engine == FILESYS_COPY_SENDFILE) {
+            off_t in_offset = offset;
+            if (lseek(out, offset, SEEK_SET) == offset) {
+                copied = sendfile(out, in, &in_offset, chunk);
+            }
+            if (copied <= 0 && (copied == 0 || filesys_copy_unsupported(errno))) {
+                *engine = FILESYS_COPY_BUFFERED;
+                continue;
+            }
+        } else
+#endif
+        {
+            if (!*buffer) {
+                *buffer = (char*)malloc(FILESYS_COPY_BUFFER);
+                if (!*buffer) {
+                    errno = ENOMEM;
+                    return -1;
+                }
+            }
+            if (chunk > FILESYS_COPY_BUFFER) {
+                chunk = FILESYS_COPY_BUFFER;
+            }
+            copied = pread(in, *buffer, chunk, offset);
+            if (copied == 0) {
+                return 0; // file shrank underneath us
+            }
+            for (ssize_t done = 0; copied > 0 && done < copied;) {
+                ssize_t written = pwrite(out, *buffer + done, (size_t)(copied - done), offset + done);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return -1;
+                }
+                done += written;
+            }
+        }
+        if (copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        offset += copied;
+        length -= copied;
+    }
+    return 0;
+} // end of func
+
+// Copy the contents of in to the empty file out, keeping holes
+static int filesys_copy_fd(int in, int out, off_t size) {
+#ifdef __linux__
+    if (ioctl(out, FICLONE, in) == 0) {
+        return 0; // reflink, blocks are shared until either side writes
+    }
+    int engine = FILESYS_COPY_RANGE;
+#else
+    int engine = FILESYS_COPY_BUFFERED;
+#endif
+    char* buffer = NULL;
+    int result = 0;
+    off_t position = 0;
+    while (position < size) {
+        off_t data = position;
+        off_t hole = size;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+        data = lseek(in, position, SEEK_DATA);
+        if (data < 0) {
+            if (errno == ENXIO) {
+                break; // only a hole is left
+            }
+            data = position; // no hole support, copy everything
+        } else {
+            hole = lseek(in, data, SEEK_HOLE);
+            if (hole < 0 || hole > size) {
+                hole = size;
+            }
+        }
+#endif
+        if (filesys_copy_range(in, out, data, hole - data, &engine, &buffer) != 0) {
+            result = -1;
+            break;
+        }
+        position = hole;
+    }
+    free(buffer);
+
+    // A trailing hole is not written, extend the file to the right size
+    if (result == 0 && ftruncate(out, size) != 0) {
+        result = -1;
+    }
+    return result;
+} // end of func
+#endif
+
+static int filesys_copy_file(const cfilesystem* source, const cfilesystem* destination) {
+#ifdef _WIN32
+    return CopyFileA(source->path, destination->path, FALSE) ? 0 : -1;
+#else
+    int in = open(source->path, O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return -1;
+    }
+    struct stat info;
+    struct stat target;
+    if (fstat(in, &info) != 0) {
+        close(in);
+        return -1;
+    }
+    if (!S_ISREG(info.st_mode)) {
+        close(in);
+        errno = EINVAL;
+        return -1;
+    }
+    if (stat(destination->path, &target) == 0 && target.st_dev == info.st_dev && target.st_ino == info.st_ino) {
+        close(in);
+        errno = EINVAL; // truncating the destination would destroy the source
+        return -1;
+    }
+
+    int out = open(destination->path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, info.st_mode & 07777);
+    if (out < 0) {
+        close(in);
+        return -1;
+    }
+    int result = filesys_copy_fd(in, out, info.st_size);
+    if (result == 0) {
+        result = fchmod(out, info.st_mode & 07777);
+    }
+    int error = errno;
+    close(in);
+    if (close(out) != 0 && result == 0) {
+        result = -1;
+        error = errno;
+    }
+    errno = error;
+    return result;
+#endif
+} // end of func
+
+// Function to copy a file
+int fscl_filesys_copy_file(const cfilesystem* source, const cfilesystem* destination) {
+    if (!source || !destination || !source->path || !destination->path) {
+        errno = EINVAL;
+        return -1;
+    }
+    int result = filesys_copy_file(source, destination);
+    int error = errno;
+    filesys_invalidate(destination->path, 0);
+    errno = error;
+    return result;
+} // end of func
+
+static int filesys_move_file(const cfilesystem* source, const cfilesystem* destination) {
+#ifdef _WIN32
+    return MoveFileExA(source->path, destination->path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) ? 0 : -1;
+#else
+    if (rename(source->path, destination->path) == 0) {
+        return 0;
+    }
+    if (errno != EXDEV) {
+        return -1;
+    }
+
+    // Across filesystems: copy beside the destination, then rename into place
+    size_t length = strlen(destination->path);
+    char small[256];
+    char* temp = length + 8 <= sizeof(small) ? small : (char*)malloc(length + 8);
+    if (!temp) {
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(temp, destination->path, length);
+    memcpy(temp + length, ".XXXXXX", 8);
+
+    int result = -1;
+    int in = open(source->path, O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (in >= 0 && fstat(in, &info) == 0) {
+        int out = -1;
+        if (!S_ISREG(info.st_mode)) {
+            errno = EINVAL;
+        } else if ((out = mkstemp(temp)) >= 0) {
+            if (filesys_copy_fd(in, out, info.st_size) == 0 && fchmod(out, info.st_mode & 07777) == 0 &&
+                fsync(out) == 0) {
+                result = 0;
+            }
+            if (close(out) != 0) {
+                result = -1;
+            }
+            if (result == 0) {
+                result = rename(temp, destination->path);
+            }
+            if (result != 0) {
+                int error = errno;
+                unlink(temp);
+                errno = error;
+            }
+        }
+    }
+    if (in >= 0) {
+        close(in);
+    }
+    if (result == 0) {
+        result = unlink(source->path);
+    }
+    if (temp != small) {
+        free(temp);
+    }
+    return result;
+#endif
+} // end of func
+
+// Function to move a file
+int fscl_filesys_move_file(const cfilesystem* source, const cfilesystem* destination) {
+    if (!source || !destination || !source->path || !destination->path) {
+        errno = EINVAL;
+        return -1;
+    }
+    int result = filesys_move_file(source, destination);
+    int error = errno;
+    struct stat info;
+    cstatcache* cache = fscl_statcache_installed();
+    if (cache && result == 0 && stat(destination->path, &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR) {
+        fscl_statcache_clear(cache); // a renamed directory moves every path below it
+    } else {
+        filesys_invalidate(source->path, 0);
+        filesys_invalidate(destination->path, 0);
     }
+    errno = error;
+    return result;
 } // end of func
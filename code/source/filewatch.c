@@ -0,0 +1,541 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/filewatch.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#define FSCL_FILEWATCH_INOTIFY 1
+#endif
+
+#ifdef FSCL_FILEWATCH_INOTIFY
+#define FILEWATCH_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | \
+                        IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_DONT_FOLLOW | IN_EXCL_UNLINK | IN_ONLYDIR)
+
+// A path collected during the current tick
+typedef struct {
+    size_t offset;     // start of the path in the arena
+    uint64_t hash;
+    unsigned int events;
+    int is_directory;
+    int born;          // first seen as created during this tick
+} filewatch_pending;
+
+struct cfilewatch {
+    int fd;
+    int root_wd;
+    char* root;                 // root path, outlives the root watch for overflow reports
+    int recursive;
+    int tick_ms;
+    char** dirs;                // directory path per watch descriptor
+    size_t dir_count;
+    filewatch_pending* pending; // batch in order of first appearance
+    size_t count;
+    size_t capacity;
+    size_t* slots;              // open addressing index into pending, 0 is empty
+    size_t slot_mask;
+    char* arena;                // path bytes of the batch
+    size_t arena_used;
+    size_t arena_capacity;
+    cfilewatch_event* out;
+    uint32_t move_cookie;       // IN_MOVED_FROM waiting for its IN_MOVED_TO
+    char* move_from;            // source path of that move, NULL when none
+    int move_is_directory;
+    int renamed_wd;             // directory renamed inside the tree, its IN_MOVE_SELF is expected
+};
+
+static uint64_t filewatch_hash(const char* path, size_t length) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)path[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+} // end of func
+
+static int filewatch_grow(cfilewatch* watch) {
+    size_t capacity = watch->capacity ? watch->capacity * 2 : 64;
+    filewatch_pending* pending = (filewatch_pending*)realloc(watch->pending, capacity * sizeof(filewatch_pending));
+    if (!pending) {
+        return -1;
+    }
+    watch->pending = pending;
+    cfilewatch_event* out = (cfilewatch_event*)realloc(watch->out, capacity * sizeof(cfilewatch_event));
+    if (!out) {
+        return -1;
+    }
+    watch->out = out;
+
+    // Keep the index at most half full
+    size_t* slots = (size_t*)calloc(capacity * 2, sizeof(size_t));
+    if (!slots) {
+        return -1;
+    }
+    free(watch->slots);
+    watch->slots = slots;
+    watch->slot_mask = capacity * 2 - 1;
+    watch->capacity = capacity;
+    for (size_t i = 0; i < watch->count; ++i) {
+        size_t slot = watch->pending[i].hash & watch->slot_mask;
+        while (watch->slots[slot]) {
+            slot = (slot + 1) & watch->slot_mask;
+        }
+        watch->slots[slot] = i + 1;
+    }
+    return 0;
+} // end of func
+
+// Merge one event into the batch
+static void filewatch_record(cfilewatch* watch, const char* dir, const char* name, unsigned int events, int is_directory) {
+    size_t dir_length = strlen(dir);
+    size_t name_length = name ? strlen(name) : 0;
+    size_t length = dir_length + (name ? name_length + 1 : 0);
+
+    if (watch->arena_used + length + 1 > watch->arena_capacity) {
+        size_t capacity = watch->arena_capacity ? watch->arena_capacity : 4096;
+        while (watch->arena_used + length + 1 > capacity) {
+            capacity *= 2;
+        }
+        char* arena = (char*)realloc(watch->arena, capacity);
+        if (!arena) {
+            return;
+        }
+        watch->arena = arena;
+        watch->arena_capacity = capacity;
+    }
+    char* path = watch->arena + watch->arena_used;
+    memcpy(path, dir, dir_length);
+    if (name) {
+        path[dir_length] = '/';
+        memcpy(path + dir_length + 1, name, name_length);
+    }
+    path[length] = '\0';
+    uint64_t hash = filewatch_hash(path, length);
+
+    if (watch->count == watch->capacity && filewatch_grow(watch) != 0) {
+        return;
+    }
+    size_t slot = hash & watch->slot_mask;
+    while (watch->slots[slot]) {
+        filewatch_pending* known = &watch->pending[watch->slots[slot] - 1];
+        if (known->hash == hash && strcmp(watch->arena + known->offset, path) == 0) {
+            if (known->born && (events & FILEWATCH_DELETED)) {
+                known->events = 0; // created and gone again within the tick
+                known->born = 0;
+            } else if (known->events == 0 && (events & FILEWATCH_CREATED)) {
+                known->events = events;
+                known->born = 1;
+            } else {
+                known->events |= events;
+            }
+            known->is_directory = is_directory;
+            return;
+        }
+        slot = (slot + 1) & watch->slot_mask;
+    }
+
+    filewatch_pending* entry = &watch->pending[watch->count];
+    entry->offset = watch->arena_used;
+    entry->hash = hash;
+    entry->events = events;
+    entry->is_directory = is_directory;
+    entry->born = (events & FILEWATCH_CREATED) != 0;
+    watch->slots[slot] = ++watch->count;
+    watch->arena_used += length + 1;
+} // end of func
+
+static void filewatch_set_dir(cfilewatch* watch, int wd, const char* path) {
+    if ((size_t)wd >= watch->dir_count) {
+        size_t count = watch->dir_count ? watch->dir_count : 64;
+        while (count <= (size_t)wd) {
+            count *= 2;
+        }
+        char** dirs = (char**)realloc(watch->dirs, count * sizeof(char*));
+        if (!dirs) {
+            return;
+        }
+        memset(dirs + watch->dir_count, 0, (count - watch->dir_count) * sizeof(char*));
+        watch->dirs = dirs;
+        watch->dir_count = count;
+    }
+    size_t length = strlen(path);
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) {
+        return;
+    }
+    memcpy(copy, path, length + 1);
+    free(watch->dirs[wd]);
+    watch->dirs[wd] = copy;
+} // end of func
+
+// Watch a directory and, in recursive mode, everything below it. Entries
+// found while adding a new subtree are reported as created, since their
+// own events fired before the watch existed.
+static int filewatch_add_tree(cfilewatch* watch, const char* path, int report) {
+    int wd = inotify_add_watch(watch->fd, path, FILEWATCH_MASK);
+    if (wd < 0) {
+        return -1;
+    }
+    filewatch_set_dir(watch, wd, path);
+    if (!watch->recursive) {
+        return wd;
+    }
+
+    DIR* dir = opendir(path);
+    if (!dir) {
+        return wd;
+    }
+    size_t path_length = strlen(path);
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        size_t name_length = strlen(name);
+        char small[512];
+        char* child = path_length + name_length + 2 <= sizeof(small) ? small : (char*)malloc(path_length + name_length + 2);
+        if (!child) {
+            continue;
+        }
+        memcpy(child, path, path_length);
+        child[path_length] = '/';
+        memcpy(child + path_length + 1, name, name_length + 1);
+
+        int is_directory = 0;
+#ifdef DT_DIR
+        if (entry->d_type == DT_DIR) {
+            is_directory = 1;
+        } else if (entry->d_type == DT_UNKNOWN)
+#endif
+        {
+            struct stat info;
+            is_directory = lstat(child, &info) == 0 && S_ISDIR(info.st_mode);
+        }
+        if (report) {
+            filewatch_record(watch, path, name, FILEWATCH_CREATED, is_directory);
+        }
+        if (is_directory) {
+            filewatch_add_tree(watch, child, report);
+        }
+        if (child != small) {
+            free(child);
+        }
+    }
+    closedir(dir);
+    return wd;
+} // end of func
+
+// Stop watching a directory that left the tree, and everything below it
+static void filewatch_remove_tree(cfilewatch* watch, const char* path) {
+    size_t length = strlen(path);
+    for (size_t wd = 0; wd < watch->dir_count; ++wd) {
+        const char* dir = watch->dirs[wd];
+        if (dir && (int)wd != watch->root_wd && strncmp(dir, path, length) == 0 &&
+            (dir[length] == '\0' || dir[length] == '/')) {
+            inotify_rm_watch(watch->fd, (int)wd);
+            free(watch->dirs[wd]);
+            watch->dirs[wd] = NULL; // the IN_IGNORED that follows finds nothing
+        }
+    }
+} // end of func
+
+// Settle the pending IN_MOVED_FROM; without a matching IN_MOVED_TO the
+// source went somewhere outside the tree
+static void filewatch_settle_move(cfilewatch* watch, int matched) {
+    if (!watch->move_from) {
+        return;
+    }
+    if (!matched && watch->move_is_directory) {
+        filewatch_remove_tree(watch, watch->move_from);
+    }
+    free(watch->move_from);
+    watch->move_from = NULL;
+} // end of func
+
+// Remember the source of a move until its destination shows up
+static void filewatch_hold_move(cfilewatch* watch, const char* dir, const char* name, uint32_t cookie, int is_directory) {
+    filewatch_settle_move(watch, 0);
+    size_t dir_length = strlen(dir);
+    size_t name_length = strlen(name);
+    char* path = (char*)malloc(dir_length + name_length + 2);
+    if (!path) {
+        return;
+    }
+    memcpy(path, dir, dir_length);
+    path[dir_length] = '/';
+    memcpy(path + dir_length + 1, name, name_length + 1);
+    watch->move_from = path;
+    watch->move_cookie = cookie;
+    watch->move_is_directory = is_directory;
+} // end of func
+
+static void filewatch_apply(cfilewatch* watch, const struct inotify_event* event) {
+    if (event->mask & IN_Q_OVERFLOW) {
+        filewatch_record(watch, watch->root, NULL, FILEWATCH_OVERFLOW, 1);
+        return;
+    }
+    // A move pairs with the event right after it, anything else settles it
+    int matched = watch->move_from && (event->mask & IN_MOVED_TO) && event->cookie == watch->move_cookie;
+    filewatch_settle_move(watch, matched);
+    if (event->wd < 0 || (size_t)event->wd >= watch->dir_count || !watch->dirs[event->wd]) {
+        return;
+    }
+    const char* dir = watch->dirs[event->wd];
+    if (event->mask & IN_IGNORED) {
+        free(watch->dirs[event->wd]);
+        watch->dirs[event->wd] = NULL;
+        return;
+    }
+
+    unsigned int events = 0;
+    if (event->mask & IN_CREATE) {
+        events |= FILEWATCH_CREATED;
+    }
+    if (event->mask & (IN_DELETE | IN_DELETE_SELF)) {
+        events |= FILEWATCH_DELETED;
+    }
+    if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+        events |= FILEWATCH_MODIFIED;
+    }
+    if (event->mask & IN_ATTRIB) {
+        events |= FILEWATCH_ATTRIB;
+    }
+    if (event->mask & IN_MOVED_FROM) {
+        events |= FILEWATCH_MOVED | FILEWATCH_DELETED;
+    }
+    if (event->mask & IN_MOVED_TO) {
+        events |= FILEWATCH_MOVED | FILEWATCH_CREATED;
+    }
+    if (event->mask & IN_MOVE_SELF) {
+        events |= FILEWATCH_MOVED | FILEWATCH_DELETED;
+    }
+    int is_directory = (event->mask & IN_ISDIR) != 0;
+
+    if (event->len == 0) {
+        // Self events of subdirectories are already reported by their parent
+        if (event->wd == watch->root_wd) {
+            filewatch_record(watch, dir, NULL, events, 1);
+        } else if (event->mask & IN_MOVE_SELF) {
+            if (event->wd == watch->renamed_wd) {
+                watch->renamed_wd = -1; // renamed inside the tree, already rewatched
+            } else {
+                char* gone = watch->dirs[event->wd]; // moved out, descendants follow it
+                watch->dirs[event->wd] = NULL;
+                inotify_rm_watch(watch->fd, event->wd);
+                filewatch_remove_tree(watch, gone);
+                free(gone);
+            }
+        }
+        return;
+    }
+    filewatch_record(watch, dir, event->name, events, is_directory);
+    if (event->mask & IN_MOVED_FROM) {
+        filewatch_hold_move(watch, dir, event->name, event->cookie, is_directory);
+    }
+
+    if (watch->recursive && is_directory && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+        size_t dir_length = strlen(dir);
+        size_t name_length = strlen(event->name);
+        char* child = (char*)malloc(dir_length + name_length + 2);
+        if (child) {
+            memcpy(child, dir, dir_length);
+            child[dir_length] = '/';
+            memcpy(child + dir_length + 1, event->name, name_length + 1);
+            int wd = filewatch_add_tree(watch, child, 1);
+            if (matched) {
+                watch->renamed_wd = wd; // same inode, so the old watch now carries the new path
+            }
+            free(child);
+        }
+    }
+} // end of func
+
+// Read everything the kernel has queued, returns the number of bytes read
+static long filewatch_drain(cfilewatch* watch) {
+    char buffer[16384] __attribute__((aligned(__alignof__(struct inotify_event))));
+    long total = 0;
+    for (;;) {
+        ssize_t length = read(watch->fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            if (length < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const struct inotify_event* event = (const struct inotify_event*)cursor;
+            filewatch_apply(watch, event);
+            cursor += sizeof(struct inotify_event) + event->len;
+        }
+        total += length;
+    }
+    filewatch_settle_move(watch, 0);
+    return total;
+} // end of func
+
+static long filewatch_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+} // end of func
+#else
+struct cfilewatch {
+    int fd;
+};
+#endif
+
+// Function to start watching a directory
+cfilewatch* fscl_filewatch_create(const char* root, int recursive, int tick_ms) {
+    if (!root) {
+        errno = EINVAL;
+        return NULL;
+    }
+#ifdef FSCL_FILEWATCH_INOTIFY
+    cfilewatch* watch = (cfilewatch*)calloc(1, sizeof(cfilewatch));
+    if (!watch) {
+        return NULL;
+    }
+    watch->recursive = recursive;
+    watch->renamed_wd = -1;
+    watch->tick_ms = tick_ms > 0 ? tick_ms : 0;
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd < 0 || filewatch_grow(watch) != 0) {
+        int error = errno;
+        fscl_filewatch_erase(watch);
+        errno = error;
+        return NULL;
+    }
+
+    size_t length = strlen(root);
+    while (length > 1 && root[length - 1] == '/') {
+        --length;
+    }
+    char* path = (char*)malloc(length + 1);
+    if (!path) {
+        fscl_filewatch_erase(watch);
+        errno = ENOMEM;
+        return NULL;
+    }
+    memcpy(path, root, length);
+    path[length] = '\0';
+    watch->root = path;
+    watch->root_wd = filewatch_add_tree(watch, path, 0);
+    if (watch->root_wd < 0) {
+        int error = errno;
+        fscl_filewatch_erase(watch);
+        errno = error;
+        return NULL;
+    }
+    return watch;
+#else
+    (void)recursive;
+    (void)tick_ms;
+    errno = ENOSYS;
+    return NULL;
+#endif
+} // end of func
+
+// Function to get the descriptor that signals pending events
+int fscl_filewatch_fd(const cfilewatch* watch) {
+    return watch ? watch->fd : -1;
+} // end of func
+
+// Function to wait for changes and deliver them as one batch
+int fscl_filewatch_poll(cfilewatch* watch, int timeout_ms, cfilewatch_callback callback, void* user) {
+    if (!watch) {
+        errno = EINVAL;
+        return -1;
+    }
+#ifdef FSCL_FILEWATCH_INOTIFY
+    struct pollfd fds = {watch->fd, POLLIN, 0};
+    int ready = poll(&fds, 1, timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+    filewatch_drain(watch);
+
+    // Keep collecting until the tick is over so a burst becomes one batch
+    if (watch->tick_ms > 0) {
+        long deadline = filewatch_now_ms() + watch->tick_ms;
+        for (long left = watch->tick_ms; left > 0; left = deadline - filewatch_now_ms()) {
+            if (poll(&fds, 1, (int)left) > 0) {
+                filewatch_drain(watch);
+            }
+        }
+    }
+
+    size_t delivered = 0;
+    for (size_t i = 0; i < watch->count; ++i) {
+        const filewatch_pending* entry = &watch->pending[i];
+        if (entry->events == 0) {
+            continue;
+        }
+        cfilewatch_event* event = &watch->out[delivered++];
+        event->path = watch->arena + entry->offset;
+        event->events = entry->events;
+        event->is_directory = entry->is_directory;
+    }
+    if (delivered > 0 && callback) {
+        callback(watch->out, delivered, user);
+    }
+
+    memset(watch->slots, 0, (watch->slot_mask + 1) * sizeof(size_t));
+    watch->count = 0;
+    watch->arena_used = 0;
+    return (int)delivered;
+#else
+    (void)timeout_ms;
+    (void)callback;
+    (void)user;
+    errno = ENOSYS;
+    return -1;
+#endif
+} // end of func
+
+// Function to stop watching and free the watcher
+void fscl_filewatch_erase(cfilewatch* watch) {
+    if (!watch) {
+        return;
+    }
+#ifdef FSCL_FILEWATCH_INOTIFY
+    if (watch->fd >= 0) {
+        close(watch->fd);
+    }
+    for (size_t i = 0; i < watch->dir_count; ++i) {
+        free(watch->dirs[i]);
+    }
+    free(watch->dirs);
+    free(watch->root);
+    free(watch->move_from);
+    free(watch->pending);
+    free(watch->slots);
+    free(watch->arena);
+    free(watch->out);
+#endif
+    free(watch);
+} // end of func
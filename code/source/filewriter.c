@@ -0,0 +1,512 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/filewriter.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#include <windows.h>
+#define open _open
+#define write _write
+#define close _close
+#define getpid _getpid
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+// Alignment of the buffer and of direct writes
+#define FILEWRITER_ALIGN ((size_t)4096)
+
+// Buffer sizes when the final size is unknown, and at most
+#define FILEWRITER_BUFFER_DEFAULT ((size_t)64 * 1024)
+#define FILEWRITER_BUFFER_MAX ((size_t)1024 * 1024)
+
+// Largest single write request, keeps counts inside an int
+#define FILEWRITER_IO_LIMIT ((size_t)1 << 30)
+
+static char* filewriter_alloc(size_t size) {
+#ifdef _WIN32
+    return (char*)_aligned_malloc(size, FILEWRITER_ALIGN);
+#else
+    void* memory = NULL;
+    return posix_memalign(&memory, FILEWRITER_ALIGN, size) == 0 ? (char*)memory : NULL;
+#endif
+} // end of func
+
+static void filewriter_release(cfilewriter* writer) {
+#ifdef _WIN32
+    _aligned_free(writer->buffer);
+#else
+    free(writer->buffer);
+#endif
+    free(writer->path);
+    free(writer->temp_path);
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+} // end of func
+
+static int filewriter_write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        size_t chunk = length < FILEWRITER_IO_LIMIT ? length : FILEWRITER_IO_LIMIT;
+        long n = (long)write(fd, data, (unsigned)chunk);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+    return 0;
+} // end of func
+
+// Write out the buffer. Direct writes need aligned lengths, so the final
+// partial block goes through the page cache instead.
+static int filewriter_flush(cfilewriter* writer, int final) {
+    if (writer->used == 0) {
+        return 0;
+    }
+#if defined(O_DIRECT) && !defined(_WIN32)
+    if (final && (writer->flags & FILEWRITER_DIRECT) && writer->used % FILEWRITER_ALIGN != 0) {
+        int status = fcntl(writer->fd, F_GETFL);
+        if (status < 0 || fcntl(writer->fd, F_SETFL, status & ~O_DIRECT) < 0) {
+            return -1;
+        }
+        writer->flags &= ~(unsigned int)FILEWRITER_DIRECT;
+    }
+#else
+    (void)final;
+#endif
+    if (filewriter_write_all(writer->fd, writer->buffer, writer->used) != 0) {
+        return -1;
+    }
+    writer->offset += writer->used;
+    writer->used = 0;
+    return 0;
+} // end of func
+
+// Create the temporary file beside the destination
+static int filewriter_create_temp(cfilewriter* writer) {
+    static unsigned int counter = 0;
+    size_t length = strlen(writer->path) + 48;
+    writer->temp_path = (char*)malloc(length);
+    if (!writer->temp_path) {
+        errno = ENOMEM;
+        return -1;
+    }
+    for (int attempt = 0; attempt < 100; ++attempt) {
+#ifdef _WIN32
+        unsigned int serial = (unsigned int)InterlockedIncrement((volatile LONG*)&counter);
+#else
+        unsigned int serial = __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);
+#endif
+        snprintf(writer->temp_path, length, "%s.%ld.%u.tmp", writer->path, (long)getpid(), serial);
+        int flags = O_WRONLY | O_CREAT | O_EXCL | O_BINARY | O_CLOEXEC;
+#if defined(O_DIRECT) && !defined(_WIN32)
+        if (writer->flags & FILEWRITER_DIRECT) {
+            writer->fd = open(writer->temp_path, flags | O_DIRECT, 0666);
+            if (writer->fd >= 0) {
+                return 0;
+            }
+            if (errno != EINVAL) {
+                if (errno == EEXIST) {
+                    continue;
+                }
+                return -1;
+            }
+            writer->flags &= ~(unsigned int)FILEWRITER_DIRECT; // e.g. tmpfs
+        }
+#endif
+        writer->fd = open(writer->temp_path, flags, 0666);
+        if (writer->fd >= 0) {
+            return 0;
+        }
+        if (errno != EEXIST) {
+            return -1;
+        }
+    }
+    return -1;
+} // end of func
+
+// Function to start replacing a file
+int fscl_filewriter_open(cfilewriter* writer, const char* path, unsigned int flags, size_t expected_size) {
+    if (!writer || !path || !*path) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+#if !defined(O_DIRECT) || defined(_WIN32)
+    flags &= ~(unsigned int)FILEWRITER_DIRECT;
+#endif
+    writer->flags = flags;
+
+    size_t capacity = FILEWRITER_BUFFER_DEFAULT;
+    if (expected_size != 0) {
+        capacity = expected_size < FILEWRITER_BUFFER_MAX ? expected_size : FILEWRITER_BUFFER_MAX;
+        capacity = (capacity + FILEWRITER_ALIGN - 1) & ~(FILEWRITER_ALIGN - 1);
+    }
+    size_t length = strlen(path);
+    writer->capacity = capacity;
+    writer->buffer = filewriter_alloc(capacity);
+    writer->path = (char*)malloc(length + 1);
+    if (!writer->buffer || !writer->path) {
+        filewriter_release(writer);
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(writer->path, path, length + 1);
+
+    if (filewriter_create_temp(writer) != 0) {
+        int error = errno;
+        filewriter_release(writer);
+        errno = error;
+        return -1;
+    }
+
+#ifndef _WIN32
+    // Replacing a file keeps its permissions
+    struct stat info;
+    if (stat(path, &info) == 0 && S_ISREG(info.st_mode)) {
+        fchmod(writer->fd, info.st_mode & 07777);
+    }
+#endif
+
+    if ((flags & FILEWRITER_PREALLOCATE) && expected_size != 0) {
+#ifdef __linux__
+        if (fallocate(writer->fd, 0, 0, (off_t)expected_size) != 0) {
+            if (errno != EOPNOTSUPP && errno != ENOSYS) {
+                int error = errno;
+                fscl_filewriter_abort(writer);
+                errno = error;
+                return -1;
+            }
+            writer->flags &= ~(unsigned int)FILEWRITER_PREALLOCATE;
+        }
+#else
+        writer->flags &= ~(unsigned int)FILEWRITER_PREALLOCATE;
+#endif
+    }
+    return 0;
+} // end of func
+
+// Function to append data to a writer
+int fscl_filewriter_write(cfilewriter* writer, const void* data, size_t length) {
+    if (!writer || writer->fd < 0 || (!data && length != 0)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (writer->error) {
+        errno = writer->error;
+        return -1;
+    }
+    const char* bytes = (const char*)data;
+    while (length > 0) {
+        // Large writes skip the copy when nothing is buffered
+        if (writer->used == 0 && length >= writer->capacity && !(writer->flags & FILEWRITER_DIRECT)) {
+            if (filewriter_write_all(writer->fd, bytes, length) != 0) {
+                writer->error = errno;
+                return -1;
+            }
+            writer->offset += length;
+            return 0;
+        }
+        size_t space = writer->capacity - writer->used;
+        size_t chunk = length < space ? length : space;
+        memcpy(writer->buffer + writer->used, bytes, chunk);
+        writer->used += chunk;
+        bytes += chunk;
+        length -= chunk;
+        if (writer->used == writer->capacity && filewriter_flush(writer, 0) != 0) {
+            writer->error = errno;
+            return -1;
+        }
+    }
+    return 0;
+} // end of func
+
+// Write out the tail and trim any preallocation past the end
+static int filewriter_finish(cfilewriter* writer) {
+    if (writer->fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (writer->error) {
+        errno = writer->error;
+        return -1;
+    }
+    if (filewriter_flush(writer, 1) != 0) {
+        return -1;
+    }
+#ifndef _WIN32
+    if ((writer->flags & FILEWRITER_PREALLOCATE) && ftruncate(writer->fd, (off_t)writer->offset) != 0) {
+        return -1;
+    }
+#endif
+    return 0;
+} // end of func
+
+static int filewriter_sync_file(int fd) {
+#ifdef _WIN32
+    return _commit(fd);
+#elif defined(__linux__)
+    return fdatasync(fd);
+#else
+    return fsync(fd);
+#endif
+} // end of func
+
+// Make the rename of a single file durable
+static int filewriter_sync_parent(const char* path) {
+#ifdef _WIN32
+    (void)path;
+    return 0; // MOVEFILE_WRITE_THROUGH already waited for it
+#else
+    const char* slash = strrchr(path, '/');
+    int fd;
+    if (!slash) {
+        fd = open(".", O_RDONLY | O_CLOEXEC);
+    } else if (slash == path) {
+        fd = open("/", O_RDONLY | O_CLOEXEC);
+    } else {
+        size_t length = (size_t)(slash - path);
+        char* dir = (char*)malloc(length + 1);
+        if (!dir) {
+            errno = ENOMEM;
+            return -1;
+        }
+        memcpy(dir, path, length);
+        dir[length] = '\0';
+        fd = open(dir, O_RDONLY | O_CLOEXEC);
+        free(dir);
+    }
+    if (fd < 0) {
+        return -1;
+    }
+    int result = fsync(fd);
+    if (result != 0 && errno == EINVAL) {
+        result = 0; // the directory cannot be synced on its own here
+    }
+    int error = errno;
+    close(fd);
+    errno = error;
+    return result;
+#endif
+} // end of func
+
+static int filewriter_rename(cfilewriter* writer) {
+#ifdef _WIN32
+    if (close(writer->fd) != 0) {
+        writer->fd = -1;
+        return -1;
+    }
+    writer->fd = -1;
+    if (!MoveFileExA(writer->temp_path, writer->path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        errno = EACCES;
+        return -1;
+    }
+    return 0;
+#else
+    return rename(writer->temp_path, writer->path);
+#endif
+} // end of func
+
+// Close a writer after a successful rename
+static int filewriter_close(cfilewriter* writer) {
+    int result = 0;
+    if (writer->fd >= 0 && close(writer->fd) != 0) {
+        result = -1;
+    }
+    writer->fd = -1;
+    int error = errno;
+    filewriter_release(writer);
+    errno = error;
+    return result;
+} // end of func
+
+// Function to commit a single writer
+int fscl_filewriter_commit(cfilewriter* writer) {
+    if (!writer) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (filewriter_finish(writer) != 0 || filewriter_sync_file(writer->fd) != 0 || filewriter_rename(writer) != 0) {
+        int error = errno;
+        fscl_filewriter_abort(writer);
+        errno = error;
+        return -1;
+    }
+    // The file is in place from here on, later failures only cost durability
+    int result = filewriter_sync_parent(writer->path) == 0 ? 0 : 1;
+    int error = errno;
+    if (filewriter_close(writer) != 0 && result == 0) {
+        result = 1;
+        error = errno;
+    }
+    errno = error;
+    return result;
+} // end of func
+
+#ifdef __linux__
+// Sync every filesystem holding a live writer once. Falls back to a
+// per-file sync when syncfs is refused.
+static int filewriter_sync_devices(cfilewriter* writers, size_t count, dev_t* devices, int data) {
+    size_t known = 0;
+    int result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (writers[i].fd < 0) {
+            continue;
+        }
+        struct stat info;
+        if (fstat(writers[i].fd, &info) != 0) {
+            return -1;
+        }
+        size_t j = 0;
+        while (j < known && devices[j] != info.st_dev) {
+            ++j;
+        }
+        if (j < known) {
+            continue;
+        }
+        devices[known++] = info.st_dev;
+        if (syncfs(writers[i].fd) != 0) {
+            result = -1;
+        }
+    }
+    if (result != 0 && data) {
+        result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (writers[i].fd >= 0 && fdatasync(writers[i].fd) != 0) {
+                result = -1;
+            }
+        }
+    }
+    return result;
+} // end of func
+#endif
+
+// Function to commit many writers with batched syncs
+int fscl_filewriter_commit_all(cfilewriter* writers, size_t count) {
+    if (!writers && count != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (count == 1) {
+        return fscl_filewriter_commit(writers);
+    }
+    int first_error = 0;
+    size_t live = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (filewriter_finish(&writers[i]) != 0) {
+            first_error = first_error ? first_error : errno;
+            fscl_filewriter_abort(&writers[i]);
+        } else {
+            ++live;
+        }
+    }
+    if (live == 0) {
+        errno = first_error ? first_error : 0;
+        return first_error ? -1 : 0;
+    }
+
+#ifdef __linux__
+    dev_t* devices = (dev_t*)malloc(live * sizeof(dev_t));
+    if (!devices) {
+        for (size_t i = 0; i < count; ++i) {
+            fscl_filewriter_abort(&writers[i]);
+        }
+        errno = ENOMEM;
+        return -1;
+    }
+    // One sync per filesystem makes all the data durable before any rename
+    if (filewriter_sync_devices(writers, count, devices, 1) != 0) {
+        first_error = first_error ? first_error : errno;
+        for (size_t i = 0; i < count; ++i) {
+            fscl_filewriter_abort(&writers[i]);
+        }
+        free(devices);
+        errno = first_error;
+        return -1;
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        if (writers[i].fd >= 0 && filewriter_sync_file(writers[i].fd) != 0) {
+            first_error = first_error ? first_error : errno;
+            fscl_filewriter_abort(&writers[i]);
+        }
+    }
+#endif
+
+    for (size_t i = 0; i < count; ++i) {
+        if (writers[i].fd >= 0 && filewriter_rename(&writers[i]) != 0) {
+            first_error = first_error ? first_error : errno;
+            fscl_filewriter_abort(&writers[i]);
+        }
+    }
+
+    // Every file still open is in place now, failures below only cost durability
+    int placed_error = 0;
+#ifdef __linux__
+    // And a second one for the directory entries of the renames
+    if (filewriter_sync_devices(writers, count, devices, 0) != 0) {
+        placed_error = errno;
+    }
+    free(devices);
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        if (writers[i].path && filewriter_close(&writers[i]) != 0) {
+            placed_error = placed_error ? placed_error : errno;
+        }
+    }
+    if (first_error) {
+        errno = first_error;
+        return -1;
+    }
+    if (placed_error) {
+        errno = placed_error;
+        return 1;
+    }
+    return 0;
+} // end of func
+
+// Function to discard a writer
+void fscl_filewriter_abort(cfilewriter* writer) {
+    if (!writer) {
+        return;
+    }
+    if (writer->fd >= 0) {
+        close(writer->fd);
+    }
+    if (writer->temp_path) {
+        remove(writer->temp_path);
+    }
+    filewriter_release(writer);
+} // end of func
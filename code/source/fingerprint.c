@@ -0,0 +1,690 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/fingerprint.h"
+#include "fossil/xutil/filemap.h"
+#include "workers.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#define FINGERPRINT_PRIME1 0x9E3779B185EBCA87ULL
+#define FINGERPRINT_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define FINGERPRINT_PRIME3 0x165667B19E3779F9ULL
+#define FINGERPRINT_PRIME4 0x85EBCA77C2B2AE63ULL
+#define FINGERPRINT_PRIME5 0x27D4EB2F165667C5ULL
+
+// Bytes of a file mapped at once while hashing
+#define FINGERPRINT_WINDOW ((size_t)64 * 1024 * 1024)
+
+// First line of a saved manifest
+#define FINGERPRINT_MAGIC "fossil-fingerprint 1\n"
+
+// =================================================================
+// XXH64 content hash
+// =================================================================
+
+static inline uint64_t fingerprint_rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+} // end of func
+
+static inline uint64_t fingerprint_read64(const unsigned char* data) {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+} // end of func
+
+static inline uint32_t fingerprint_read32(const unsigned char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+} // end of func
+
+static inline uint64_t fingerprint_round(uint64_t lane, uint64_t input) {
+    lane += input * FINGERPRINT_PRIME2;
+    lane = fingerprint_rotl(lane, 31);
+    return lane * FINGERPRINT_PRIME1;
+} // end of func
+
+static inline uint64_t fingerprint_merge(uint64_t hash, uint64_t lane) {
+    hash ^= fingerprint_round(0, lane);
+    return hash * FINGERPRINT_PRIME1 + FINGERPRINT_PRIME4;
+} // end of func
+
+// Consume whole 32-byte stripes; the four lanes are independent so they pipeline
+static const unsigned char* fingerprint_stripes(uint64_t lanes[4], const unsigned char* data, const unsigned char* end) {
+    uint64_t v1 = lanes[0];
+    uint64_t v2 = lanes[1];
+    uint64_t v3 = lanes[2];
+    uint64_t v4 = lanes[3];
+    while (end - data >= 32) {
+        v1 = fingerprint_round(v1, fingerprint_read64(data));
+        v2 = fingerprint_round(v2, fingerprint_read64(data + 8));
+        v3 = fingerprint_round(v3, fingerprint_read64(data + 16));
+        v4 = fingerprint_round(v4, fingerprint_read64(data + 24));
+        data += 32;
+    }
+    lanes[0] = v1;
+    lanes[1] = v2;
+    lanes[2] = v3;
+    lanes[3] = v4;
+    return data;
+} // end of func
+
+// Function to start a streaming hash
+void fscl_fingerprint_hash_init(cfingerprint_hasher* hasher, uint64_t seed) {
+    hasher->lanes[0] = seed + FINGERPRINT_PRIME1 + FINGERPRINT_PRIME2;
+    hasher->lanes[1] = seed + FINGERPRINT_PRIME2;
+    hasher->lanes[2] = seed;
+    hasher->lanes[3] = seed - FINGERPRINT_PRIME1;
+    hasher->seed = seed;
+    hasher->total = 0;
+    hasher->buffered = 0;
+} // end of func
+
+// Function to feed bytes into a streaming hash
+void fscl_fingerprint_hash_update(cfingerprint_hasher* hasher, const void* data, size_t length) {
+    const unsigned char* cursor = (const unsigned char*)data;
+    const unsigned char* end = cursor + length;
+    hasher->total += length;
+
+    if (hasher->buffered + length < 32) {
+        memcpy(hasher->buffer + hasher->buffered, cursor, length);
+        hasher->buffered += length;
+        return;
+    }
+    if (hasher->buffered) {
+        size_t fill = 32 - hasher->buffered;
+        memcpy(hasher->buffer + hasher->buffered, cursor, fill);
+        fingerprint_stripes(hasher->lanes, hasher->buffer, hasher->buffer + 32);
+        cursor += fill;
+        hasher->buffered = 0;
+    }
+    cursor = fingerprint_stripes(hasher->lanes, cursor, end);
+    hasher->buffered = (size_t)(end - cursor);
+    memcpy(hasher->buffer, cursor, hasher->buffered);
+} // end of func
+
+// Function to get the hash of everything fed so far
+uint64_t fscl_fingerprint_hash_digest(const cfingerprint_hasher* hasher) {
+    uint64_t hash;
+    if (hasher->total >= 32) {
+        const uint64_t* v = hasher->lanes;
+        hash = fingerprint_rotl(v[0], 1) + fingerprint_rotl(v[1], 7) +
+               fingerprint_rotl(v[2], 12) + fingerprint_rotl(v[3], 18);
+        hash = fingerprint_merge(hash, v[0]);
+        hash = fingerprint_merge(hash, v[1]);
+        hash = fingerprint_merge(hash, v[2]);
+        hash = fingerprint_merge(hash, v[3]);
+    } else {
+        hash = hasher->seed + FINGERPRINT_PRIME5;
+    }
+    hash += hasher->total;
+
+    const unsigned char* cursor = hasher->buffer;
+    const unsigned char* end = cursor + hasher->buffered;
+    while (end - cursor >= 8) {
+        hash ^= fingerprint_round(0, fingerprint_read64(cursor));
+        hash = fingerprint_rotl(hash, 27) * FINGERPRINT_PRIME1 + FINGERPRINT_PRIME4;
+        cursor += 8;
+    }
+    if (end - cursor >= 4) {
+        hash ^= (uint64_t)fingerprint_read32(cursor) * FINGERPRINT_PRIME1;
+        hash = fingerprint_rotl(hash, 23) * FINGERPRINT_PRIME2 + FINGERPRINT_PRIME3;
+        cursor += 4;
+    }
+    while (cursor < end) {
+        hash ^= (*cursor++) * FINGERPRINT_PRIME5;
+        hash = fingerprint_rotl(hash, 11) * FINGERPRINT_PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= FINGERPRINT_PRIME2;
+    hash ^= hash >> 29;
+    hash *= FINGERPRINT_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+} // end of func
+
+// Function to hash a buffer in one call
+uint64_t fscl_fingerprint_hash64(const void* data, size_t length, uint64_t seed) {
+    cfingerprint_hasher hasher;
+    fscl_fingerprint_hash_init(&hasher, seed);
+    fscl_fingerprint_hash_update(&hasher, data, length);
+    return fscl_fingerprint_hash_digest(&hasher);
+} // end of func
+
+// =================================================================
+// Manifest handling
+// =================================================================
+
+static int fingerprint_append(cfingerprint_manifest* manifest, const cfingerprint_entry* entry) {
+    if (manifest->count == manifest->capacity) {
+        size_t capacity = manifest->capacity ? manifest->capacity * 2 : 256;
+        cfingerprint_entry* entries = (cfingerprint_entry*)realloc(manifest->entries, capacity * sizeof(cfingerprint_entry));
+        if (!entries) {
+            errno = ENOMEM;
+            return -1;
+        }
+        manifest->entries = entries;
+        manifest->capacity = capacity;
+    }
+    manifest->entries[manifest->count++] = *entry;
+    return 0;
+} // end of func
+
+static int fingerprint_compare(const void* left, const void* right) {
+    return strcmp(((const cfingerprint_entry*)left)->path, ((const cfingerprint_entry*)right)->path);
+} // end of func
+
+// Function to free the entries of a manifest
+void fscl_fingerprint_manifest_erase(cfingerprint_manifest* manifest) {
+    if (!manifest) {
+        return;
+    }
+    for (size_t i = 0; i < manifest->count; ++i) {
+        free(manifest->entries[i].path);
+    }
+    free(manifest->entries);
+    manifest->entries = NULL;
+    manifest->count = 0;
+    manifest->capacity = 0;
+} // end of func
+
+// Function to free the lists of a diff
+void fscl_fingerprint_diff_erase(cfingerprint_diff* diff) {
+    if (!diff) {
+        return;
+    }
+    free((void*)diff->added);
+    free((void*)diff->removed);
+    free((void*)diff->modified);
+    memset(diff, 0, sizeof(*diff));
+} // end of func
+
+// Function to combine a manifest into one tree hash
+uint64_t fscl_fingerprint_tree_hash(const cfingerprint_manifest* manifest) {
+    cfingerprint_hasher hasher;
+    fscl_fingerprint_hash_init(&hasher, 0);
+    for (size_t i = 0; manifest && i < manifest->count; ++i) {
+        unsigned char hash[8];
+        uint64_t value = manifest->entries[i].hash;
+        for (int b = 0; b < 8; ++b) {
+            hash[b] = (unsigned char)(value >> (8 * b));
+        }
+        fscl_fingerprint_hash_update(&hasher, manifest->entries[i].path, strlen(manifest->entries[i].path) + 1);
+        fscl_fingerprint_hash_update(&hasher, hash, sizeof(hash));
+    }
+    return fscl_fingerprint_hash_digest(&hasher);
+} // end of func
+
+// Function to write a manifest to a file
+int fscl_fingerprint_save(const cfingerprint_manifest* manifest, const char* path) {
+    if (!manifest || !path) {
+        errno = EINVAL;
+        return -1;
+    }
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return -1;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    fputs(FINGERPRINT_MAGIC, file);
+    for (size_t i = 0; i < manifest->count; ++i) {
+        const cfingerprint_entry* entry = &manifest->entries[i];
+        // Paths go last with an explicit length so any byte is allowed in them
+        fprintf(file, "%016" PRIx64 " %" PRIu64 " %" PRIu64 " %" PRId64 " %ld %zu ",
+                entry->hash, entry->inode, entry->size, entry->mtime_sec, entry->mtime_nsec, strlen(entry->path));
+        fputs(entry->path, file);
+        fputc('\n', file);
+    }
+    int failed = ferror(file);
+    if (fclose(file) != 0 || failed) {
+        return -1;
+    }
+    return 0;
+} // end of func
+
+// Parse one unsigned number from a bounded buffer
+static int fingerprint_parse(const char** cursor, const char* end, int base, uint64_t* value) {
+    const char* at = *cursor;
+    uint64_t result = 0;
+    int negative = 0;
+    if (at < end && *at == '-') {
+        negative = 1;
+        ++at;
+    }
+    const char* start = at;
+    for (; at < end; ++at) {
+        int digit;
+        if (*at >= '0' && *at <= '9') {
+            digit = *at - '0';
+        } else if (base == 16 && *at >= 'a' && *at <= 'f') {
+            digit = *at - 'a' + 10;
+        } else {
+            break;
+        }
+        result = result * (uint64_t)base + (uint64_t)digit;
+    }
+    if (at == start || at >= end || *at != ' ') {
+        return -1;
+    }
+    *value = negative ? (uint64_t)0 - result : result;
+    *cursor = at + 1;
+    return 0;
+} // end of func
+
+// Function to read a manifest written by fscl_fingerprint_save
+int fscl_fingerprint_load(cfingerprint_manifest* manifest, const char* path) {
+    if (!manifest || !path) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(manifest, 0, sizeof(*manifest));
+
+    cfilemap map;
+    if (fscl_filemap_open(&map, path, FILEMAP_READ_ONLY, 0) != 0) {
+        return -1;
+    }
+    fscl_filemap_advise(&map, FILEMAP_ADVICE_SEQUENTIAL);
+
+    const char* cursor = map.data;
+    const char* end = map.data + map.length;
+    size_t magic = strlen(FINGERPRINT_MAGIC);
+    int result = 0;
+    if (map.length < magic || memcmp(cursor, FINGERPRINT_MAGIC, magic) != 0) {
+        result = -1;
+    }
+    cursor += magic;
+
+    while (result == 0 && cursor < end) {
+        uint64_t hash, inode, size, mtime_sec, mtime_nsec, length;
+        if (fingerprint_parse(&cursor, end, 16, &hash) != 0 ||
+            fingerprint_parse(&cursor, end, 10, &inode) != 0 ||
+            fingerprint_parse(&cursor, end, 10, &size) != 0 ||
+            fingerprint_parse(&cursor, end, 10, &mtime_sec) != 0 ||
+            fingerprint_parse(&cursor, end, 10, &mtime_nsec) != 0 ||
+            fingerprint_parse(&cursor, end, 10, &length) != 0 ||
+            length >= (uint64_t)(end - cursor) || cursor[length] != '\n') {
+            result = -1;
+            break;
+        }
+        cfingerprint_entry entry;
+        entry.path = (char*)malloc((size_t)length + 1);
+        if (!entry.path) {
+            result = -1;
+            break;
+        }
+        memcpy(entry.path, cursor, (size_t)length);
+        entry.path[length] = '\0';
+        entry.hash = hash;
+        entry.inode = inode;
+        entry.size = size;
+        entry.mtime_sec = (int64_t)mtime_sec;
+        entry.mtime_nsec = (long)mtime_nsec;
+        if (fingerprint_append(manifest, &entry) != 0) {
+            free(entry.path);
+            result = -1;
+            break;
+        }
+        cursor += length + 1;
+    }
+    fscl_filemap_close(&map);
+
+    if (result != 0) {
+        fscl_fingerprint_manifest_erase(manifest);
+        errno = EINVAL;
+    }
+    return result;
+} // end of func
+
+// =================================================================
+// Tree scan
+// =================================================================
+
+#ifndef _WIN32
+static const cfingerprint_entry* fingerprint_find(const cfingerprint_manifest* manifest, const char* path) {
+    if (!manifest || manifest->count == 0) {
+        return NULL;
+    }
+    cfingerprint_entry key;
+    key.path = (char*)path;
+    return (const cfingerprint_entry*)bsearch(&key, manifest->entries, manifest->count,
+                                              sizeof(cfingerprint_entry), fingerprint_compare);
+} // end of func
+
+static int fingerprint_list_push(const char*** list, size_t* count, const char* path) {
+    // Lists grow in powers of two, a count that is a power of two is full
+    if ((*count & (*count - 1)) == 0) {
+        size_t capacity = *count ? *count * 2 : 1;
+        const char** grown = (const char**)realloc((void*)*list, capacity * sizeof(const char*));
+        if (!grown) {
+            errno = ENOMEM;
+            return -1;
+        }
+        *list = grown;
+    }
+    (*list)[(*count)++] = path;
+    return 0;
+} // end of func
+
+// Shared state of the hashing workers
+typedef struct {
+    const char* root;
+    cfingerprint_manifest* manifest;
+    size_t* pending;     // indexes of entries that must be read
+    size_t pending_count;
+    size_t next;         // next pending slot to claim
+    int error;
+} fingerprint_job;
+
+static int fingerprint_hash_file(const char* path, uint64_t* hash) {
+    cfilemap map;
+    if (fscl_filemap_open(&map, path, FILEMAP_READ_ONLY, FINGERPRINT_WINDOW) != 0) {
+        return -1;
+    }
+    fscl_filemap_advise(&map, FILEMAP_ADVICE_SEQUENTIAL);
+
+    cfingerprint_hasher hasher;
+    fscl_fingerprint_hash_init(&hasher, 0);
+    for (;;) {
+        fscl_fingerprint_hash_update(&hasher, map.data, map.length);
+        size_t next = map.offset + map.length;
+        if (map.length == 0 || next >= map.size) {
+            break;
+        }
+        if (fscl_filemap_window(&map, next, 0) != 0) {
+            fscl_filemap_close(&map);
+            return -1;
+        }
+        fscl_filemap_advise(&map, FILEMAP_ADVICE_SEQUENTIAL);
+    }
+    fscl_filemap_close(&map);
+    *hash = fscl_fingerprint_hash_digest(&hasher);
+    return 0;
+} // end of func
+
+static void fingerprint_worker(void* arg) {
+    fingerprint_job* job = (fingerprint_job*)arg;
+    size_t root_length = strlen(job->root);
+    char* path = NULL;
+    size_t capacity = 0;
+
+    for (;;) {
+        size_t slot = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (slot >= job->pending_count) {
+            break;
+        }
+        cfingerprint_entry* entry = &job->manifest->entries[job->pending[slot]];
+        size_t needed = root_length + strlen(entry->path) + 2;
+        if (needed > capacity) {
+            char* grown = (char*)realloc(path, needed);
+            if (!grown) {
+                __atomic_store_n(&job->error, ENOMEM, __ATOMIC_RELAXED);
+                break;
+            }
+            path = grown;
+            capacity = needed;
+        }
+        snprintf(path, capacity, "%s/%s", job->root, entry->path);
+        if (fingerprint_hash_file(path, &entry->hash) != 0) {
+            // A file deleted since the walk is reported as removed
+            int error = errno;
+            entry->size = UINT64_MAX;
+            if (error != ENOENT) {
+                __atomic_store_n(&job->error, error, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    free(path);
+} // end of func
+
+// Collect the regular files below dir_fd into the manifest
+static int fingerprint_walk(int dir_fd, char** prefix, size_t prefix_length, size_t* prefix_capacity,
+                            cfingerprint_manifest* manifest) {
+    int listing = dup(dir_fd);
+    DIR* dir = listing >= 0 ? fdopendir(listing) : NULL;
+    if (!dir) {
+        if (listing >= 0) {
+            close(listing);
+        }
+        return -1;
+    }
+
+    int result = 0;
+    struct dirent* item;
+    while (result == 0 && (item = readdir(dir)) != NULL) {
+        const char* name = item->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        struct stat info;
+        if (fstatat(dir_fd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue; // vanished during the walk
+        }
+        if (!S_ISREG(info.st_mode) && !S_ISDIR(info.st_mode)) {
+            continue;
+        }
+
+        size_t name_length = strlen(name);
+        size_t needed = prefix_length + name_length + 2;
+        if (needed > *prefix_capacity) {
+            size_t capacity = needed * 2;
+            char* grown = (char*)realloc(*prefix, capacity);
+            if (!grown) {
+                errno = ENOMEM;
+                result = -1;
+                break;
+            }
+            *prefix = grown;
+            *prefix_capacity = capacity;
+        }
+        memcpy(*prefix + prefix_length, name, name_length + 1);
+
+        if (S_ISDIR(info.st_mode)) {
+            int child = openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (child < 0) {
+                if (errno == ENOENT) {
+                    continue; // vanished during the walk
+                }
+                // Skipping it would report every file below as removed
+                result = -1;
+                break;
+            }
+            (*prefix)[prefix_length + name_length] = '/';
+            result = fingerprint_walk(child, prefix, prefix_length + name_length + 1, prefix_capacity, manifest);
+            close(child);
+            continue;
+        }
+
+        cfingerprint_entry entry;
+        entry.path = (char*)malloc(prefix_length + name_length + 1);
+        if (!entry.path) {
+            errno = ENOMEM;
+            result = -1;
+            break;
+        }
+        memcpy(entry.path, *prefix, prefix_length + name_length + 1);
+        entry.inode = (uint64_t)info.st_ino;
+        entry.size = (uint64_t)info.st_size;
+#ifdef __APPLE__
+        entry.mtime_sec = (int64_t)info.st_mtimespec.tv_sec;
+        entry.mtime_nsec = (long)info.st_mtimespec.tv_nsec;
+#else
+        entry.mtime_sec = (int64_t)info.st_mtim.tv_sec;
+        entry.mtime_nsec = (long)info.st_mtim.tv_nsec;
+#endif
+        entry.hash = 0;
+        if (fingerprint_append(manifest, &entry) != 0) {
+            free(entry.path);
+            result = -1;
+        }
+    }
+    closedir(dir);
+    return result;
+} // end of func
+
+// Merge-walk two sorted manifests into added, removed and modified lists
+static int fingerprint_compare_manifests(const cfingerprint_manifest* previous, const cfingerprint_manifest* current,
+                                         cfingerprint_diff* diff) {
+    size_t i = 0;
+    size_t j = 0;
+    size_t old_count = previous ? previous->count : 0;
+    while (i < old_count || j < current->count) {
+        int order;
+        if (i == old_count) {
+            order = 1;
+        } else if (j == current->count) {
+            order = -1;
+        } else {
+            order = strcmp(previous->entries[i].path, current->entries[j].path);
+        }
+
+        int result = 0;
+        if (order < 0) {
+            result = fingerprint_list_push(&diff->removed, &diff->removed_count, previous->entries[i++].path);
+        } else if (order > 0) {
+            result = fingerprint_list_push(&diff->added, &diff->added_count, current->entries[j++].path);
+        } else {
+            if (previous->entries[i].hash != current->entries[j].hash) {
+                result = fingerprint_list_push(&diff->modified, &diff->modified_count, current->entries[j].path);
+            }
+            ++i;
+            ++j;
+        }
+        if (result != 0) {
+            return -1;
+        }
+    }
+    return 0;
+} // end of func
+#endif
+
+// Function to hash every regular file below a directory
+int fscl_fingerprint_scan(const char* root, const cfingerprint_manifest* previous,
+                          cfingerprint_manifest* current, cfingerprint_diff* diff, int threads) {
+    if (!root || !current) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(current, 0, sizeof(*current));
+    if (diff) {
+        memset(diff, 0, sizeof(*diff));
+    }
+#ifdef _WIN32
+    (void)previous;
+    (void)threads;
+    errno = ENOSYS;
+    return -1;
+#else
+    int root_fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) {
+        return -1;
+    }
+    char* prefix = NULL;
+    size_t prefix_capacity = 0;
+    int result = fingerprint_walk(root_fd, &prefix, 0, &prefix_capacity, current);
+    free(prefix);
+    close(root_fd);
+    if (result != 0) {
+        fscl_fingerprint_manifest_erase(current);
+        return -1;
+    }
+    qsort(current->entries, current->count, sizeof(cfingerprint_entry), fingerprint_compare);
+
+    // Reuse hashes of files whose identity and metadata did not change
+    fingerprint_job job;
+    memset(&job, 0, sizeof(job));
+    job.root = root;
+    job.manifest = current;
+    job.pending = (size_t*)malloc((current->count ? current->count : 1) * sizeof(size_t));
+    if (!job.pending) {
+        fscl_fingerprint_manifest_erase(current);
+        errno = ENOMEM;
+        return -1;
+    }
+    size_t reused = 0;
+    for (size_t i = 0; i < current->count; ++i) {
+        cfingerprint_entry* entry = &current->entries[i];
+        const cfingerprint_entry* known = fingerprint_find(previous, entry->path);
+        if (known && known->inode == entry->inode && known->size == entry->size &&
+            known->mtime_sec == entry->mtime_sec && known->mtime_nsec == entry->mtime_nsec) {
+            entry->hash = known->hash;
+            ++reused;
+        } else {
+            job.pending[job.pending_count++] = i;
+        }
+    }
+
+    if (job.pending_count > 0) {
+        fscl_workers* workers = fscl_workers_create(threads);
+        if (!workers) {
+            free(job.pending);
+            fscl_fingerprint_manifest_erase(current);
+            errno = ENOMEM;
+            return -1;
+        }
+        int count = fscl_workers_count(workers);
+        for (int i = 0; i < (count ? count : 1); ++i) {
+            fscl_workers_submit(workers, fingerprint_worker, &job);
+        }
+        fscl_workers_erase(workers);
+    }
+    free(job.pending);
+
+    // Drop files that disappeared before they could be hashed
+    size_t kept = 0;
+    for (size_t i = 0; i < current->count; ++i) {
+        if (current->entries[i].size == UINT64_MAX) {
+            free(current->entries[i].path);
+            continue;
+        }
+        current->entries[kept++] = current->entries[i];
+    }
+    current->count = kept;
+
+    if (job.error != 0) {
+        fscl_fingerprint_manifest_erase(current);
+        errno = job.error;
+        return -1;
+    }
+    if (diff) {
+        diff->hashed = job.pending_count;
+        diff->reused = reused;
+        if (fingerprint_compare_manifests(previous, current, diff) != 0) {
+            fscl_fingerprint_diff_erase(diff);
+            fscl_fingerprint_manifest_erase(current);
+            return -1;
+        }
+    }
+    return 0;
+#endif
+} // end of func
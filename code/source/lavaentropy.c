@@ -0,0 +1,455 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#ifdef _WIN32
+#define _CRT_RAND_S
+#endif
+#include "fossil/xutil/lavaentropy.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/random.h>)
+#include <sys/random.h>
+#define LAVAENTROPY_GETRANDOM 1
+#endif
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define LAVAENTROPY_THREAD_LOCAL __declspec(thread)
+#else
+#define LAVAENTROPY_THREAD_LOCAL _Thread_local
+#endif
+
+// Blocks generated per refill of a thread buffer, the first becomes the next key
+#define LAVAENTROPY_BLOCKS 16
+#define LAVAENTROPY_BUFFER (LAVAENTROPY_BLOCKS * LAVAENTROPY_BLOCK_SIZE)
+
+// Bytes a thread stream hands out before it pulls a new key from the pool
+#define LAVAENTROPY_RESEED ((size_t)256 * 1024)
+
+// Timer readings mixed in per reseed
+#define LAVAENTROPY_JITTER 32
+
+// Per-thread ChaCha20 stream
+typedef struct {
+    unsigned char key[LAVAENTROPY_KEY_SIZE];
+    unsigned char buffer[LAVAENTROPY_BUFFER];
+    size_t available;   // unread bytes at the end of buffer
+    size_t generated;   // bytes handed out since the last reseed
+    uint64_t epoch;     // fork epoch the key was drawn in
+    int seeded;
+} lavaentropy_stream;
+
+static LAVAENTROPY_THREAD_LOCAL lavaentropy_stream lavaentropy_local;
+
+// Shared pool, guarded by a spin lock that is also held across fork
+static clavahash lavaentropy_pool;
+static int lavaentropy_pool_ready = 0;
+static char lavaentropy_lock = 0;
+
+// Bumped in the child after every fork so threads drop inherited keys
+static uint64_t lavaentropy_epoch = 0;
+
+// Clear memory that held key material, kept even though it is not read again
+static void lavaentropy_wipe(void* data, size_t length) {
+    memset(data, 0, length);
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : : "r"(data) : "memory");
+#else
+    volatile unsigned char* cursor = (volatile unsigned char*)data;
+    while (length--) {
+        *cursor++ = 0;
+    }
+#endif
+} // end of func
+
+static void lavaentropy_acquire(void) {
+    while (__atomic_test_and_set(&lavaentropy_lock, __ATOMIC_ACQUIRE)) {
+        // spin, the pool is only held to mix or extract a few blocks
+    }
+} // end of func
+
+static void lavaentropy_release(void) {
+    __atomic_clear(&lavaentropy_lock, __ATOMIC_RELEASE);
+} // end of func
+
+#ifndef _WIN32
+static void lavaentropy_fork_prepare(void) {
+    lavaentropy_acquire();
+} // end of func
+
+static void lavaentropy_fork_parent(void) {
+    lavaentropy_release();
+} // end of func
+
+static void lavaentropy_fork_child(void) {
+    __atomic_add_fetch(&lavaentropy_epoch, 1, __ATOMIC_RELAXED);
+    lavaentropy_release();
+} // end of func
+#endif
+
+// =================================================================
+// ChaCha20
+// =================================================================
+
+static inline uint32_t lavaentropy_rotl(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+} // end of func
+
+static inline uint32_t lavaentropy_load32(const unsigned char* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+} // end of func
+
+static inline void lavaentropy_store32(unsigned char* data, uint32_t value) {
+    data[0] = (unsigned char)value;
+    data[1] = (unsigned char)(value >> 8);
+    data[2] = (unsigned char)(value >> 16);
+    data[3] = (unsigned char)(value >> 24);
+} // end of func
+
+#define LAVAENTROPY_QUARTER(a, b, c, d)                  \
+    do {                                                 \
+        a += b;                                          \
+        d = lavaentropy_rotl(d ^ a, 16);                 \
+        c += d;                                          \
+        b = lavaentropy_rotl(b ^ c, 12);                 \
+        a += b;                                          \
+        d = lavaentropy_rotl(d ^ a, 8);                  \
+        c += d;                                          \
+        b = lavaentropy_rotl(b ^ c, 7);                  \
+    } while (0)
+
+// Key stream block from an expanded input state
+static void lavaentropy_block(const uint32_t input[16], unsigned char out[LAVAENTROPY_BLOCK_SIZE]) {
+    uint32_t x[16];
+    memcpy(x, input, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        LAVAENTROPY_QUARTER(x[0], x[4], x[8], x[12]);
+        LAVAENTROPY_QUARTER(x[1], x[5], x[9], x[13]);
+        LAVAENTROPY_QUARTER(x[2], x[6], x[10], x[14]);
+        LAVAENTROPY_QUARTER(x[3], x[7], x[11], x[15]);
+        LAVAENTROPY_QUARTER(x[0], x[5], x[10], x[15]);
+        LAVAENTROPY_QUARTER(x[1], x[6], x[11], x[12]);
+        LAVAENTROPY_QUARTER(x[2], x[7], x[8], x[13]);
+        LAVAENTROPY_QUARTER(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        lavaentropy_store32(out + i * 4, x[i] + input[i]);
+    }
+    lavaentropy_wipe(x, sizeof(x));
+} // end of func
+
+static void lavaentropy_setup(uint32_t state[16], const unsigned char* key, uint32_t counter, const unsigned char* nonce) {
+    state[0] = 0x61707865u; // "expand 32-byte k"
+    state[1] = 0x3320646Eu;
+    state[2] = 0x79622D32u;
+    state[3] = 0x6B206574u;
+    for (int i = 0; i < 8; ++i) {
+        state[4 + i] = lavaentropy_load32(key + i * 4);
+    }
+    state[12] = counter;
+    for (int i = 0; i < 3; ++i) {
+        state[13 + i] = lavaentropy_load32(nonce + i * 4);
+    }
+} // end of func
+
+// Function to compute one ChaCha20 block
+void fscl_lavaentropy_chacha20(const unsigned char key[LAVAENTROPY_KEY_SIZE], uint32_t counter,
+                               const unsigned char nonce[LAVAENTROPY_NONCE_SIZE],
+                               unsigned char out[LAVAENTROPY_BLOCK_SIZE]) {
+    uint32_t state[16];
+    lavaentropy_setup(state, key, counter, nonce);
+    lavaentropy_block(state, out);
+    lavaentropy_wipe(state, sizeof(state));
+} // end of func
+
+// Fast key erasure: block 0 of the current key becomes the next key and
+// blocks 1..count go to out, so the old key is gone once out is written
+static void lavaentropy_generate(unsigned char key[LAVAENTROPY_KEY_SIZE], unsigned char* out, size_t count) {
+    static const unsigned char nonce[LAVAENTROPY_NONCE_SIZE] = { 0 };
+    unsigned char next[LAVAENTROPY_BLOCK_SIZE];
+    uint32_t state[16];
+    lavaentropy_setup(state, key, 0, nonce);
+    lavaentropy_block(state, next);
+    for (size_t i = 0; i < count; ++i) {
+        state[12] = (uint32_t)(i + 1);
+        lavaentropy_block(state, out + i * LAVAENTROPY_BLOCK_SIZE);
+    }
+    memcpy(key, next, LAVAENTROPY_KEY_SIZE);
+    lavaentropy_wipe(next, sizeof(next));
+    lavaentropy_wipe(state, sizeof(state));
+} // end of func
+
+// =================================================================
+// Entropy pool
+// =================================================================
+
+// Read bytes from the operating system source
+static int lavaentropy_system(unsigned char* out, size_t length) {
+#ifdef _WIN32
+    while (length > 0) {
+        unsigned int value;
+        if (rand_s(&value) != 0) {
+            errno = EIO;
+            return -1;
+        }
+        size_t take = length < sizeof(value) ? length : sizeof(value);
+        memcpy(out, &value, take);
+        out += take;
+        length -= take;
+    }
+    return 0;
+#else
+#ifdef LAVAENTROPY_GETRANDOM
+    while (length > 0) {
+        ssize_t n = getrandom(out, length, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOSYS) {
+                break; // kernel without getrandom, use the device below
+            }
+            return -1;
+        }
+        out += n;
+        length -= (size_t)n;
+    }
+    if (length == 0) {
+        return 0;
+    }
+#endif
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    while (length > 0) {
+        ssize_t n = read(fd, out, length);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n == 0) {
+                errno = EIO;
+            }
+            close(fd);
+            return -1;
+        }
+        out += n;
+        length -= (size_t)n;
+    }
+    close(fd);
+    return 0;
+#endif
+} // end of func
+
+static uint64_t lavaentropy_ticks(void) {
+#ifdef _WIN32
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (uint64_t)now.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+} // end of func
+
+// Timer readings around a little dependent work, the low bits wander
+// with cache, branch predictor and scheduler state
+static void lavaentropy_jitter(uint64_t samples[LAVAENTROPY_JITTER]) {
+    volatile uint64_t work = 0;
+    for (int i = 0; i < LAVAENTROPY_JITTER; ++i) {
+        uint64_t start = lavaentropy_ticks();
+        for (int j = 0; j < 64 + (int)(start & 63); ++j) {
+            work = work * 6364136223846793005ull + (uint64_t)j;
+        }
+        samples[i] = lavaentropy_ticks() - start + (start << 32);
+    }
+} // end of func
+
+// Fill the pool the first time it is used, called with the lock held
+static void lavaentropy_pool_init(void) {
+    // The lamps move on a private generator so the thread generator a
+    // caller may have seeded with fscl_lava_seed is left alone
+    clavalamp lamps[16] = {{0.0, 0.0}};
+    clavarng rng;
+    uint64_t seed;
+    if (lavaentropy_system((unsigned char*)&seed, sizeof(seed)) != 0) {
+        seed = lavaentropy_ticks();
+    }
+    fscl_lavarng_seed(&rng, LAVARNG_XOSHIRO256, seed);
+    for (int i = 0; i < 16; ++i) {
+        lamps[i].position += fscl_lavarng_double(&rng) - 0.5;
+        lamps[i].velocity += fscl_lavarng_double(&rng) - 0.5;
+    }
+    fscl_lava_hash_init(&lavaentropy_pool, LAVA_HASH_STRONG, 0);
+    fscl_lava_hash_lamps(&lavaentropy_pool, lamps, 16);
+    lavaentropy_wipe(&seed, sizeof(seed));
+    lavaentropy_wipe(&rng, sizeof(rng));
+    lavaentropy_wipe(lamps, sizeof(lamps));
+#ifndef _WIN32
+    pthread_atfork(lavaentropy_fork_prepare, lavaentropy_fork_parent, lavaentropy_fork_child);
+#endif
+    lavaentropy_pool_ready = 1;
+} // end of func
+
+// Draw a stream key from the pool and replace the pool by a one-way
+// function of itself, called with the lock held
+static void lavaentropy_extract(unsigned char key[LAVAENTROPY_KEY_SIZE]) {
+    static const unsigned char output = 1;
+    static const unsigned char next = 2;
+    unsigned char digest[FSCL_LAVA_HASH_SIZE];
+    clavahash branch = lavaentropy_pool;
+
+    fscl_lava_hash_update(&branch, &output, 1);
+    fscl_lava_hash_final(&branch, key);
+
+    fscl_lava_hash_update(&lavaentropy_pool, &next, 1);
+    fscl_lava_hash_final(&lavaentropy_pool, digest);
+    fscl_lava_hash_init(&lavaentropy_pool, LAVA_HASH_STRONG, 0);
+    fscl_lava_hash_update(&lavaentropy_pool, digest, sizeof(digest));
+
+    lavaentropy_wipe(digest, sizeof(digest));
+    lavaentropy_wipe(&branch, sizeof(branch));
+} // end of func
+
+// Function to mix bytes into the shared entropy pool
+void fscl_lavaentropy_mix(const void* data, size_t length) {
+    lavaentropy_acquire();
+    if (!lavaentropy_pool_ready) {
+        lavaentropy_pool_init();
+    }
+    fscl_lava_hash_update(&lavaentropy_pool, data, length);
+    lavaentropy_release();
+} // end of func
+
+// Function to mix the state of multiple lava lamps into the shared entropy pool
+void fscl_lavaentropy_mix_lamps(const clavalamp* lamps, int numLamps) {
+    if (numLamps > 0) {
+        fscl_lavaentropy_mix(lamps, (size_t)numLamps * sizeof(clavalamp));
+    }
+} // end of func
+
+// =================================================================
+// Thread streams
+// =================================================================
+
+// Key the stream of the calling thread from fresh system bytes, jitter and the pool
+static int lavaentropy_reseed(lavaentropy_stream* stream) {
+    struct {
+        unsigned char system[32];
+        uint64_t jitter[LAVAENTROPY_JITTER];
+        uint64_t process;
+        const void* thread;
+    } fresh;
+    if (lavaentropy_system(fresh.system, sizeof(fresh.system)) != 0) {
+        return -1;
+    }
+    lavaentropy_jitter(fresh.jitter);
+#ifdef _WIN32
+    fresh.process = (uint64_t)_getpid();
+#else
+    fresh.process = (uint64_t)getpid();
+#endif
+    fresh.thread = stream;
+
+    lavaentropy_acquire();
+    if (!lavaentropy_pool_ready) {
+        lavaentropy_pool_init();
+    }
+    stream->epoch = __atomic_load_n(&lavaentropy_epoch, __ATOMIC_RELAXED);
+    fscl_lava_hash_update(&lavaentropy_pool, &fresh, sizeof(fresh));
+    lavaentropy_extract(stream->key);
+    lavaentropy_release();
+
+    lavaentropy_wipe(&fresh, sizeof(fresh));
+    lavaentropy_wipe(stream->buffer, sizeof(stream->buffer));
+    stream->available = 0;
+    stream->generated = 0;
+    stream->seeded = 1;
+    return 0;
+} // end of func
+
+// Function to fill a buffer with cryptographically secure random bytes
+int fscl_lavaentropy_bytes(void* out, size_t length) {
+    lavaentropy_stream* stream = &lavaentropy_local;
+    unsigned char* cursor = (unsigned char*)out;
+    if (!out && length > 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    while (length > 0) {
+        if (!stream->seeded || stream->generated >= LAVAENTROPY_RESEED ||
+            stream->epoch != __atomic_load_n(&lavaentropy_epoch, __ATOMIC_RELAXED)) {
+            if (lavaentropy_reseed(stream) != 0) {
+                return -1;
+            }
+        }
+
+        // Large requests bypass the buffer, whole blocks go straight to the caller
+        if (stream->available == 0 && length >= LAVAENTROPY_BUFFER) {
+            size_t blocks = length / LAVAENTROPY_BLOCK_SIZE;
+            size_t limit = (LAVAENTROPY_RESEED - stream->generated) / LAVAENTROPY_BLOCK_SIZE;
+            if (blocks > limit) {
+                blocks = limit > 0 ? limit : 1;
+            }
+            lavaentropy_generate(stream->key, cursor, blocks);
+            cursor += blocks * LAVAENTROPY_BLOCK_SIZE;
+            length -= blocks * LAVAENTROPY_BLOCK_SIZE;
+            stream->generated += blocks * LAVAENTROPY_BLOCK_SIZE;
+            continue;
+        }
+
+        if (stream->available == 0) {
+            lavaentropy_generate(stream->key, stream->buffer, LAVAENTROPY_BLOCKS);
+            stream->available = LAVAENTROPY_BUFFER;
+        }
+        size_t take = length < stream->available ? length : stream->available;
+        unsigned char* source = stream->buffer + (LAVAENTROPY_BUFFER - stream->available);
+        memcpy(cursor, source, take);
+        lavaentropy_wipe(source, take);
+        stream->available -= take;
+        stream->generated += take;
+        cursor += take;
+        length -= take;
+    }
+    return 0;
+} // end of func
+
+// Function to generate 64 cryptographically secure random bits
+int fscl_lavaentropy_u64(uint64_t* value) {
+    if (!value) {
+        errno = EINVAL;
+        return -1;
+    }
+    return fscl_lavaentropy_bytes(value, sizeof(*value));
+} // end of func
+
+// Function to reseed the stream of the calling thread
+int fscl_lavaentropy_reseed(void) {
+    return lavaentropy_reseed(&lavaentropy_local);
+} // end of func
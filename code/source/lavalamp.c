@@ -11,16 +11,53 @@ Description:
 ==============================================================================
 */
 #include "fossil/xutil/lavalamp.h"
+#include "fossil/xutil/lavarng.h"
+#include "workers.h"
+#include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LAVA_X86 1
+#include <immintrin.h>
+#endif
+
+// Alignment of the arrays of a lamp field, one cache line
+#define LAVA_FIELD_ALIGN 64
+
+#ifdef _WIN32
+#include <malloc.h>
+#define lava_aligned_alloc(size) _aligned_malloc(size, LAVA_FIELD_ALIGN)
+#define lava_aligned_free _aligned_free
+#else
+#define lava_aligned_alloc(size) aligned_alloc(LAVA_FIELD_ALIGN, size)
+#define lava_aligned_free free
+#endif
+
 // Function to capture the state of a virtual lava lamp
 void fscl_lava_capture_state(clavalamp* lamp) {
     // Simulate some changes in position and velocity (replace with your simulation logic)
-    lamp->position += ((double)rand() / RAND_MAX) - 0.5;
-    lamp->velocity += ((double)rand() / RAND_MAX) - 0.5;
+    clavarng* rng = fscl_lavarng_thread();
+    lamp->position += fscl_lavarng_double(rng) - 0.5;
+    lamp->velocity += fscl_lavarng_double(rng) - 0.5;
+}
+
+// Add noise in [-0.5, 0.5) to the position and velocity of every lamp,
+// drawn in bulk in the order fscl_lava_capture_state would draw it
+static void lava_perturb(clavalamp* lamps, int numLamps) {
+    double noise[256];
+    clavarng* rng = fscl_lavarng_thread();
+    for (int i = 0; i < numLamps; i += 128) {
+        int count = numLamps - i < 128 ? numLamps - i : 128;
+        fscl_lavarng_fill_double(rng, noise, (size_t)count * 2);
+        for (int j = 0; j < count; ++j) {
+            lamps[i + j].position += noise[2 * j] - 0.5;
+            lamps[i + j].velocity += noise[2 * j + 1] - 0.5;
+        }
+    }
 }
 
 // Function to combine the states of multiple virtual lava lamps
@@ -46,9 +83,8 @@ clavalamp* fscl_lava_create(int numLamps) {
         exit(EXIT_FAILURE);
     }
 
-    for (int i = 0; i < numLamps; ++i) {
-        fscl_lava_capture_state(&lamps[i]);
-    }
+    fscl_lava_reset(lamps, numLamps);
+    lava_perturb(lamps, numLamps);
 
     return lamps;
 }
@@ -114,17 +150,477 @@ void fscl_lava_reset(clavalamp* lamps, int numLamps) {
 
 // Function to randomize the state of virtual lava lamps for variety or experimentation
 void fscl_lava_randomize(clavalamp* lamps, int numLamps) {
-    for (int i = 0; i < numLamps; ++i) {
-        fscl_lava_capture_state(&lamps[i]);
-    }
+    lava_perturb(lamps, numLamps);
 }
 
-// Function to initialize the random number generator with a seed
+// Function to initialize the random number generator of the calling thread with a seed
 void fscl_lava_seed(unsigned int seed) {
-    srand(seed);
+    fscl_lavarng_seed(fscl_lavarng_thread(), LAVARNG_XOSHIRO256, seed);
 }
 
-// Function to generate a random number
+// Function to generate a random number from the generator of the calling thread
 int fscl_lava_random(void) {
-    return rand();
+    return (int)(fscl_lavarng_next(fscl_lavarng_thread()) >> 33);
+}
+
+// Function to create a lamp field
+int fscl_lava_field_create(clavafield* field, size_t count) {
+    field->position = NULL;
+    field->velocity = NULL;
+    field->count = 0;
+    if (count == 0) {
+        return 0;
+    }
+    // Both arrays share one block, the second starts on a cache line too
+    size_t per_line = LAVA_FIELD_ALIGN / sizeof(double);
+    if (count > SIZE_MAX / (2 * sizeof(double)) - per_line) {
+        errno = ENOMEM;
+        return -1;
+    }
+    size_t stride = (count + per_line - 1) / per_line * per_line;
+    double* block = lava_aligned_alloc(2 * stride * sizeof(double));
+    if (!block) {
+        errno = ENOMEM;
+        return -1;
+    }
+    field->position = block;
+    field->velocity = block + stride;
+    field->count = count;
+    fscl_lava_field_reset(field);
+    return 0;
+}
+
+// Function to erase a lamp field
+void fscl_lava_field_erase(clavafield* field) {
+    if (field) {
+        lava_aligned_free(field->position);
+        field->position = NULL;
+        field->velocity = NULL;
+        field->count = 0;
+    }
+}
+
+// Function to copy lamps into a field
+void fscl_lava_field_load(clavafield* field, const clavalamp* lamps) {
+    for (size_t i = 0; i < field->count; ++i) {
+        field->position[i] = lamps[i].position;
+        field->velocity[i] = lamps[i].velocity;
+    }
+}
+
+// Function to copy the lamps of a field out
+void fscl_lava_field_store(const clavafield* field, clavalamp* lamps) {
+    for (size_t i = 0; i < field->count; ++i) {
+        lamps[i].position = field->position[i];
+        lamps[i].velocity = field->velocity[i];
+    }
+}
+
+// Function to put every lamp of a field back at rest
+void fscl_lava_field_reset(clavafield* field) {
+    if (field->count > 0) {
+        memset(field->position, 0, field->count * sizeof(double));
+        memset(field->velocity, 0, field->count * sizeof(double));
+    }
+}
+
+static void lava_add_noise(double* restrict values, const double* restrict noise, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        values[i] += noise[i] - 0.5;
+    }
+}
+
+// Function to add noise to every lamp of a field
+void fscl_lava_field_randomize(clavafield* field, clavarng_lanes* lanes) {
+    double noise[256];
+    clavarng* rng = lanes ? NULL : fscl_lavarng_thread();
+    double* arrays[2] = {field->position, field->velocity};
+    for (int a = 0; a < 2; ++a) {
+        for (size_t i = 0; i < field->count; i += 256) {
+            size_t count = field->count - i < 256 ? field->count - i : 256;
+            if (lanes) {
+                fscl_lavarng_lanes_fill_double(lanes, noise, count);
+            } else {
+                fscl_lavarng_fill_double(rng, noise, count);
+            }
+            lava_add_noise(arrays[a] + i, noise, count);
+        }
+    }
+}
+
+// Portable kernels, also used for the tail the vector kernels leave
+static void lava_step_scalar(double* restrict position, const double* restrict velocity, size_t begin, size_t end,
+                             double dt) {
+    for (size_t i = begin; i < end; ++i) {
+        position[i] += velocity[i] * dt;
+    }
+}
+
+static void lava_analyze_scalar(const double* position, const double* velocity, size_t begin, size_t end,
+                                clavafield_report* report) {
+    for (size_t i = begin; i < end; ++i) {
+        double p = fabs(position[i]);
+        double v = fabs(velocity[i]);
+        report->extreme_position += p > 10.0;
+        report->extreme_velocity += v > 5.0;
+        report->stagnant += v < 0.1;
+        report->erratic += v > 2.0 && p > 5.0;
+        report->consistent += v > 0.1 && p < 5.0;
+    }
+}
+
+#ifdef LAVA_X86
+__attribute__((target("avx2"))) static size_t lava_step_avx2(double* position, const double* velocity, size_t count,
+                                                             double dt) {
+    __m256d step = _mm256_set1_pd(dt);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d p = _mm256_load_pd(position + i);
+        __m256d v = _mm256_load_pd(velocity + i);
+        _mm256_store_pd(position + i, _mm256_add_pd(p, _mm256_mul_pd(v, step)));
+    }
+    return i;
+}
+
+// Count lanes by subtracting the all-ones compare masks from 64-bit counters
+__attribute__((target("avx2"))) static size_t lava_analyze_avx2(const double* position, const double* velocity,
+                                                                size_t count, clavafield_report* report) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d ten = _mm256_set1_pd(10.0), five = _mm256_set1_pd(5.0);
+    const __m256d two = _mm256_set1_pd(2.0), tenth = _mm256_set1_pd(0.1);
+    __m256i extreme_position = _mm256_setzero_si256(), extreme_velocity = _mm256_setzero_si256();
+    __m256i stagnant = _mm256_setzero_si256(), erratic = _mm256_setzero_si256();
+    __m256i consistent = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d p = _mm256_andnot_pd(sign, _mm256_load_pd(position + i));
+        __m256d v = _mm256_andnot_pd(sign, _mm256_load_pd(velocity + i));
+        __m256d p_over_five = _mm256_cmp_pd(p, five, _CMP_GT_OQ);
+        __m256d p_under_five = _mm256_cmp_pd(p, five, _CMP_LT_OQ);
+        __m256d v_over_tenth = _mm256_cmp_pd(v, tenth, _CMP_GT_OQ);
+        extreme_position = _mm256_sub_epi64(extreme_position, _mm256_castpd_si256(_mm256_cmp_pd(p, ten, _CMP_GT_OQ)));
+        extreme_velocity = _mm256_sub_epi64(extreme_velocity, _mm256_castpd_si256(_mm256_cmp_pd(v, five, _CMP_GT_OQ)));
+        stagnant = _mm256_sub_epi64(stagnant, _mm256_castpd_si256(_mm256_cmp_pd(v, tenth, _CMP_LT_OQ)));
+        erratic = _mm256_sub_epi64(
+            erratic, _mm256_castpd_si256(_mm256_and_pd(_mm256_cmp_pd(v, two, _CMP_GT_OQ), p_over_five)));
+        consistent = _mm256_sub_epi64(consistent, _mm256_castpd_si256(_mm256_and_pd(v_over_tenth, p_under_five)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, extreme_position);
+    report->extreme_position += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    _mm256_storeu_si256((__m256i*)lanes, extreme_velocity);
+    report->extreme_velocity += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    _mm256_storeu_si256((__m256i*)lanes, stagnant);
+    report->stagnant += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    _mm256_storeu_si256((__m256i*)lanes, erratic);
+    report->erratic += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    _mm256_storeu_si256((__m256i*)lanes, consistent);
+    report->consistent += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return i;
+}
+
+static int lava_avx2 = -1;
+
+static int lava_has_avx2(void) {
+    int supported = __atomic_load_n(&lava_avx2, __ATOMIC_RELAXED);
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&lava_avx2, supported, __ATOMIC_RELAXED);
+    }
+    return supported;
+}
+#endif
+
+// Move the lamps of [begin, end), begin being a multiple of 4
+static void lava_step_range(clavafield* field, size_t begin, size_t end, double dt) {
+    size_t done = begin;
+#ifdef LAVA_X86
+    if (lava_has_avx2()) {
+        done += lava_step_avx2(field->position + begin, field->velocity + begin, end - begin, dt);
+    }
+#endif
+    lava_step_scalar(field->position, field->velocity, done, end, dt);
+}
+
+// Function to move every lamp along its velocity
+void fscl_lava_field_step(clavafield* field, double dt) {
+    lava_step_range(field, 0, field->count, dt);
+}
+
+// Function to count the lamps of a field in each category
+void fscl_lava_field_analyze(const clavafield* field, clavafield_report* report) {
+    memset(report, 0, sizeof(*report));
+    size_t done = 0;
+#ifdef LAVA_X86
+    if (lava_has_avx2()) {
+        done = lava_analyze_avx2(field->position, field->velocity, field->count, report);
+    }
+#endif
+    lava_analyze_scalar(field->position, field->velocity, done, field->count, report);
+}
+
+// One chunk of a parallel simulation
+typedef struct {
+    clavafield* field;
+    uint64_t seed;
+    uint64_t first_step;
+    size_t steps;
+    double dt;
+    size_t chunk;
+} lava_chunk_task;
+
+// Simulate one chunk for every step. The noise of lamp i of chunk c at
+// step t is Philox block (t * FSCL_LAVA_CHUNK + i, c), so the result does
+// not depend on which thread runs the chunk or in which order.
+static void lava_simulate_chunk(void* arg) {
+    lava_chunk_task* task = arg;
+    clavafield* field = task->field;
+    size_t begin = task->chunk * FSCL_LAVA_CHUNK;
+    size_t end = begin + FSCL_LAVA_CHUNK < field->count ? begin + FSCL_LAVA_CHUNK : field->count;
+    size_t count = end - begin;
+    double noise[2 * FSCL_LAVA_CHUNK];
+    clavarng rng;
+    fscl_lavarng_seed(&rng, LAVARNG_PHILOX, task->seed);
+    for (size_t t = 0; t < task->steps; ++t) {
+        rng.s.philox.counter_lo = (task->first_step + t) * FSCL_LAVA_CHUNK;
+        rng.s.philox.counter_hi = task->chunk;
+        rng.s.philox.available = 0;
+        fscl_lavarng_fill_double(&rng, noise, 2 * count);
+        for (size_t i = 0; i < count; ++i) {
+            field->position[begin + i] += noise[2 * i] - 0.5;
+            field->velocity[begin + i] += noise[2 * i + 1] - 0.5;
+        }
+        lava_step_range(field, begin, end, task->dt);
+    }
+}
+
+// Function to simulate a lamp field on several threads
+int fscl_lava_field_simulate(clavafield* field, uint64_t seed, uint64_t first_step, size_t steps, double dt,
+                             int threads) {
+    size_t chunks = (field->count + FSCL_LAVA_CHUNK - 1) / FSCL_LAVA_CHUNK;
+    if (chunks == 0 || steps == 0) {
+        return 0;
+    }
+    lava_chunk_task* tasks = malloc(chunks * sizeof(lava_chunk_task));
+    if (!tasks) {
+        errno = ENOMEM;
+        return -1;
+    }
+    for (size_t c = 0; c < chunks; ++c) {
+        tasks[c].field = field;
+        tasks[c].seed = seed;
+        tasks[c].first_step = first_step;
+        tasks[c].steps = steps;
+        tasks[c].dt = dt;
+        tasks[c].chunk = c;
+    }
+
+    fscl_workers* pool = NULL;
+    if (threads != 1 && chunks > 1) {
+        pool = fscl_workers_create(threads);
+    }
+    for (size_t c = 0; c < chunks; ++c) {
+        // Chunks the pool cannot take run on the calling thread
+        if (!pool || fscl_workers_submit(pool, lava_simulate_chunk, &tasks[c]) != 0) {
+            lava_simulate_chunk(&tasks[c]);
+        }
+    }
+    if (pool) {
+        fscl_workers_wait(pool);
+        fscl_workers_erase(pool);
+    }
+    free(tasks);
+    return 0;
+}
+
+// BLAKE2b initialization vector (the SHA-512 IV)
+static const uint64_t lava_blake2b_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+// BLAKE2b message schedule
+static const unsigned char lava_blake2b_sigma[12][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+    { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+    { 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+    { 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+    { 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+    { 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+    { 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+    { 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+    { 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+static inline uint64_t lava_rotr64(uint64_t value, int bits) {
+    return (value >> bits) | (value << (64 - bits));
+}
+
+static inline uint64_t lava_load64(const unsigned char* data) {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+#define LAVA_BLAKE2B_G(a, b, c, d, x, y)      \
+    do {                                      \
+        a = a + b + (x);                      \
+        d = lava_rotr64(d ^ a, 32);           \
+        c = c + d;                            \
+        b = lava_rotr64(b ^ c, 24);           \
+        a = a + b + (y);                      \
+        d = lava_rotr64(d ^ a, 16);           \
+        c = c + d;                            \
+        b = lava_rotr64(b ^ c, 63);           \
+    } while (0)
+
+// Compress one 128-byte block into the chaining value
+static void lava_blake2b_compress(uint64_t h[8], const uint64_t total[2], const unsigned char* block, int last) {
+    uint64_t m[16];
+    uint64_t v[16];
+    for (int i = 0; i < 16; ++i) {
+        m[i] = lava_load64(block + i * 8);
+    }
+    for (int i = 0; i < 8; ++i) {
+        v[i] = h[i];
+        v[i + 8] = lava_blake2b_iv[i];
+    }
+    v[12] ^= total[0];
+    v[13] ^= total[1];
+    if (last) {
+        v[14] = ~v[14];
+    }
+    for (int r = 0; r < 12; ++r) {
+        const unsigned char* s = lava_blake2b_sigma[r];
+        LAVA_BLAKE2B_G(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        LAVA_BLAKE2B_G(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        LAVA_BLAKE2B_G(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        LAVA_BLAKE2B_G(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        LAVA_BLAKE2B_G(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        LAVA_BLAKE2B_G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        LAVA_BLAKE2B_G(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        LAVA_BLAKE2B_G(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+static inline void lava_blake2b_count(uint64_t total[2], size_t length) {
+    total[0] += length;
+    if (total[0] < length) {
+        total[1]++;
+    }
+}
+
+// Function to start a streaming hash over lamp state
+void fscl_lava_hash_init(clavahash* hash, clavahash_mode mode, uint64_t key) {
+    hash->mode = mode;
+    if (mode == LAVA_HASH_FAST) {
+        fscl_fingerprint_hash_init(&hash->s.fast, key);
+        return;
+    }
+    size_t key_length = key != 0 ? sizeof(key) : 0;
+    memcpy(hash->s.strong.h, lava_blake2b_iv, sizeof(lava_blake2b_iv));
+    hash->s.strong.h[0] ^= 0x01010000ULL ^ ((uint64_t)key_length << 8) ^ FSCL_LAVA_HASH_SIZE;
+    hash->s.strong.total[0] = 0;
+    hash->s.strong.total[1] = 0;
+    memset(hash->s.strong.buffer, 0, sizeof(hash->s.strong.buffer));
+    hash->s.strong.buffered = 0;
+    if (key_length) {
+        // A keyed hash starts with the key padded to a full block
+        for (size_t i = 0; i < key_length; ++i) {
+            hash->s.strong.buffer[i] = (unsigned char)(key >> (8 * i));
+        }
+        hash->s.strong.buffered = sizeof(hash->s.strong.buffer);
+    }
+}
+
+// Function to feed bytes into a streaming hash
+void fscl_lava_hash_update(clavahash* hash, const void* data, size_t length) {
+    if (hash->mode == LAVA_HASH_FAST) {
+        fscl_fingerprint_hash_update(&hash->s.fast, data, length);
+        return;
+    }
+    const unsigned char* cursor = (const unsigned char*)data;
+    unsigned char* buffer = hash->s.strong.buffer;
+    size_t fill = sizeof(hash->s.strong.buffer) - hash->s.strong.buffered;
+
+    // The final block must be compressed with the last flag, so a full
+    // block is only compressed once more input is known to follow
+    if (length > fill) {
+        memcpy(buffer + hash->s.strong.buffered, cursor, fill);
+        lava_blake2b_count(hash->s.strong.total, 128);
+        lava_blake2b_compress(hash->s.strong.h, hash->s.strong.total, buffer, 0);
+        hash->s.strong.buffered = 0;
+        cursor += fill;
+        length -= fill;
+        while (length > 128) {
+            lava_blake2b_count(hash->s.strong.total, 128);
+            lava_blake2b_compress(hash->s.strong.h, hash->s.strong.total, cursor, 0);
+            cursor += 128;
+            length -= 128;
+        }
+    }
+    memcpy(buffer + hash->s.strong.buffered, cursor, length);
+    hash->s.strong.buffered += length;
+}
+
+// Function to feed an array of lava lamps into a streaming hash
+void fscl_lava_hash_lamps(clavahash* hash, const clavalamp* lamps, int numLamps) {
+    if (numLamps > 0) {
+        fscl_lava_hash_update(hash, lamps, (size_t)numLamps * sizeof(clavalamp));
+    }
+}
+
+// Function to feed a lamp field into a streaming hash
+void fscl_lava_hash_field(clavahash* hash, const clavafield* field) {
+    fscl_lava_hash_update(hash, field->position, field->count * sizeof(double));
+    fscl_lava_hash_update(hash, field->velocity, field->count * sizeof(double));
+}
+
+// Function to finish a streaming hash
+size_t fscl_lava_hash_final(const clavahash* hash, unsigned char* out) {
+    if (hash->mode == LAVA_HASH_FAST) {
+        uint64_t value = fscl_fingerprint_hash_digest(&hash->s.fast);
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            out[i] = (unsigned char)(value >> (8 * i));
+        }
+        return sizeof(value);
+    }
+    uint64_t h[8];
+    uint64_t total[2] = { hash->s.strong.total[0], hash->s.strong.total[1] };
+    unsigned char block[128];
+    memcpy(h, hash->s.strong.h, sizeof(h));
+    memcpy(block, hash->s.strong.buffer, hash->s.strong.buffered);
+    memset(block + hash->s.strong.buffered, 0, sizeof(block) - hash->s.strong.buffered);
+    lava_blake2b_count(total, hash->s.strong.buffered);
+    lava_blake2b_compress(h, total, block, 1);
+    for (size_t i = 0; i < FSCL_LAVA_HASH_SIZE; ++i) {
+        out[i] = (unsigned char)(h[i / 8] >> (8 * (i % 8)));
+    }
+    return FSCL_LAVA_HASH_SIZE;
+}
+
+// Function to hash the state of multiple lava lamps with the fast hash
+uint64_t fscl_lava_hash_state(const clavalamp* lamps, int numLamps) {
+    size_t length = numLamps > 0 ? (size_t)numLamps * sizeof(clavalamp) : 0;
+    return fscl_fingerprint_hash64(lamps, length, 0);
+}
+
+// Function to derive a generator seed from the state of multiple lava lamps
+uint64_t fscl_lava_derive_seed(const clavalamp* lamps, int numLamps) {
+    clavahash hash;
+    unsigned char digest[FSCL_LAVA_HASH_SIZE];
+    fscl_lava_hash_init(&hash, LAVA_HASH_STRONG, 0);
+    fscl_lava_hash_lamps(&hash, lamps, numLamps);
+    fscl_lava_hash_final(&hash, digest);
+    return lava_load64(digest);
 }
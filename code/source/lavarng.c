@@ -0,0 +1,758 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/lavarng.h"
+#include <errno.h>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LAVARNG_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define LAVARNG_THREAD_LOCAL __declspec(thread)
+#else
+#define LAVARNG_THREAD_LOCAL _Thread_local
+#endif
+
+// Philox4x32 round multipliers and Weyl key increments
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+// PCG64 multiplier, 0x2360ED051FC65DA44385DF649FCCF645
+#define PCG_MULT_HI 0x2360ED051FC65DA4ull
+#define PCG_MULT_LO 0x4385DF649FCCF645ull
+
+// Values generated at a time when bulk output goes through a buffer
+#define LAVARNG_CHUNK 256
+
+// 53 random bits scaled into [0, 1)
+#define LAVARNG_TO_DOUBLE(x) ((double)((x) >> 11) * 0x1.0p-53)
+
+static inline uint64_t lavarng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+} // end of func
+
+static inline uint64_t lavarng_splitmix(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+} // end of func
+
+// Full 64x64 bit product, the low half is returned
+static inline uint64_t lavarng_mul64(uint64_t a, uint64_t b, uint64_t* hi) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *hi = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    *hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+#endif
+} // end of func
+
+// 128-bit arithmetic for the PCG64 state, kept as two halves
+typedef struct {
+    uint64_t lo, hi;
+} lavarng_u128;
+
+static inline lavarng_u128 lavarng_mul128(lavarng_u128 a, lavarng_u128 b) {
+    lavarng_u128 r;
+    r.lo = lavarng_mul64(a.lo, b.lo, &r.hi);
+    r.hi += a.lo * b.hi + a.hi * b.lo;
+    return r;
+} // end of func
+
+static inline lavarng_u128 lavarng_add128(lavarng_u128 a, lavarng_u128 b) {
+    lavarng_u128 r = {a.lo + b.lo, a.hi + b.hi};
+    r.hi += r.lo < a.lo;
+    return r;
+} // end of func
+
+// =================================================================
+// xoshiro256**
+// =================================================================
+
+static inline uint64_t xoshiro_next(uint64_t s[4]) {
+    uint64_t result = lavarng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = lavarng_rotl(s[3], 45);
+    return result;
+} // end of func
+
+static void xoshiro_jump(uint64_t s[4]) {
+    static const uint64_t jump[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                    0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (jump[i] & ((uint64_t)1 << b)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            xoshiro_next(s);
+        }
+    }
+    s[0] = t[0];
+    s[1] = t[1];
+    s[2] = t[2];
+    s[3] = t[3];
+} // end of func
+
+// =================================================================
+// PCG64 (XSL-RR 128/64)
+// =================================================================
+
+static inline uint64_t pcg_next(clavarng* rng) {
+    lavarng_u128 state = {rng->s.pcg.state_lo, rng->s.pcg.state_hi};
+    lavarng_u128 mult = {PCG_MULT_LO, PCG_MULT_HI};
+    lavarng_u128 inc = {rng->s.pcg.inc_lo, rng->s.pcg.inc_hi};
+    state = lavarng_add128(lavarng_mul128(state, mult), inc);
+    rng->s.pcg.state_lo = state.lo;
+    rng->s.pcg.state_hi = state.hi;
+    uint64_t folded = state.hi ^ state.lo;
+    unsigned rot = (unsigned)(state.hi >> 58);
+    return (folded >> rot) | (folded << ((64 - rot) & 63));
+} // end of func
+
+// Jump the LCG ahead by delta steps in log2(delta) multiplications
+static void pcg_advance(clavarng* rng, lavarng_u128 delta) {
+    lavarng_u128 cur_mult = {PCG_MULT_LO, PCG_MULT_HI};
+    lavarng_u128 cur_plus = {rng->s.pcg.inc_lo, rng->s.pcg.inc_hi};
+    lavarng_u128 acc_mult = {1, 0};
+    lavarng_u128 acc_plus = {0, 0};
+    lavarng_u128 one = {1, 0};
+    while (delta.lo | delta.hi) {
+        if (delta.lo & 1) {
+            acc_mult = lavarng_mul128(acc_mult, cur_mult);
+            acc_plus = lavarng_add128(lavarng_mul128(acc_plus, cur_mult), cur_plus);
+        }
+        cur_plus = lavarng_mul128(lavarng_add128(cur_mult, one), cur_plus);
+        cur_mult = lavarng_mul128(cur_mult, cur_mult);
+        delta.lo = (delta.lo >> 1) | (delta.hi << 63);
+        delta.hi >>= 1;
+    }
+    lavarng_u128 state = {rng->s.pcg.state_lo, rng->s.pcg.state_hi};
+    state = lavarng_add128(lavarng_mul128(acc_mult, state), acc_plus);
+    rng->s.pcg.state_lo = state.lo;
+    rng->s.pcg.state_hi = state.hi;
+} // end of func
+
+// =================================================================
+// Philox4x32-10
+// =================================================================
+
+// Function to compute one Philox block from a key and a counter
+void fscl_lavarng_philox_block(uint64_t key, uint64_t counter_lo, uint64_t counter_hi, uint64_t out[2]) {
+    uint32_t x0 = (uint32_t)counter_lo, x1 = (uint32_t)(counter_lo >> 32);
+    uint32_t x2 = (uint32_t)counter_hi, x3 = (uint32_t)(counter_hi >> 32);
+    uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * x0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * x2;
+        uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+        uint32_t y2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+        x1 = (uint32_t)p1;
+        x3 = (uint32_t)p0;
+        x0 = y0;
+        x2 = y2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = x0 | ((uint64_t)x1 << 32);
+    out[1] = x2 | ((uint64_t)x3 << 32);
+} // end of func
+
+static inline void philox_refill(clavarng* rng) {
+    fscl_lavarng_philox_block(rng->s.philox.key, rng->s.philox.counter_lo, rng->s.philox.counter_hi,
+                              rng->s.philox.buffer);
+    rng->s.philox.counter_hi += ++rng->s.philox.counter_lo == 0;
+    rng->s.philox.available = 2;
+} // end of func
+
+static inline uint64_t philox_next(clavarng* rng) {
+    if (rng->s.philox.available == 0) {
+        philox_refill(rng);
+    }
+    return rng->s.philox.buffer[2 - rng->s.philox.available--];
+} // end of func
+
+// =================================================================
+// Generator interface
+// =================================================================
+
+// Function to seed a generator
+void fscl_lavarng_seed(clavarng* rng, clavarng_engine engine, uint64_t seed) {
+    uint64_t mix = seed;
+    rng->engine = engine;
+    switch (engine) {
+        case LAVARNG_XOSHIRO256:
+            for (int i = 0; i < 4; ++i) {
+                rng->s.xoshiro[i] = lavarng_splitmix(&mix);
+            }
+            break;
+        case LAVARNG_PCG64: {
+            // Seeding of the reference implementation: the increment must be odd
+            lavarng_u128 initstate;
+            initstate.lo = lavarng_splitmix(&mix);
+            initstate.hi = lavarng_splitmix(&mix);
+            uint64_t seq_lo = lavarng_splitmix(&mix);
+            uint64_t seq_hi = lavarng_splitmix(&mix);
+            rng->s.pcg.inc_lo = (seq_lo << 1) | 1;
+            rng->s.pcg.inc_hi = (seq_hi << 1) | (seq_lo >> 63);
+            rng->s.pcg.state_lo = 0;
+            rng->s.pcg.state_hi = 0;
+            pcg_next(rng);
+            lavarng_u128 state = {rng->s.pcg.state_lo, rng->s.pcg.state_hi};
+            state = lavarng_add128(state, initstate);
+            rng->s.pcg.state_lo = state.lo;
+            rng->s.pcg.state_hi = state.hi;
+            pcg_next(rng);
+            break;
+        }
+        case LAVARNG_PHILOX:
+            rng->s.philox.key = lavarng_splitmix(&mix);
+            rng->s.philox.counter_lo = 0;
+            rng->s.philox.counter_hi = 0;
+            rng->s.philox.available = 0;
+            break;
+    }
+} // end of func
+
+// Function to generate the next 64 random bits
+uint64_t fscl_lavarng_next(clavarng* rng) {
+    switch (rng->engine) {
+        case LAVARNG_PCG64:
+            return pcg_next(rng);
+        case LAVARNG_PHILOX:
+            return philox_next(rng);
+        default:
+            return xoshiro_next(rng->s.xoshiro);
+    }
+} // end of func
+
+// Function to generate a double in [0, 1)
+double fscl_lavarng_double(clavarng* rng) {
+    return LAVARNG_TO_DOUBLE(fscl_lavarng_next(rng));
+} // end of func
+
+// Function to fill a buffer with random 64-bit values
+void fscl_lavarng_fill_u64(clavarng* rng, uint64_t* out, size_t count) {
+    size_t i = 0;
+    switch (rng->engine) {
+        case LAVARNG_XOSHIRO256: {
+            // Work on a local copy so the state stays in registers
+            uint64_t s[4] = {rng->s.xoshiro[0], rng->s.xoshiro[1], rng->s.xoshiro[2], rng->s.xoshiro[3]};
+            for (; i < count; ++i) {
+                out[i] = xoshiro_next(s);
+            }
+            for (int k = 0; k < 4; ++k) {
+                rng->s.xoshiro[k] = s[k];
+            }
+            break;
+        }
+        case LAVARNG_PCG64:
+            for (; i < count; ++i) {
+                out[i] = pcg_next(rng);
+            }
+            break;
+        case LAVARNG_PHILOX:
+            for (; i < count && rng->s.philox.available > 0; ++i) {
+                out[i] = philox_next(rng);
+            }
+            // Whole blocks straight into the output
+            for (; i + 2 <= count; i += 2) {
+                fscl_lavarng_philox_block(rng->s.philox.key, rng->s.philox.counter_lo, rng->s.philox.counter_hi,
+                                          out + i);
+                rng->s.philox.counter_hi += ++rng->s.philox.counter_lo == 0;
+            }
+            for (; i < count; ++i) {
+                out[i] = philox_next(rng);
+            }
+            break;
+    }
+} // end of func
+
+// Function to fill a buffer with doubles in [0, 1)
+void fscl_lavarng_fill_double(clavarng* rng, double* out, size_t count) {
+    // Generate bits in place, then convert; both share the same storage size
+    uint64_t chunk[LAVARNG_CHUNK];
+    size_t done = 0;
+    while (done < count) {
+        size_t n = count - done < LAVARNG_CHUNK ? count - done : LAVARNG_CHUNK;
+        fscl_lavarng_fill_u64(rng, chunk, n);
+        for (size_t i = 0; i < n; ++i) {
+            out[done + i] = LAVARNG_TO_DOUBLE(chunk[i]);
+        }
+        done += n;
+    }
+} // end of func
+
+// Function to jump far ahead in the sequence
+void fscl_lavarng_jump(clavarng* rng) {
+    switch (rng->engine) {
+        case LAVARNG_XOSHIRO256:
+            xoshiro_jump(rng->s.xoshiro);
+            break;
+        case LAVARNG_PCG64: {
+            lavarng_u128 delta = {0, 1};
+            pcg_advance(rng, delta);
+            break;
+        }
+        case LAVARNG_PHILOX:
+            rng->s.philox.counter_hi += 1;
+            break;
+    }
+} // end of func
+
+// Function to skip outputs
+int fscl_lavarng_advance(clavarng* rng, uint64_t delta) {
+    switch (rng->engine) {
+        case LAVARNG_PCG64: {
+            lavarng_u128 steps = {delta, 0};
+            pcg_advance(rng, steps);
+            return 0;
+        }
+        case LAVARNG_PHILOX: {
+            for (; delta > 0 && rng->s.philox.available > 0; --delta) {
+                rng->s.philox.available--;
+            }
+            uint64_t blocks = delta / 2;
+            uint64_t lo = rng->s.philox.counter_lo + blocks;
+            rng->s.philox.counter_hi += lo < rng->s.philox.counter_lo;
+            rng->s.philox.counter_lo = lo;
+            if (delta & 1) {
+                philox_refill(rng);
+                rng->s.philox.available = 1;
+            }
+            return 0;
+        }
+        default:
+            errno = ENOTSUP;
+            return -1;
+    }
+} // end of func
+
+// =================================================================
+// Lane generator
+// =================================================================
+
+// Advance every lane steps times, writing LAVARNG_LANES outputs per step
+typedef void (*lavarng_lanes_kernel)(uint64_t s[4][LAVARNG_LANES], uint64_t* out, size_t steps);
+
+static void lanes_kernel_scalar(uint64_t s[4][LAVARNG_LANES], uint64_t* out, size_t steps) {
+    for (size_t step = 0; step < steps; ++step, out += LAVARNG_LANES) {
+        for (int k = 0; k < LAVARNG_LANES; ++k) {
+            uint64_t lane[4] = {s[0][k], s[1][k], s[2][k], s[3][k]};
+            out[k] = xoshiro_next(lane);
+            s[0][k] = lane[0];
+            s[1][k] = lane[1];
+            s[2][k] = lane[2];
+            s[3][k] = lane[3];
+        }
+    }
+} // end of func
+
+#ifdef LAVARNG_X86
+// x * 5 and x * 9 are shifts and adds, AVX2 has no 64-bit multiply
+#define LANES_AVX2_ROTL(x, k) _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - (k)))
+#define LANES_AVX2_STEP(s0, s1, s2, s3, result)                                                   \
+    do {                                                                                           \
+        __m256i times5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);                           \
+        __m256i rotated = LANES_AVX2_ROTL(times5, 7);                                              \
+        result = _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated);                         \
+        __m256i t = _mm256_slli_epi64(s1, 17);                                                     \
+        s2 = _mm256_xor_si256(s2, s0);                                                             \
+        s3 = _mm256_xor_si256(s3, s1);                                                             \
+        s1 = _mm256_xor_si256(s1, s2);                                                             \
+        s0 = _mm256_xor_si256(s0, s3);                                                             \
+        s2 = _mm256_xor_si256(s2, t);                                                              \
+        s3 = LANES_AVX2_ROTL(s3, 45);                                                              \
+    } while (0)
+
+__attribute__((target("avx2"))) static void lanes_kernel_avx2(uint64_t s[4][LAVARNG_LANES], uint64_t* out,
+                                                              size_t steps) {
+    // Lanes 0-3 in the a registers, lanes 4-7 in the b registers
+    __m256i a0 = _mm256_loadu_si256((const __m256i*)&s[0][0]);
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)&s[1][0]);
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)&s[2][0]);
+    __m256i a3 = _mm256_loadu_si256((const __m256i*)&s[3][0]);
+    __m256i b0 = _mm256_loadu_si256((const __m256i*)&s[0][4]);
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)&s[1][4]);
+    __m256i b2 = _mm256_loadu_si256((const __m256i*)&s[2][4]);
+    __m256i b3 = _mm256_loadu_si256((const __m256i*)&s[3][4]);
+    for (size_t step = 0; step < steps; ++step, out += LAVARNG_LANES) {
+        __m256i low, high;
+        LANES_AVX2_STEP(a0, a1, a2, a3, low);
+        LANES_AVX2_STEP(b0, b1, b2, b3, high);
+        _mm256_storeu_si256((__m256i*)out, low);
+        _mm256_storeu_si256((__m256i*)(out + 4), high);
+    }
+    _mm256_storeu_si256((__m256i*)&s[0][0], a0);
+    _mm256_storeu_si256((__m256i*)&s[0][4], b0);
+    _mm256_storeu_si256((__m256i*)&s[1][0], a1);
+    _mm256_storeu_si256((__m256i*)&s[1][4], b1);
+    _mm256_storeu_si256((__m256i*)&s[2][0], a2);
+    _mm256_storeu_si256((__m256i*)&s[2][4], b2);
+    _mm256_storeu_si256((__m256i*)&s[3][0], a3);
+    _mm256_storeu_si256((__m256i*)&s[3][4], b3);
+} // end of func
+
+__attribute__((target("avx512f"))) static void lanes_kernel_avx512(uint64_t s[4][LAVARNG_LANES], uint64_t* out,
+                                                                   size_t steps) {
+    __m512i s0 = _mm512_loadu_si512(&s[0][0]);
+    __m512i s1 = _mm512_loadu_si512(&s[1][0]);
+    __m512i s2 = _mm512_loadu_si512(&s[2][0]);
+    __m512i s3 = _mm512_loadu_si512(&s[3][0]);
+    for (size_t step = 0; step < steps; ++step, out += LAVARNG_LANES) {
+        __m512i rotated = _mm512_rol_epi64(_mm512_add_epi64(_mm512_slli_epi64(s1, 2), s1), 7);
+        _mm512_storeu_si512(out, _mm512_add_epi64(_mm512_slli_epi64(rotated, 3), rotated));
+        __m512i t = _mm512_slli_epi64(s1, 17);
+        s2 = _mm512_xor_si512(s2, s0);
+        s3 = _mm512_xor_si512(s3, s1);
+        s1 = _mm512_xor_si512(s1, s2);
+        s0 = _mm512_xor_si512(s0, s3);
+        s2 = _mm512_xor_si512(s2, t);
+        s3 = _mm512_rol_epi64(s3, 45);
+    }
+    _mm512_storeu_si512(&s[0][0], s0);
+    _mm512_storeu_si512(&s[1][0], s1);
+    _mm512_storeu_si512(&s[2][0], s2);
+    _mm512_storeu_si512(&s[3][0], s3);
+} // end of func
+#endif
+
+static lavarng_lanes_kernel lanes_kernel = NULL;
+static const char* lanes_isa = "scalar";
+
+// Pick the widest kernel the processor runs, once
+static lavarng_lanes_kernel lanes_select(void) {
+    lavarng_lanes_kernel kernel = __atomic_load_n(&lanes_kernel, __ATOMIC_ACQUIRE);
+    if (kernel) {
+        return kernel;
+    }
+    const char* isa = "scalar";
+    kernel = lanes_kernel_scalar;
+#ifdef LAVARNG_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        kernel = lanes_kernel_avx512;
+        isa = "avx512";
+    } else if (__builtin_cpu_supports("avx2")) {
+        kernel = lanes_kernel_avx2;
+        isa = "avx2";
+    }
+#endif
+    // Every thread picks the same kernel, so racing stores are harmless
+    __atomic_store_n(&lanes_isa, isa, __ATOMIC_RELAXED);
+    __atomic_store_n(&lanes_kernel, kernel, __ATOMIC_RELEASE);
+    return kernel;
+} // end of func
+
+// Function to name the instruction set of the lane generator
+const char* fscl_lavarng_lanes_isa(void) {
+    lanes_select();
+    return __atomic_load_n(&lanes_isa, __ATOMIC_RELAXED);
+} // end of func
+
+// Function to seed a lane generator
+void fscl_lavarng_lanes_seed(clavarng_lanes* lanes, uint64_t seed) {
+    clavarng rng;
+    fscl_lavarng_seed(&rng, LAVARNG_XOSHIRO256, seed);
+    for (int k = 0; k < LAVARNG_LANES; ++k) {
+        for (int r = 0; r < 4; ++r) {
+            lanes->s[r][k] = rng.s.xoshiro[r];
+        }
+        xoshiro_jump(rng.s.xoshiro);
+    }
+    lanes->available = 0;
+} // end of func
+
+// Function to fill a buffer with random 64-bit values from all lanes
+void fscl_lavarng_lanes_fill_u64(clavarng_lanes* lanes, uint64_t* out, size_t count) {
+    size_t i = 0;
+    for (; i < count && lanes->available > 0; ++i) {
+        out[i] = lanes->buffer[LAVARNG_LANES - lanes->available--];
+    }
+    size_t steps = (count - i) / LAVARNG_LANES;
+    if (steps > 0) {
+        lanes_select()(lanes->s, out + i, steps);
+        i += steps * LAVARNG_LANES;
+    }
+    if (i < count) {
+        lanes_select()(lanes->s, lanes->buffer, 1);
+        lanes->available = LAVARNG_LANES;
+        for (; i < count; ++i) {
+            out[i] = lanes->buffer[LAVARNG_LANES - lanes->available--];
+        }
+    }
+} // end of func
+
+// Function to fill a buffer with doubles in [0, 1)
+void fscl_lavarng_lanes_fill_double(clavarng_lanes* lanes, double* out, size_t count) {
+    // Both types are 8 bytes: generate bits in place, then convert them
+    uint64_t chunk[LAVARNG_CHUNK];
+    size_t done = 0;
+    while (done < count) {
+        size_t n = count - done < LAVARNG_CHUNK ? count - done : LAVARNG_CHUNK;
+        fscl_lavarng_lanes_fill_u64(lanes, chunk, n);
+        for (size_t i = 0; i < n; ++i) {
+            out[done + i] = LAVARNG_TO_DOUBLE(chunk[i]);
+        }
+        done += n;
+    }
+} // end of func
+
+// =================================================================
+// Distributions
+// =================================================================
+
+// Random bits for the samplers, from a generator or a buffered lane generator
+typedef struct {
+    clavarng* rng;
+    clavarng_lanes* lanes;
+    uint64_t* chunk; // LAVARNG_CHUNK values, only used with lanes
+    size_t next;
+    size_t size;
+} lavarng_source;
+
+static inline uint64_t source_next(lavarng_source* source) {
+    if (!source->lanes) {
+        return fscl_lavarng_next(source->rng);
+    }
+    if (source->next == source->size) {
+        fscl_lavarng_lanes_fill_u64(source->lanes, source->chunk, LAVARNG_CHUNK);
+        source->next = 0;
+        source->size = LAVARNG_CHUNK;
+    }
+    return source->chunk[source->next++];
+} // end of func
+
+static inline double source_double(lavarng_source* source) {
+    return LAVARNG_TO_DOUBLE(source_next(source));
+} // end of func
+
+// Lemire: the high half of x * range is uniform once the biased low part is rejected
+static inline uint64_t lemire_bounded(lavarng_source* source, uint64_t x, uint64_t range) {
+    if (range == 0) {
+        return x;
+    }
+    uint64_t high;
+    uint64_t low = lavarng_mul64(x, range, &high);
+    if (low < range) {
+        uint64_t threshold = (0 - range) % range;
+        while (low < threshold) {
+            low = lavarng_mul64(source_next(source), range, &high);
+        }
+    }
+    return high;
+} // end of func
+
+// Ziggurat tables (Marsaglia and Tsang, with Doornik's layout): x[i] is
+// the right edge of layer i, f[i] the density there, ratio[i] = x[i+1] / x[i]
+#define ZIG_NORMAL_LAYERS 128
+#define ZIG_NORMAL_R 3.442619855899
+#define ZIG_NORMAL_V 9.91256303526217e-3
+#define ZIG_EXP_LAYERS 256
+#define ZIG_EXP_R 7.69711747013104972
+#define ZIG_EXP_V 3.949659822581572e-3
+
+typedef struct {
+    double normal_x[ZIG_NORMAL_LAYERS + 1];
+    double normal_f[ZIG_NORMAL_LAYERS + 1];
+    double normal_ratio[ZIG_NORMAL_LAYERS];
+    double exp_x[ZIG_EXP_LAYERS + 1];
+    double exp_f[ZIG_EXP_LAYERS + 1];
+    double exp_ratio[ZIG_EXP_LAYERS];
+} lavarng_ziggurat;
+
+static lavarng_ziggurat zig_tables;
+static int zig_state = 0; // 0 not built, 1 building, 2 ready
+
+static void zig_build(lavarng_ziggurat* z) {
+    double f = exp(-0.5 * ZIG_NORMAL_R * ZIG_NORMAL_R);
+    z->normal_x[0] = ZIG_NORMAL_V / f;
+    z->normal_x[1] = ZIG_NORMAL_R;
+    z->normal_x[ZIG_NORMAL_LAYERS] = 0.0;
+    for (int i = 2; i < ZIG_NORMAL_LAYERS; ++i) {
+        z->normal_x[i] = sqrt(-2.0 * log(ZIG_NORMAL_V / z->normal_x[i - 1] + f));
+        f = exp(-0.5 * z->normal_x[i] * z->normal_x[i]);
+    }
+    for (int i = 0; i <= ZIG_NORMAL_LAYERS; ++i) {
+        z->normal_f[i] = exp(-0.5 * z->normal_x[i] * z->normal_x[i]);
+    }
+    for (int i = 0; i < ZIG_NORMAL_LAYERS; ++i) {
+        z->normal_ratio[i] = z->normal_x[i + 1] / z->normal_x[i];
+    }
+
+    f = exp(-ZIG_EXP_R);
+    z->exp_x[0] = ZIG_EXP_V / f;
+    z->exp_x[1] = ZIG_EXP_R;
+    z->exp_x[ZIG_EXP_LAYERS] = 0.0;
+    for (int i = 2; i < ZIG_EXP_LAYERS; ++i) {
+        z->exp_x[i] = -log(ZIG_EXP_V / z->exp_x[i - 1] + f);
+        f = exp(-z->exp_x[i]);
+    }
+    for (int i = 0; i <= ZIG_EXP_LAYERS; ++i) {
+        z->exp_f[i] = exp(-z->exp_x[i]);
+    }
+    for (int i = 0; i < ZIG_EXP_LAYERS; ++i) {
+        z->exp_ratio[i] = z->exp_x[i + 1] / z->exp_x[i];
+    }
+} // end of func
+
+static const lavarng_ziggurat* zig_get(void) {
+    if (__atomic_load_n(&zig_state, __ATOMIC_ACQUIRE) == 2) {
+        return &zig_tables;
+    }
+    int expected = 0;
+    if (__atomic_compare_exchange_n(&zig_state, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        zig_build(&zig_tables);
+        __atomic_store_n(&zig_state, 2, __ATOMIC_RELEASE);
+    } else {
+        while (__atomic_load_n(&zig_state, __ATOMIC_ACQUIRE) != 2) {
+            // another thread is building the tables, they take microseconds
+        }
+    }
+    return &zig_tables;
+} // end of func
+
+static double zig_normal(const lavarng_ziggurat* z, lavarng_source* source) {
+    for (;;) {
+        // The top 53 bits give the abscissa, the low 7 bits the layer
+        uint64_t bits = source_next(source);
+        double u = 2.0 * LAVARNG_TO_DOUBLE(bits) - 1.0;
+        int i = (int)(bits & (ZIG_NORMAL_LAYERS - 1));
+        if (fabs(u) < z->normal_ratio[i]) {
+            return u * z->normal_x[i];
+        }
+        if (i == 0) {
+            // Tail beyond R (Marsaglia 1964)
+            double a, b;
+            do {
+                a = -log(1.0 - source_double(source)) / ZIG_NORMAL_R;
+                b = -log(1.0 - source_double(source));
+            } while (b + b < a * a);
+            return u < 0 ? -(ZIG_NORMAL_R + a) : ZIG_NORMAL_R + a;
+        }
+        double x = u * z->normal_x[i];
+        double y = z->normal_f[i] + source_double(source) * (z->normal_f[i + 1] - z->normal_f[i]);
+        if (y < exp(-0.5 * x * x)) {
+            return x;
+        }
+    }
+} // end of func
+
+static double zig_exponential(const lavarng_ziggurat* z, lavarng_source* source) {
+    for (;;) {
+        uint64_t bits = source_next(source);
+        double u = LAVARNG_TO_DOUBLE(bits);
+        int i = (int)(bits & (ZIG_EXP_LAYERS - 1));
+        if (u < z->exp_ratio[i]) {
+            return u * z->exp_x[i];
+        }
+        if (i == 0) {
+            // The tail of an exponential is an exponential shifted by R
+            return ZIG_EXP_R - log(1.0 - source_double(source));
+        }
+        double x = u * z->exp_x[i];
+        double y = z->exp_f[i] + source_double(source) * (z->exp_f[i + 1] - z->exp_f[i]);
+        if (y < exp(-x)) {
+            return x;
+        }
+    }
+} // end of func
+
+// Function to generate an integer in [0, range)
+uint64_t fscl_lavarng_bounded(clavarng* rng, uint64_t range) {
+    lavarng_source source = {.rng = rng};
+    return lemire_bounded(&source, fscl_lavarng_next(rng), range);
+} // end of func
+
+// Function to generate a standard normal variate
+double fscl_lavarng_normal(clavarng* rng) {
+    lavarng_source source = {.rng = rng};
+    return zig_normal(zig_get(), &source);
+} // end of func
+
+// Function to generate a standard exponential variate
+double fscl_lavarng_exponential(clavarng* rng) {
+    lavarng_source source = {.rng = rng};
+    return zig_exponential(zig_get(), &source);
+} // end of func
+
+// Function to fill a buffer with integers in [0, range)
+void fscl_lavarng_lanes_fill_bounded(clavarng_lanes* lanes, uint64_t* out, size_t count, uint64_t range) {
+    // Draw all candidates in bulk; the rare rejections pull from a side buffer
+    fscl_lavarng_lanes_fill_u64(lanes, out, count);
+    if (range == 0) {
+        return;
+    }
+    uint64_t chunk[LAVARNG_CHUNK];
+    lavarng_source source = {.lanes = lanes, .chunk = chunk};
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = lemire_bounded(&source, out[i], range);
+    }
+} // end of func
+
+// Function to fill a buffer with normal variates
+void fscl_lavarng_lanes_fill_normal(clavarng_lanes* lanes, double* out, size_t count, double mean, double stddev) {
+    const lavarng_ziggurat* z = zig_get();
+    uint64_t chunk[LAVARNG_CHUNK];
+    lavarng_source source = {.lanes = lanes, .chunk = chunk};
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = mean + stddev * zig_normal(z, &source);
+    }
+} // end of func
+
+// Function to fill a buffer with exponential variates
+void fscl_lavarng_lanes_fill_exponential(clavarng_lanes* lanes, double* out, size_t count, double rate) {
+    const lavarng_ziggurat* z = zig_get();
+    uint64_t chunk[LAVARNG_CHUNK];
+    lavarng_source source = {.lanes = lanes, .chunk = chunk};
+    double scale = 1.0 / rate;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = zig_exponential(z, &source) * scale;
+    }
+} // end of func
+
+// Streams handed out to threads, each thread seeds from the next one
+static uint64_t lavarng_streams = 0;
+
+// Function to get the generator of the calling thread
+clavarng* fscl_lavarng_thread(void) {
+    static LAVARNG_THREAD_LOCAL clavarng rng;
+    static LAVARNG_THREAD_LOCAL int seeded = 0;
+    if (!seeded) {
+        uint64_t stream = __atomic_fetch_add(&lavarng_streams, 1, __ATOMIC_RELAXED);
+        fscl_lavarng_seed(&rng, LAVARNG_XOSHIRO256, 0x853C49E6748FEA9Bull ^ (stream * 0x9E3779B97F4A7C15ull));
+        seeded = 1;
+    }
+    return &rng;
+} // end of func
@@ -0,0 +1,729 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "fossil/xutil/statcache.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define statcache_lock_t SRWLOCK
+#define statcache_lock_init(lock) InitializeSRWLock(lock)
+#define statcache_lock_destroy(lock) ((void)(lock))
+#define statcache_read_lock(lock) AcquireSRWLockShared(lock)
+#define statcache_read_unlock(lock) ReleaseSRWLockShared(lock)
+#define statcache_write_lock(lock) AcquireSRWLockExclusive(lock)
+#define statcache_write_unlock(lock) ReleaseSRWLockExclusive(lock)
+#define statcache_count(counter) InterlockedIncrement64((volatile LONG64*)&(counter))
+#define statcache_load(value) InterlockedCompareExchange64((volatile LONG64*)&(value), 0, 0)
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define statcache_lock_t pthread_rwlock_t
+#define statcache_lock_init(lock) pthread_rwlock_init(lock, NULL)
+#define statcache_lock_destroy(lock) pthread_rwlock_destroy(lock)
+#define statcache_read_lock(lock) pthread_rwlock_rdlock(lock)
+#define statcache_read_unlock(lock) pthread_rwlock_unlock(lock)
+#define statcache_write_lock(lock) pthread_rwlock_wrlock(lock)
+#define statcache_write_unlock(lock) pthread_rwlock_unlock(lock)
+#define statcache_count(counter) __atomic_fetch_add(&(counter), 1, __ATOMIC_RELAXED)
+#define statcache_load(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+#endif
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#define FSCL_STATCACHE_INOTIFY 1
+#define STATCACHE_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | \
+                              IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF)
+#define STATCACHE_LISTING_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)
+#endif
+
+// Default number of cached paths
+#define STATCACHE_DEFAULT_CAPACITY 65536
+
+typedef struct statcache_entry {
+    struct statcache_entry* next;
+    uint64_t hash;
+    double expires;       // monotonic deadline, 0 when entries never expire
+    cstatcache_info info;
+#ifdef FSCL_STATCACHE_INOTIFY
+    int watches[2];       // descriptors this entry holds a reference on, -1 for none
+#endif
+    size_t length;
+    char path[];
+} statcache_entry;
+
+#ifdef FSCL_STATCACHE_INOTIFY
+// A watched directory and every spelling ("a/", "./a/") it was reached by,
+// kept while some cached entry or lookup in flight references it
+typedef struct {
+    char** prefixes;
+    size_t count;
+    size_t refs;
+    int removed;          // the kernel dropped the watch (IN_IGNORED)
+} statcache_dir;
+#endif
+
+struct cstatcache {
+    statcache_entry** buckets;
+    size_t mask;
+    size_t count;
+    size_t capacity;
+    double ttl;
+    uint64_t generation;  // bumped by every invalidation
+    cstatcache_counters counters;
+    statcache_lock_t lock;
+#ifdef FSCL_STATCACHE_INOTIFY
+    int notify_fd;
+    int wake[2];
+    pthread_t thread;
+    int watching;
+    statcache_dir** dirs; // indexed by watch descriptor
+    size_t dir_count;
+#endif
+};
+
+static cstatcache* volatile statcache_global = NULL;
+
+static double statcache_now(void) {
+#ifdef _WIN32
+    return (double)GetTickCount64() / 1000.0;
+#else
+    struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+} // end of func
+
+// Length of a path without trailing separators, so "a/b/" and "a/b" share an entry
+static size_t statcache_key_length(const char* path) {
+    size_t length = strlen(path);
+    while (length > 1 && path[length - 1] == '/') {
+        --length;
+    }
+    return length;
+} // end of func
+
+static uint64_t statcache_hash(const char* key, size_t length) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)key[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+} // end of func
+
+#ifdef FSCL_STATCACHE_INOTIFY
+static void statcache_dir_free(statcache_dir* dir);
+
+// Drop one reference on a watch, removing it with the last one; caller
+// holds the write lock. The IN_IGNORED that follows finds no directory.
+static void statcache_unwatch(cstatcache* cache, int wd) {
+    if (wd < 0 || (size_t)wd >= cache->dir_count || !cache->dirs[wd]) {
+        return;
+    }
+    statcache_dir* dir = cache->dirs[wd];
+    if (dir->refs > 1) {
+        dir->refs--;
+        return;
+    }
+    if (!dir->removed) {
+        inotify_rm_watch(cache->notify_fd, wd);
+    }
+    statcache_dir_free(dir);
+    cache->dirs[wd] = NULL;
+} // end of func
+#endif
+
+// Release an entry and the watches it holds, caller holds the write lock
+static void statcache_free(cstatcache* cache, statcache_entry* entry) {
+#ifdef FSCL_STATCACHE_INOTIFY
+    statcache_unwatch(cache, entry->watches[0]);
+    statcache_unwatch(cache, entry->watches[1]);
+#else
+    (void)cache;
+#endif
+    free(entry);
+} // end of func
+
+static statcache_entry** statcache_find(cstatcache* cache, const char* key, size_t length, uint64_t hash) {
+    statcache_entry** link = &cache->buckets[hash & cache->mask];
+    while (*link) {
+        statcache_entry* entry = *link;
+        if (entry->hash == hash && entry->length == length && memcmp(entry->path, key, length) == 0) {
+            return link;
+        }
+        link = &entry->next;
+    }
+    return link;
+} // end of func
+
+// Remove one entry, caller holds the write lock
+static void statcache_remove(cstatcache* cache, const char* key, size_t length) {
+    statcache_entry** link = statcache_find(cache, key, length, statcache_hash(key, length));
+    if (*link) {
+        statcache_entry* entry = *link;
+        *link = entry->next;
+        statcache_free(cache, entry);
+        cache->count--;
+        cache->counters.invalidations++;
+    }
+    cache->generation++;
+} // end of func
+
+// Drop everything, caller holds the write lock
+static void statcache_remove_all(cstatcache* cache) {
+    for (size_t i = 0; i <= cache->mask; ++i) {
+        statcache_entry* entry = cache->buckets[i];
+        while (entry) {
+            statcache_entry* next = entry->next;
+            statcache_free(cache, entry);
+            cache->counters.invalidations++;
+            entry = next;
+        }
+        cache->buckets[i] = NULL;
+    }
+    cache->count = 0;
+    cache->generation++;
+} // end of func
+
+// Make room for one entry by dropping the first one found after the given bucket
+static void statcache_evict(cstatcache* cache, uint64_t hash) {
+    for (size_t i = 1; i <= cache->mask + 1; ++i) {
+        statcache_entry** link = &cache->buckets[(hash + i) & cache->mask];
+        if (*link) {
+            statcache_entry* entry = *link;
+            *link = entry->next;
+            statcache_free(cache, entry);
+            cache->count--;
+            return;
+        }
+    }
+} // end of func
+
+// Store an answer, taking over the watch references of the lookup
+// (two descriptors, NULL without watching); caller holds the write lock
+static void statcache_insert(cstatcache* cache, const char* key, size_t length, uint64_t hash,
+                             const cstatcache_info* info, const int* watches) {
+    double expires = cache->ttl > 0.0 ? statcache_now() + cache->ttl : 0.0;
+    statcache_entry** link = statcache_find(cache, key, length, hash);
+    statcache_entry* entry = *link;
+    if (entry) {
+        entry->info = *info;
+        entry->expires = expires;
+#ifdef FSCL_STATCACHE_INOTIFY
+        for (int i = 0; i < 2; ++i) {
+            statcache_unwatch(cache, entry->watches[i]);
+            entry->watches[i] = watches ? watches[i] : -1;
+        }
+#endif
+        return;
+    }
+    if (cache->count >= cache->capacity) {
+        statcache_evict(cache, hash);
+        link = statcache_find(cache, key, length, hash);
+    }
+    entry = (statcache_entry*)malloc(sizeof(statcache_entry) + length + 1);
+    if (!entry) {
+#ifdef FSCL_STATCACHE_INOTIFY
+        if (watches) {
+            statcache_unwatch(cache, watches[0]);
+            statcache_unwatch(cache, watches[1]);
+        }
+#endif
+        return; // an uncached path only costs another stat
+    }
+#ifdef FSCL_STATCACHE_INOTIFY
+    entry->watches[0] = watches ? watches[0] : -1;
+    entry->watches[1] = watches ? watches[1] : -1;
+#endif
+#ifndef FSCL_STATCACHE_INOTIFY
+    (void)watches;
+#endif
+    entry->next = NULL;
+    entry->hash = hash;
+    entry->expires = expires;
+    entry->info = *info;
+    entry->length = length;
+    memcpy(entry->path, key, length);
+    entry->path[length] = '\0';
+    *link = entry;
+    cache->count++;
+} // end of func
+
+static void statcache_probe(const char* key, size_t length, cstatcache_info* info) {
+    char small[256];
+    char* path = small;
+    if (length >= sizeof(small)) {
+        path = (char*)malloc(length + 1);
+        if (!path) {
+            info->type = STATCACHE_MISSING;
+            return;
+        }
+    }
+    memcpy(path, key, length);
+    path[length] = '\0';
+
+    struct stat status;
+    memset(info, 0, sizeof(*info));
+    if (stat(path, &status) != 0) {
+        info->type = STATCACHE_MISSING;
+    } else {
+        if (S_ISDIR(status.st_mode)) {
+            info->type = STATCACHE_DIRECTORY;
+        } else if (S_ISREG(status.st_mode)) {
+            info->type = STATCACHE_FILE;
+        } else {
+            info->type = STATCACHE_OTHER;
+        }
+        info->size = (unsigned long long)status.st_size;
+#if defined(__APPLE__)
+        info->mtime_sec = (long long)status.st_mtimespec.tv_sec;
+        info->mtime_nsec = (long)status.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+        info->mtime_sec = (long long)status.st_mtime;
+#else
+        info->mtime_sec = (long long)status.st_mtim.tv_sec;
+        info->mtime_nsec = (long)status.st_mtim.tv_nsec;
+#endif
+    }
+    if (path != small) {
+        free(path);
+    }
+} // end of func
+
+// =================================================================
+// inotify invalidation
+// =================================================================
+
+#ifdef FSCL_STATCACHE_INOTIFY
+// Register one spelling of a watched directory and take a reference on
+// it, caller holds the write lock
+static int statcache_dir_add(cstatcache* cache, int wd, const char* prefix, size_t length) {
+    if ((size_t)wd >= cache->dir_count) {
+        size_t count = cache->dir_count ? cache->dir_count : 64;
+        while (count <= (size_t)wd) {
+            count *= 2;
+        }
+        statcache_dir** dirs = (statcache_dir**)realloc(cache->dirs, count * sizeof(statcache_dir*));
+        if (!dirs) {
+            return -1;
+        }
+        memset(dirs + cache->dir_count, 0, (count - cache->dir_count) * sizeof(statcache_dir*));
+        cache->dirs = dirs;
+        cache->dir_count = count;
+    }
+    statcache_dir* dir = cache->dirs[wd];
+    if (!dir) {
+        dir = (statcache_dir*)calloc(1, sizeof(statcache_dir));
+        if (!dir) {
+            return -1;
+        }
+        cache->dirs[wd] = dir;
+    }
+    dir->removed = 0;
+    for (size_t i = 0; i < dir->count; ++i) {
+        if (strlen(dir->prefixes[i]) == length && memcmp(dir->prefixes[i], prefix, length) == 0) {
+            dir->refs++;
+            return 0;
+        }
+    }
+    char** prefixes = (char**)realloc(dir->prefixes, (dir->count + 1) * sizeof(char*));
+    char* copy = (char*)malloc(length + 1);
+    if (prefixes) {
+        dir->prefixes = prefixes;
+    }
+    if (!prefixes || !copy) {
+        free(copy);
+        return -1;
+    }
+    memcpy(copy, prefix, length);
+    copy[length] = '\0';
+    dir->prefixes[dir->count++] = copy;
+    dir->refs++;
+    return 0;
+} // end of func
+
+static void statcache_dir_free(statcache_dir* dir) {
+    if (dir) {
+        for (size_t i = 0; i < dir->count; ++i) {
+            free(dir->prefixes[i]);
+        }
+        free(dir->prefixes);
+        free(dir);
+    }
+} // end of func
+
+// Watches placed by statcache_watch
+#define STATCACHE_WATCHED_SELF 1
+#define STATCACHE_WATCHED_PARENT 2
+
+// Watch a directory and remember the prefix that entry keys below it
+// start with, returning the descriptor the caller now holds a reference on
+static int statcache_watch_dir(cstatcache* cache, const char* dir, const char* prefix, size_t prefix_length, uint32_t extra) {
+    statcache_write_lock(&cache->lock);
+    int wd = inotify_add_watch(cache->notify_fd, dir, STATCACHE_WATCH_MASK | extra);
+    if (wd >= 0 && statcache_dir_add(cache, wd, prefix, prefix_length) != 0) {
+        if ((size_t)wd >= cache->dir_count || !cache->dirs[wd] || cache->dirs[wd]->refs == 0) {
+            statcache_dir_free((size_t)wd < cache->dir_count ? cache->dirs[wd] : NULL);
+            if ((size_t)wd < cache->dir_count) {
+                cache->dirs[wd] = NULL;
+            }
+            inotify_rm_watch(cache->notify_fd, wd);
+        }
+        wd = -1;
+    }
+    statcache_write_unlock(&cache->lock);
+    return wd; // -1 when the watch limit is reached, missing or not a directory
+} // end of func
+
+// Watch the parent of a key, and the key itself when it is a directory,
+// storing the descriptors held in watches and returning the
+// STATCACHE_WATCHED flags of the watches in place
+static int statcache_watch(cstatcache* cache, const char* key, size_t length, int* watches) {
+    char small[256];
+    char* buffer = small;
+    int watched = 0;
+    watches[0] = watches[1] = -1;
+    if (length + 2 > sizeof(small)) {
+        buffer = (char*)malloc(length + 2);
+        if (!buffer) {
+            return 0;
+        }
+    }
+
+    // The key itself, IN_ONLYDIR makes this a no-op for files
+    memcpy(buffer, key, length);
+    buffer[length] = '\0';
+    size_t prefix_length = length;
+    if (buffer[length - 1] != '/') {
+        buffer[prefix_length++] = '/';
+    }
+    buffer[prefix_length] = '\0';
+    watches[0] = statcache_watch_dir(cache, buffer, buffer, prefix_length, IN_ONLYDIR);
+    if (watches[0] >= 0) {
+        watched |= STATCACHE_WATCHED_SELF;
+    }
+
+    // The parent directory
+    size_t slash = length;
+    while (slash > 0 && key[slash - 1] != '/') {
+        --slash;
+    }
+    if (slash == 0) {
+        watches[1] = statcache_watch_dir(cache, ".", "", 0, IN_ONLYDIR);
+    } else {
+        memcpy(buffer, key, slash);
+        buffer[slash == 1 ? 1 : slash - 1] = '\0';
+        watches[1] = statcache_watch_dir(cache, buffer, key, slash, IN_ONLYDIR);
+    }
+    if (watches[1] >= 0) {
+        watched |= STATCACHE_WATCHED_PARENT;
+    }
+    if (buffer != small) {
+        free(buffer);
+    }
+    return watched;
+} // end of func
+
+// Invalidate prefix + name, and the directory a prefix names
+static void statcache_forget(cstatcache* cache, const char* prefix, const char* name, int listing_changed) {
+    size_t prefix_length = strlen(prefix);
+    if (name) {
+        size_t name_length = strlen(name);
+        char small[512];
+        char* key = small;
+        if (prefix_length + name_length >= sizeof(small)) {
+            key = (char*)malloc(prefix_length + name_length + 1);
+        }
+        if (key) {
+            memcpy(key, prefix, prefix_length);
+            memcpy(key + prefix_length, name, name_length);
+            statcache_remove(cache, key, prefix_length + name_length);
+            if (key != small) {
+                free(key);
+            }
+        }
+    }
+    if (listing_changed) {
+        if (prefix_length == 0) {
+            statcache_remove(cache, ".", 1);
+        } else {
+            statcache_remove(cache, prefix, prefix_length > 1 ? prefix_length - 1 : 1);
+        }
+    }
+} // end of func
+
+static void statcache_apply(cstatcache* cache, const struct inotify_event* event) {
+    if (event->mask & IN_Q_OVERFLOW) {
+        statcache_remove_all(cache);
+        return;
+    }
+    if (event->wd < 0 || (size_t)event->wd >= cache->dir_count || !cache->dirs[event->wd]) {
+        return;
+    }
+    // Pinned, since dropping entries may release the last reference on it
+    statcache_dir* dir = cache->dirs[event->wd];
+    dir->refs++;
+    const char* name = event->len ? event->name : NULL;
+    int listing_changed = !name || (event->mask & STATCACHE_LISTING_MASK);
+    for (size_t i = 0; i < dir->count; ++i) {
+        statcache_forget(cache, dir->prefixes[i], name, listing_changed);
+    }
+    if (event->mask & IN_MOVE_SELF) {
+        statcache_remove_all(cache); // every key below the old location is stale
+    }
+    if (event->mask & IN_IGNORED) {
+        dir->removed = 1; // freed once the entries holding it are gone
+    }
+    statcache_unwatch(cache, event->wd);
+} // end of func
+
+static void* statcache_watcher(void* arg) {
+    cstatcache* cache = (cstatcache*)arg;
+    char buffer[16384] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd fds[2] = {
+        {cache->notify_fd, POLLIN, 0},
+        {cache->wake[0], POLLIN, 0}
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+        ssize_t length = read(cache->notify_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+        statcache_write_lock(&cache->lock);
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const struct inotify_event* event = (const struct inotify_event*)cursor;
+            statcache_apply(cache, event);
+            cursor += sizeof(struct inotify_event) + event->len;
+        }
+        statcache_write_unlock(&cache->lock);
+    }
+    return NULL;
+} // end of func
+#endif
+
+// =================================================================
+// Public interface
+// =================================================================
+
+// Function to create a metadata cache
+cstatcache* fscl_statcache_create(size_t capacity, double ttl, int watch) {
+    cstatcache* cache = (cstatcache*)calloc(1, sizeof(cstatcache));
+    if (!cache) {
+        return NULL;
+    }
+    cache->capacity = capacity ? capacity : STATCACHE_DEFAULT_CAPACITY;
+    cache->ttl = ttl;
+
+    size_t buckets = 16;
+    while (buckets < cache->capacity) {
+        buckets *= 2;
+    }
+    cache->buckets = (statcache_entry**)calloc(buckets, sizeof(statcache_entry*));
+    if (!cache->buckets) {
+        free(cache);
+        return NULL;
+    }
+    cache->mask = buckets - 1;
+    statcache_lock_init(&cache->lock);
+
+#ifdef FSCL_STATCACHE_INOTIFY
+    cache->notify_fd = -1;
+    cache->wake[0] = cache->wake[1] = -1;
+    if (watch) {
+        cache->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (cache->notify_fd >= 0 && pipe(cache->wake) == 0 &&
+            pthread_create(&cache->thread, NULL, statcache_watcher, cache) == 0) {
+            cache->watching = 1;
+        }
+    }
+#else
+    (void)watch;
+#endif
+    return cache;
+} // end of func
+
+// Function to look up the metadata of a path
+int fscl_statcache_lookup(cstatcache* cache, const char* path, cstatcache_info* info) {
+    cstatcache_info local;
+    if (!info) {
+        info = &local;
+    }
+    if (!cache || !path || !*path) {
+        info->type = STATCACHE_MISSING;
+        return -1;
+    }
+
+    size_t length = statcache_key_length(path);
+    uint64_t hash = statcache_hash(path, length);
+
+    statcache_read_lock(&cache->lock);
+    statcache_entry* entry = *statcache_find(cache, path, length, hash);
+    if (entry && (entry->expires == 0.0 || statcache_now() < entry->expires)) {
+        *info = entry->info;
+        statcache_read_unlock(&cache->lock);
+        statcache_count(cache->counters.hits);
+        return info->type == STATCACHE_MISSING ? -1 : 0;
+    }
+    statcache_read_unlock(&cache->lock);
+    statcache_count(cache->counters.misses);
+
+    // Watch before stat so a change racing with the stat invalidates it
+    int covered = 1;
+    int* held = NULL;
+#ifdef FSCL_STATCACHE_INOTIFY
+    int watched = 0;
+    int watches[2] = {-1, -1};
+    if (cache->watching) {
+        watched = statcache_watch(cache, path, length, watches);
+        held = watches;
+    }
+#endif
+    uint64_t generation = statcache_load(cache->generation);
+    statcache_probe(path, length, info);
+
+    // A watching cache without a TTL only keeps answers some watch can
+    // invalidate: the parent sees the key appear or vanish, and a
+    // directory also needs its own watch. The parent of a missing path
+    // is often missing too, so those answers are not cached.
+#ifdef FSCL_STATCACHE_INOTIFY
+    if (cache->watching && cache->ttl <= 0.0) {
+        covered = (watched & STATCACHE_WATCHED_PARENT) &&
+                  (info->type != STATCACHE_DIRECTORY || (watched & STATCACHE_WATCHED_SELF));
+    }
+#endif
+
+    statcache_write_lock(&cache->lock);
+    if (covered && cache->generation == generation) {
+        statcache_insert(cache, path, length, hash, info, held);
+    }
+#ifdef FSCL_STATCACHE_INOTIFY
+    else if (held) {
+        statcache_unwatch(cache, held[0]);
+        statcache_unwatch(cache, held[1]);
+    }
+#endif
+    statcache_write_unlock(&cache->lock);
+    return info->type == STATCACHE_MISSING ? -1 : 0;
+} // end of func
+
+// Function to check if a path exists
+int fscl_statcache_exists(cstatcache* cache, const char* path) {
+    return fscl_statcache_lookup(cache, path, NULL) == 0;
+} // end of func
+
+// Function to check if a path is a directory
+int fscl_statcache_is_directory(cstatcache* cache, const char* path) {
+    cstatcache_info info;
+    return fscl_statcache_lookup(cache, path, &info) == 0 && info.type == STATCACHE_DIRECTORY;
+} // end of func
+
+// Function to drop the cached metadata of a path
+void fscl_statcache_invalidate(cstatcache* cache, const char* path) {
+    if (!cache || !path) {
+        return;
+    }
+    statcache_write_lock(&cache->lock);
+    statcache_remove(cache, path, statcache_key_length(path));
+    statcache_write_unlock(&cache->lock);
+} // end of func
+
+// Function to drop every cached path
+void fscl_statcache_clear(cstatcache* cache) {
+    if (!cache) {
+        return;
+    }
+    statcache_write_lock(&cache->lock);
+    statcache_remove_all(cache);
+    statcache_write_unlock(&cache->lock);
+} // end of func
+
+// Function to read the counters of a cache
+cstatcache_counters fscl_statcache_counters(cstatcache* cache) {
+    cstatcache_counters counters = {0, 0, 0};
+    if (cache) {
+        statcache_read_lock(&cache->lock);
+        counters.hits = statcache_load(cache->counters.hits);
+        counters.misses = statcache_load(cache->counters.misses);
+        counters.invalidations = cache->counters.invalidations;
+        statcache_read_unlock(&cache->lock);
+    }
+    return counters;
+} // end of func
+
+// Function to route the existence checks through a cache
+void fscl_statcache_install(cstatcache* cache) {
+    statcache_global = cache;
+} // end of func
+
+// Function to get the installed cache
+cstatcache* fscl_statcache_installed(void) {
+    return statcache_global;
+} // end of func
+
+// Function to erase a cache
+void fscl_statcache_erase(cstatcache* cache) {
+    if (!cache) {
+        return;
+    }
+    if (statcache_global == cache) {
+        statcache_global = NULL;
+    }
+#ifdef FSCL_STATCACHE_INOTIFY
+    if (cache->watching) {
+        ssize_t written = write(cache->wake[1], "", 1);
+        (void)written;
+        pthread_join(cache->thread, NULL);
+    }
+    statcache_remove_all(cache); // releases the watches while the directories exist
+    for (size_t i = 0; i < cache->dir_count; ++i) {
+        statcache_dir_free(cache->dirs[i]);
+    }
+    free(cache->dirs);
+    cache->dirs = NULL;
+    cache->dir_count = 0;
+    if (cache->wake[0] >= 0) {
+        close(cache->wake[0]);
+        close(cache->wake[1]);
+    }
+    if (cache->notify_fd >= 0) {
+        close(cache->notify_fd);
+    }
+#endif
+    statcache_remove_all(cache);
+    statcache_lock_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+} // end of func
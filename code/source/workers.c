@@ -0,0 +1,200 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "workers.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define FSCL_WORKERS_THREADED 1
+#endif
+
+typedef struct {
+    fscl_workers_task task;
+    void* arg;
+} fscl_workers_item;
+
+struct fscl_workers {
+    fscl_workers_item* queue; // ring buffer of pending tasks
+    size_t capacity;
+    size_t head;
+    size_t count;
+    size_t pending;           // queued plus running tasks
+    int threads;
+    int stopping;
+#ifdef FSCL_WORKERS_THREADED
+    pthread_mutex_t lock;
+    pthread_cond_t ready;     // signalled when a task is queued
+    pthread_cond_t idle;      // signalled when pending drops to zero
+    pthread_t* handles;
+#endif
+};
+
+// Function to count the processors available to the process
+int fscl_workers_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+} // end of func
+
+static int workers_push(fscl_workers* pool, fscl_workers_task task, void* arg) {
+    if (pool->count == pool->capacity) {
+        size_t capacity = pool->capacity ? pool->capacity * 2 : 64;
+        fscl_workers_item* queue = (fscl_workers_item*)malloc(capacity * sizeof(*queue));
+        if (!queue) {
+            return -1;
+        }
+        for (size_t i = 0; i < pool->count; ++i) {
+            queue[i] = pool->queue[(pool->head + i) % pool->capacity];
+        }
+        free(pool->queue);
+        pool->queue = queue;
+        pool->capacity = capacity;
+        pool->head = 0;
+    }
+    fscl_workers_item* item = &pool->queue[(pool->head + pool->count) % pool->capacity];
+    item->task = task;
+    item->arg = arg;
+    pool->count++;
+    pool->pending++;
+    return 0;
+} // end of func
+
+#ifdef FSCL_WORKERS_THREADED
+static void* workers_main(void* data) {
+    fscl_workers* pool = (fscl_workers*)data;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->count == 0 && !pool->stopping) {
+            pthread_cond_wait(&pool->ready, &pool->lock);
+        }
+        if (pool->count == 0) {
+            break;
+        }
+        fscl_workers_item item = pool->queue[pool->head];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        item.task(item.arg);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->idle);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+} // end of func
+#endif
+
+// Function to start a pool of worker threads
+fscl_workers* fscl_workers_create(int count) {
+    fscl_workers* pool = (fscl_workers*)calloc(1, sizeof(fscl_workers));
+    if (!pool) {
+        return NULL;
+    }
+#ifdef FSCL_WORKERS_THREADED
+    if (count <= 0) {
+        count = fscl_workers_cpu_count();
+    }
+    pool->handles = (pthread_t*)malloc((size_t)count * sizeof(pthread_t));
+    if (!pool->handles) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->ready, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    for (int i = 0; i < count; ++i) {
+        if (pthread_create(&pool->handles[i], NULL, workers_main, pool) != 0) {
+            break;
+        }
+        pool->threads++;
+    }
+#else
+    (void)count;
+#endif
+    return pool;
+} // end of func
+
+// Function to queue a task
+int fscl_workers_submit(fscl_workers* pool, fscl_workers_task task, void* arg) {
+    if (!pool || !task) {
+        return -1;
+    }
+    if (pool->threads == 0) {
+        task(arg); // no threads available, run inline
+        return 0;
+    }
+#ifdef FSCL_WORKERS_THREADED
+    pthread_mutex_lock(&pool->lock);
+    int result = workers_push(pool, task, arg);
+    if (result == 0) {
+        pthread_cond_signal(&pool->ready);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return result;
+#else
+    return workers_push(pool, task, arg);
+#endif
+} // end of func
+
+// Function to wait for every queued task
+void fscl_workers_wait(fscl_workers* pool) {
+    if (!pool || pool->threads == 0) {
+        return;
+    }
+#ifdef FSCL_WORKERS_THREADED
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending != 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+#endif
+} // end of func
+
+// Function to report the number of threads in a pool
+int fscl_workers_count(const fscl_workers* pool) {
+    return pool ? pool->threads : 0;
+} // end of func
+
+// Function to stop a pool and free it
+void fscl_workers_erase(fscl_workers* pool) {
+    if (!pool) {
+        return;
+    }
+#ifdef FSCL_WORKERS_THREADED
+    fscl_workers_wait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->threads; ++i) {
+        pthread_join(pool->handles[i], NULL);
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->handles);
+#endif
+    free(pool->queue);
+    free(pool);
+} // end of func
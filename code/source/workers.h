@@ -0,0 +1,58 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_WORKERS_H
+#define FSCL_WORKERS_H
+
+// Internal worker pool shared by the parallel parts of the library. Not
+// installed; public modules expose their own thread count parameters.
+
+#include <stddef.h>
+
+typedef void (*fscl_workers_task)(void* arg);
+
+typedef struct fscl_workers fscl_workers;
+
+/**
+ * Number of processors available to the process, at least 1.
+ */
+int fscl_workers_cpu_count(void);
+
+/**
+ * Start a pool of worker threads. A count of 0 or less starts one thread
+ * per processor. On platforms without pthreads tasks run inline.
+ */
+fscl_workers* fscl_workers_create(int count);
+
+/**
+ * Queue a task. Tasks may queue further tasks from inside a worker.
+ *
+ * @return 0 on success, -1 if the task could not be queued.
+ */
+int fscl_workers_submit(fscl_workers* pool, fscl_workers_task task, void* arg);
+
+/**
+ * Block until every queued task, including tasks queued by tasks, is done.
+ */
+void fscl_workers_wait(fscl_workers* pool);
+
+/**
+ * Number of threads in the pool, 0 when tasks run inline.
+ */
+int fscl_workers_count(const fscl_workers* pool);
+
+/**
+ * Wait for outstanding work, stop the threads and free the pool.
+ */
+void fscl_workers_erase(fscl_workers* pool);
+
+#endif
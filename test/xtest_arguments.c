@@ -10,14 +10,43 @@ Description:
     feel free to contact Michael at michaelbrockus@gmail.com.
 ==============================================================================
 */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include "fossil/xutil/arguments.h" // lib source code
 
 #include <fossil/xtest.h>   // basic test tools
 #include <fossil/xassert.h> // extra asserts
 
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define setenv(name, value, overwrite) _putenv_s(name, value)
+#endif
+
 //
 // XUNIT TEST DATA
 //
+static const combo_choice tool_modes[] = {{"debug", 0}, {"release", 1}};
+
+#define TOOL_OPTIONS(X, P)                                                                        \
+    X(P, verbose, COPTION_TYPE_BOOL, .bool_val = 0, FSCL_ARG_NO_CHOICES, "Print progress")        \
+    X(P, jobs, COPTION_TYPE_INT, .int_val = 4, FSCL_ARG_NO_CHOICES, "Parallel jobs")              \
+    X(P, mode, COPTION_TYPE_COMBO, .combo_val = 0, FSCL_ARG_CHOICES(tool_modes), "Build mode")
+
+FSCL_ARG_DEFINE_TABLE(tool, TOOL_OPTIONS)
+
+// Records the subcommand that ran and the argument count it saw
+static int tool_dispatch_handler(ccommandline* cmd, coption* options, int num_options, void* user) {
+    (void)options;
+    (void)num_options;
+    *(const char**)user = cmd->argv[0];
+    return cmd->argc;
+}
+
 XTEST_CASE(test_fscl_arg_parse_has) {
     // Test fscl_arg_parse_has function
     coption options[] = {
@@ -50,10 +79,390 @@ XTEST_CASE(test_fscl_arg_parse) {
     TEST_ASSERT_EQUAL_INT(0, options[1].value.bool_val);
 }
 
+XTEST_CASE(test_fscl_arg_index) {
+    // Enough options for the parser to switch to its hash index
+    static char names[40][16];
+    coption options[40];
+    for (int i = 0; i < 40; ++i) {
+        snprintf(names[i], sizeof(names[i]), "opt%d", i);
+        options[i] = (coption){names[i], COPTION_TYPE_INT, {.int_val = 0}, NULL, 0, 0};
+    }
+    options[7].type = COPTION_TYPE_BOOL;
+
+    coption_index index;
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_index_build(&index, options, 40));
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_index_find(&index, "opt0", 4));
+    TEST_ASSERT_EQUAL_INT(39, fscl_arg_index_find(&index, "opt39=1", 5));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_index_find(&index, "opt40", 5));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_index_find(&index, "opt", 3));
+
+    const char* argv[] = {"program", "-opt12", "12", "-opt7", "-opt39", "39"};
+    ccommandline cmd = {6, (char**)argv};
+    fscl_arg_parse_indexed(&cmd, options, &index);
+    TEST_ASSERT_EQUAL_INT(12, options[12].value.int_val);
+    TEST_ASSERT_EQUAL_INT(39, options[39].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_parse_has_indexed(options, &index, "opt7"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_parse_has_indexed(options, &index, "opt8"));
+    fscl_arg_index_erase(&index);
+
+    // The plain entry point gives the same result through a temporary index
+    fscl_arg_reset_parsed_flags(options, 40);
+    options[12].value.int_val = 0;
+    fscl_arg_parse(&cmd, options, 40);
+    TEST_ASSERT_EQUAL_INT(12, options[12].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_parse_has(options, 40, "opt39"));
+}
+
+XTEST_CASE(test_fscl_arg_define_table) {
+    TEST_ASSERT_EQUAL_INT(3, tool_opt_count);
+    TEST_ASSERT_EQUAL_STRING("jobs", tool_options[tool_opt_jobs].name);
+    TEST_ASSERT_EQUAL_INT(4, tool_options[tool_opt_jobs].value.int_val);
+    TEST_ASSERT_EQUAL_INT(2, tool_options[tool_opt_mode].num_choices);
+    TEST_ASSERT_EQUAL_STRING("Build mode", tool_options[tool_opt_mode].help);
+
+    const coption_index* index = tool_index();
+    TEST_ASSERT_EQUAL_INT(tool_opt_mode, fscl_arg_index_find(index, "mode", 4));
+    TEST_ASSERT_TRUE(index == tool_index());
+
+    const char* argv[] = {"tool", "-mode", "release", "-verbose"};
+    ccommandline cmd = {4, (char**)argv};
+    fscl_arg_parse_indexed(&cmd, tool_options, index);
+    TEST_ASSERT_EQUAL_INT(1, tool_options[tool_opt_mode].value.combo_val);
+    TEST_ASSERT_EQUAL_INT(1, tool_options[tool_opt_verbose].value.bool_val);
+    fscl_arg_reset_parsed_flags(tool_options, tool_opt_count);
+}
+
+XTEST_CASE(test_fscl_arg_response_files) {
+    FILE* file = fopen("xtest_arguments_inner.rsp", "wb");
+    fputs("-verbose", file); // no trailing newline on purpose
+    fclose(file);
+    file = fopen("xtest_arguments.rsp", "wb");
+    fputs("-name 'John Smith'\n  -path \"C:\\\\dir \\\"x\\\"\"\n-count 7 @xtest_arguments_inner.rsp\n", file);
+    fclose(file);
+
+    coption options[] = {
+        {"name", COPTION_TYPE_STRING, {.str_val = NULL}, NULL, 0, 0},
+        {"path", COPTION_TYPE_STRING, {.str_val = NULL}, NULL, 0, 0},
+        {"count", COPTION_TYPE_INT, {.int_val = 0}, NULL, 0, 0},
+        {"verbose", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0},
+        {"last", COPTION_TYPE_INT, {.int_val = 0}, NULL, 0, 0}
+    };
+    const char* argv[] = {"program", "@xtest_arguments.rsp", "@xtest_arguments_missing.rsp", "-last", "3"};
+    ccommandline cmd = {5, (char**)argv};
+
+    carg_tokens tokens;
+    fscl_arg_tokens_init(&tokens, &cmd);
+    fscl_arg_parse_stream(fscl_arg_tokens_next, &tokens, options, 5, NULL);
+    TEST_ASSERT_EQUAL_STRING("John Smith", options[0].value.str_val);
+    TEST_ASSERT_EQUAL_STRING("C:\\dir \"x\"", options[1].value.str_val);
+    TEST_ASSERT_EQUAL_INT(7, options[2].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, options[3].value.bool_val);
+    TEST_ASSERT_EQUAL_INT(3, options[4].value.int_val);
+    fscl_arg_tokens_close(&tokens);
+
+    // A value missing at the end of the input leaves the option alone
+    const char* short_argv[] = {"program", "-count"};
+    ccommandline short_cmd = {2, (char**)short_argv};
+    fscl_arg_parse(&short_cmd, options, 5);
+    TEST_ASSERT_EQUAL_INT(7, options[2].value.int_val);
+
+    remove("xtest_arguments.rsp");
+    remove("xtest_arguments_inner.rsp");
+}
+
+XTEST_CASE(test_fscl_arg_parse_missing_value) {
+    coption options[] = {
+        {"verbose", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0},
+        {"count", COPTION_TYPE_INT, {.int_val = 5}, NULL, 0, 0}
+    };
+    const char* argv[] = {"program", "-verbose", "-count"};
+    ccommandline cmd = {3, (char**)argv};
+    fscl_arg_parse(&cmd, options, 2);
+
+    // The trailing option never got its value, so it is not marked parsed
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_parse_has(options, 2, "verbose"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_parse_has(options, 2, "count"));
+    TEST_ASSERT_EQUAL_INT(5, options[1].value.int_val);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_DEFAULT, options[1].source);
+}
+
 //
 // XUNIT-TEST RUNNER
 //
+XTEST_CASE(test_fscl_arg_parse_checked) {
+    combo_choice modes[] = {{"fast", 1}, {"safe", 2}};
+    coption options[] = {
+        {"v", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0},
+        {"x", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0},
+        {"j", COPTION_TYPE_INT, {.int_val = 1}, NULL, 0, 0},
+        {"offset", COPTION_TYPE_INT64, {.int64_val = 0}, NULL, 0, 0},
+        {"ratio", COPTION_TYPE_DOUBLE, {.double_val = 0.0}, NULL, 0, 0},
+        {"cache", COPTION_TYPE_SIZE, {.size_val = 0}, NULL, 0, 0},
+        {"mode", COPTION_TYPE_COMBO, {.combo_val = 0}, modes, 2, 0},
+        {"level", COPTION_TYPE_INT, {.int_val = 5}, NULL, 0, 0},
+        {"color", COPTION_TYPE_BOOL, {.bool_val = 1}, NULL, 0, 0}
+    };
+    const char* argv[] = {"program", "-vxj4", "--offset=-9223372036854775808", "-ratio", "0.25",
+                          "--cache", "64MiB", "-mode=slow", "-level", "99999999999", "--color=off",
+                          "-bogus", "--", "-ignored", "-ratio"};
+    ccommandline cmd = {15, (char**)argv};
+
+    carg_errors errors;
+    int problems = fscl_arg_parse_checked(&cmd, options, 9, NULL, &errors);
+    TEST_ASSERT_EQUAL_INT(3, problems);
+    TEST_ASSERT_EQUAL_INT(1, options[0].value.bool_val);
+    TEST_ASSERT_EQUAL_INT(1, options[1].value.bool_val);
+    TEST_ASSERT_EQUAL_INT(4, options[2].value.int_val);
+    TEST_ASSERT_TRUE(options[3].value.int64_val == LLONG_MIN);
+    TEST_ASSERT_TRUE(options[4].value.double_val == 0.25);
+    TEST_ASSERT_TRUE(options[5].value.size_val == (size_t)64 << 20);
+    TEST_ASSERT_EQUAL_INT(0, options[7].parsed);
+    TEST_ASSERT_EQUAL_INT(5, options[7].value.int_val);
+    TEST_ASSERT_EQUAL_INT(0, options[8].value.bool_val);
+
+    TEST_ASSERT_EQUAL_INT(3, errors.count);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_INVALID_VALUE, errors.errors[0].code);
+    TEST_ASSERT_EQUAL_INT(7, errors.errors[0].position);
+    TEST_ASSERT_EQUAL_INT(6, errors.errors[0].option);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_OUT_OF_RANGE, errors.errors[1].code);
+    TEST_ASSERT_EQUAL_INT(8, errors.errors[1].position);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_UNKNOWN_OPTION, errors.errors[2].code);
+    TEST_ASSERT_EQUAL_STRING("-bogus", errors.errors[2].argument);
+    TEST_ASSERT_EQUAL_STRING("invalid value", fscl_arg_error_string(errors.errors[0].code));
+    fscl_arg_errors_erase(&errors);
+
+    // Flags take no value beyond an explicit on/off spelling
+    const char* flag_argv[] = {"program", "-x=no", "--color=value", "-vx=1"};
+    ccommandline flag_cmd = {4, (char**)flag_argv};
+    TEST_ASSERT_EQUAL_INT(2, fscl_arg_parse_checked(&flag_cmd, options, 9, NULL, &errors));
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_UNEXPECTED_VALUE, errors.errors[0].code);
+    TEST_ASSERT_EQUAL_INT(8, errors.errors[0].option);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_UNEXPECTED_VALUE, errors.errors[1].code);
+    TEST_ASSERT_EQUAL_STRING("-vx=1", errors.errors[1].argument);
+    TEST_ASSERT_EQUAL_INT(0, options[8].value.bool_val);
+    TEST_ASSERT_EQUAL_INT(0, options[1].value.bool_val);
+    TEST_ASSERT_EQUAL_STRING("option takes no value", fscl_arg_error_string(errors.errors[0].code));
+    fscl_arg_errors_erase(&errors);
+
+    // A trailing option without its value is reported rather than fatal
+    const char* short_argv[] = {"program", "-j"};
+    ccommandline short_cmd = {2, (char**)short_argv};
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_parse_checked(&short_cmd, options, 9, NULL, &errors));
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_MISSING_VALUE, errors.errors[0].code);
+    TEST_ASSERT_EQUAL_INT(4, options[2].value.int_val);
+    fscl_arg_errors_erase(&errors);
+}
+
+XTEST_CASE(test_fscl_arg_dispatch) {
+    coption add_options[] = {
+        {"fetch", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0}
+    };
+    const csubcommand remote_commands[] = {
+        {"add", tool_dispatch_handler, add_options, 1, NULL, NULL, "Add a remote"},
+        {"remove", tool_dispatch_handler, NULL, 0, NULL, NULL, "Remove a remote"}
+    };
+    coption_slot remote_slots[5];
+    csubcommand_registry remotes;
+    fscl_arg_registry_init(&remotes, remote_commands, 2, remote_slots, 5);
+
+    const csubcommand commands[] = {
+        {"build", tool_dispatch_handler, tool_options, tool_opt_count, tool_index, NULL, "Build the project"},
+        {"remote", NULL, NULL, 0, NULL, &remotes, "Manage remotes"},
+        {"clean", tool_dispatch_handler, NULL, 0, NULL, NULL, "Remove build output"}
+    };
+    csubcommand_registry registry;
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_registry_build(&registry, commands, 3));
+    TEST_ASSERT_TRUE(fscl_arg_registry_find(&registry, "clean", 5) == &commands[2]);
+    TEST_ASSERT_CNULLPTR(fscl_arg_registry_find(&registry, "cle", 3));
+
+    const char* ran = NULL;
+    int status = 0;
+    const char* build_argv[] = {"multitool", "build", "-jobs", "8"};
+    ccommandline build = {4, (char**)build_argv};
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_dispatch(&registry, &build, &ran, &status, NULL));
+    TEST_ASSERT_EQUAL_STRING("build", ran);
+    TEST_ASSERT_EQUAL_INT(3, status);
+    TEST_ASSERT_EQUAL_INT(8, tool_options[tool_opt_jobs].value.int_val);
+    tool_options[tool_opt_jobs].value.int_val = 4;
+    fscl_arg_reset_parsed_flags(tool_options, tool_opt_count);
+
+    const char* add_argv[] = {"multitool", "remote", "add", "-fetch", "origin"};
+    ccommandline add = {5, (char**)add_argv};
+    int words = 0;
+    TEST_ASSERT_TRUE(fscl_arg_registry_select(&registry, &add, &words) == &remote_commands[0]);
+    TEST_ASSERT_EQUAL_INT(2, words);
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_dispatch(&registry, &add, &ran, &status, NULL));
+    TEST_ASSERT_EQUAL_STRING("add", ran);
+    TEST_ASSERT_EQUAL_INT(1, add_options[0].value.bool_val);
+
+    // Bad options are returned to the caller and the handler does not run
+    const char* bad_argv[] = {"multitool", "build", "-jobs", "many"};
+    ccommandline bad = {4, (char**)bad_argv};
+    carg_errors errors;
+    ran = NULL;
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_dispatch(&registry, &bad, &ran, &status, &errors));
+    TEST_ASSERT_CNULLPTR(ran);
+    TEST_ASSERT_EQUAL_INT(1, errors.count);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_INVALID_VALUE, errors.errors[0].code);
+    fscl_arg_errors_erase(&errors);
+    fscl_arg_reset_parsed_flags(tool_options, tool_opt_count);
+
+    // A group without a handler or an unknown name does not dispatch
+    const char* group_argv[] = {"multitool", "remote", "list"};
+    ccommandline group = {3, (char**)group_argv};
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_dispatch(&registry, &group, &ran, &status, NULL));
+    const char* unknown_argv[] = {"multitool", "deploy"};
+    ccommandline unknown = {2, (char**)unknown_argv};
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_dispatch(&registry, &unknown, &ran, &status, NULL));
+
+    carg_render render = {0};
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_render_registry(&render, "multitool", &registry, 40));
+    TEST_ASSERT_EQUAL_STRING("Usage: multitool <command> [options]\n\nCommands:\n"
+                             "  build   Build the project\n"
+                             "  remote  Manage remotes\n"
+                             "  clean   Remove build output\n", render.data);
+    fscl_arg_render_erase(&render);
+    fscl_arg_registry_erase(&registry);
+}
+
+XTEST_CASE(test_fscl_arg_resolve) {
+    FILE* file = fopen("xtest_arguments.conf", "wb");
+    fputs("# defaults for every tool\njobs = 2\nname = \"from config\"\n\n[other]\nlevel = 1\n"
+          "[tool]\nlevel = 3\nverbose\nratio = nope\nmissing = 1\ncolor = off", file);
+    fclose(file);
+    setenv("XTEST_ARGS_JOBS", "6", 1);
+    setenv("XTEST_ARGS_CACHE_SIZE", "2k", 1);
+
+    coption options[] = {
+        {"jobs", COPTION_TYPE_INT, {.int_val = 1}, NULL, 0, 0},
+        {"name", COPTION_TYPE_STRING, {.str_val = "default"}, NULL, 0, 0},
+        {"level", COPTION_TYPE_INT, {.int_val = 0}, NULL, 0, 0},
+        {"verbose", COPTION_TYPE_BOOL, {.bool_val = 0}, NULL, 0, 0},
+        {"ratio", COPTION_TYPE_DOUBLE, {.double_val = 0.5}, NULL, 0, 0},
+        {"cache-size", COPTION_TYPE_SIZE, {.size_val = 0}, NULL, 0, 0},
+        {"color", COPTION_TYPE_BOOL, {.bool_val = 1}, NULL, 0, 0},
+        {"seed", COPTION_TYPE_INT, {.int_val = 7}, NULL, 0, 0}
+    };
+    const char* argv[] = {"tool", "-jobs", "9"};
+    ccommandline cmd = {3, (char**)argv};
+
+    carg_layers layers = {.config_path = "xtest_arguments.conf", .section = "tool", .env_prefix = "XTEST_ARGS"};
+    carg_errors errors;
+    TEST_ASSERT_EQUAL_INT(2, fscl_arg_resolve(&layers, &cmd, options, 8, NULL, &errors));
+    TEST_ASSERT_EQUAL_INT(9, options[0].value.int_val);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_COMMAND_LINE, options[0].source);
+    TEST_ASSERT_EQUAL_STRING("from config", options[1].value.str_val);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_CONFIG, options[1].source);
+    TEST_ASSERT_EQUAL_INT(3, options[2].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, options[3].value.bool_val);
+    TEST_ASSERT_TRUE(options[4].value.double_val == 0.5);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_DEFAULT, options[4].source);
+    TEST_ASSERT_TRUE(options[5].value.size_val == 2048);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_ENVIRONMENT, options[5].source);
+    TEST_ASSERT_EQUAL_INT(0, options[6].value.bool_val);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_DEFAULT, options[7].source);
+
+    TEST_ASSERT_EQUAL_INT(2, errors.count);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_INVALID_VALUE, errors.errors[0].code);
+    TEST_ASSERT_EQUAL_INT(10, errors.errors[0].position);
+    TEST_ASSERT_EQUAL_STRING("ratio", errors.errors[0].argument);
+    TEST_ASSERT_EQUAL_INT(CARG_ERROR_UNKNOWN_OPTION, errors.errors[1].code);
+    TEST_ASSERT_EQUAL_STRING("missing", errors.errors[1].argument);
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_CONFIG, errors.errors[1].source);
+    fscl_arg_errors_erase(&errors);
+    fscl_arg_layers_close(&layers);
+
+    // A missing config file is skipped
+    carg_layers none = {.config_path = "xtest_arguments_missing.conf"};
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_resolve(&none, NULL, options, 8, NULL, &errors));
+    fscl_arg_errors_erase(&errors);
+    fscl_arg_layers_close(&none);
+    remove("xtest_arguments.conf");
+}
+
+XTEST_CASE(test_fscl_arg_render) {
+    combo_choice modes[] = {{"debug", 0}, {"release", 1}};
+    coption options[] = {
+        {"jobs", COPTION_TYPE_INT, {.int_val = 4}, NULL, 0, 1, "Number of jobs run in parallel by the build"},
+        {"mode", COPTION_TYPE_COMBO, {.combo_val = 1}, modes, 2, 0, "Build mode"},
+        {"name", COPTION_TYPE_STRING, {.str_val = "a \"b\""}, NULL, 0, 0, NULL}
+    };
+    carg_render render = {0};
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_render_usage(&render, "tool", options, 3, 60));
+    TEST_ASSERT_EQUAL_STRING("Usage: tool [options]\n\nOptions:\n"
+                             "  -jobs <int>            Number of jobs run in parallel by\n"
+                             "                         the build\n"
+                             "  -mode {debug|release}  Build mode\n"
+                             "  -name <string>\n", render.data);
+    render.length = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_render_options(&render, options, 3, CARG_RENDER_JSON));
+    TEST_ASSERT_EQUAL_STRING("{\n"
+                             "  \"jobs\": {\"type\": \"int\", \"value\": 4, \"parsed\": true, \"source\": \"default\"},\n"
+                             "  \"mode\": {\"type\": \"combo\", \"value\": \"release\", \"parsed\": false, \"source\": \"default\"},\n"
+                             "  \"name\": {\"type\": \"string\", \"value\": \"a \\\"b\\\"\", \"parsed\": false, \"source\": \"default\"}\n"
+                             "}\n", render.data);
+    render.length = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_render_options(&render, options, 1, CARG_RENDER_TEXT));
+    TEST_ASSERT_EQUAL_STRING("Option: jobs, Parsed: true, Value: 4, Source: default\n", render.data);
+    fscl_arg_render_erase(&render);
+
+    // COLUMNS must name a positive width, anything else falls back to 80
+    setenv("COLUMNS", "-5", 1);
+    TEST_ASSERT_EQUAL_INT(80, fscl_arg_terminal_width(-1));
+    setenv("COLUMNS", "0", 1);
+    TEST_ASSERT_EQUAL_INT(80, fscl_arg_terminal_width(-1));
+    setenv("COLUMNS", "120", 1);
+    TEST_ASSERT_EQUAL_INT(120, fscl_arg_terminal_width(-1));
+    setenv("COLUMNS", "", 1);
+}
+
+XTEST_CASE(test_fscl_arg_parse_result) {
+    const coption_index* schema = tool_index();
+    _Alignas(max_align_t) char buffer[512];
+    carg_arena arena;
+    fscl_arg_arena_init(&arena, buffer, sizeof(buffer));
+
+    const char* first_argv[] = {"tool", "-jobs", "16", "-mode", "release"};
+    ccommandline first_cmd = {5, (char**)first_argv};
+    const char* second_argv[] = {"tool", "-verbose", "-jobs=x"};
+    ccommandline second_cmd = {3, (char**)second_argv};
+
+    carg_result first;
+    carg_result second;
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_parse_result(schema, &first_cmd, &arena, &first, NULL));
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_parse_result(schema, &second_cmd, &arena, &second, NULL));
+    TEST_ASSERT_EQUAL_INT(16, first.values[tool_opt_jobs].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_result_get(&first, "mode")->combo_val);
+    TEST_ASSERT_EQUAL_INT(0, fscl_arg_result_has(&first, "verbose"));
+    TEST_ASSERT_EQUAL_INT(4, second.values[tool_opt_jobs].value.int_val);
+    TEST_ASSERT_EQUAL_INT(1, fscl_arg_result_has(&second, "verbose"));
+    TEST_ASSERT_EQUAL_INT(CARG_SOURCE_COMMAND_LINE, second.values[tool_opt_verbose].source);
+    TEST_ASSERT_CNULLPTR(fscl_arg_result_get(&second, "missing"));
+
+    // The schema keeps its defaults and parsed flags
+    TEST_ASSERT_EQUAL_INT(4, tool_options[tool_opt_jobs].value.int_val);
+    TEST_ASSERT_EQUAL_INT(0, tool_options[tool_opt_verbose].parsed);
+
+    // An arena too small for the values fails cleanly
+    carg_arena tiny;
+    fscl_arg_arena_init(&tiny, buffer, sizeof(carg_value));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_arg_parse_result(schema, &first_cmd, &tiny, &first, NULL));
+    fscl_arg_arena_reset(&arena);
+    TEST_ASSERT_TRUE(arena.used == 0);
+}
+
 XTEST_DEFINE_POOL(test_parser_group) {
     XTEST_RUN_UNIT(test_fscl_arg_parse_has);
     XTEST_RUN_UNIT(test_fscl_arg_parse);
+    XTEST_RUN_UNIT(test_fscl_arg_index);
+    XTEST_RUN_UNIT(test_fscl_arg_define_table);
+    XTEST_RUN_UNIT(test_fscl_arg_response_files);
+    XTEST_RUN_UNIT(test_fscl_arg_parse_missing_value);
+    XTEST_RUN_UNIT(test_fscl_arg_parse_checked);
+    XTEST_RUN_UNIT(test_fscl_arg_dispatch);
+    XTEST_RUN_UNIT(test_fscl_arg_resolve);
+    XTEST_RUN_UNIT(test_fscl_arg_render);
+    XTEST_RUN_UNIT(test_fscl_arg_parse_result);
 } // end of function main
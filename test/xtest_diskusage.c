@@ -0,0 +1,151 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/diskusage.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//
+// XUNIT TEST DATA
+//
+static void diskusage_write(const char* path, size_t size) {
+    FILE* file = fopen(path, "wb");
+    for (size_t i = 0; i < size; ++i) {
+        fputc('x', file);
+    }
+    fclose(file);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_diskusage_invalid) {
+    cdiskusage_tree tree;
+    cfilesystem missing = fscl_filesys_create("xtest_diskusage_missing");
+    TEST_ASSERT_EQUAL_INT(-1, fscl_diskusage_scan(&missing, -1, 0, &tree));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_diskusage_scan(NULL, -1, 0, &tree));
+    fscl_filesys_erase(&missing);
+}
+
+#ifndef _WIN32
+XTEST_CASE(test_fscl_diskusage_tree) {
+    cfilesystem deep = fscl_filesys_create("xtest_diskusage/a/deep/deeper");
+    cfilesystem other = fscl_filesys_create("xtest_diskusage/b");
+    fscl_filesys_create_directories(&deep);
+    fscl_filesys_create_directories(&other);
+    diskusage_write("xtest_diskusage/top.txt", 100);
+    diskusage_write("xtest_diskusage/a/one.txt", 10);
+    diskusage_write("xtest_diskusage/a/deep/two.txt", 20);
+    diskusage_write("xtest_diskusage/a/deep/deeper/three.txt", 30);
+    diskusage_write("xtest_diskusage/b/four.txt", 40);
+    TEST_ASSERT_EQUAL_INT(0, link("xtest_diskusage/b/four.txt", "xtest_diskusage/b/again.txt"));
+
+    cfilesystem root = fscl_filesys_create("xtest_diskusage");
+    cdiskusage_tree tree;
+    TEST_ASSERT_EQUAL_INT(0, fscl_diskusage_scan(&root, 1, 2, &tree));
+    TEST_ASSERT_EQUAL_INT(0, (int)tree.errors);
+
+    // Depth 1 keeps a and b, deeper directories fold into a
+    TEST_ASSERT_EQUAL_INT(3, (int)tree.count);
+    TEST_ASSERT_EQUAL_STRING("xtest_diskusage", tree.nodes[0].name);
+    TEST_ASSERT_EQUAL_STRING("a", tree.nodes[1].name);
+    TEST_ASSERT_EQUAL_STRING("b", tree.nodes[2].name);
+    TEST_ASSERT_TRUE(tree.nodes[2].parent == 0);
+    TEST_ASSERT_TRUE(tree.nodes[2].next_sibling == FSCL_DISKUSAGE_NONE);
+
+    const cdiskusage_node* a = fscl_diskusage_find(&tree, "a");
+    const cdiskusage_node* b = fscl_diskusage_find(&tree, "b");
+    TEST_ASSERT_NOT_CNULLPTR(a);
+    TEST_ASSERT_NOT_CNULLPTR(b);
+    TEST_ASSERT_CNULLPTR(fscl_diskusage_find(&tree, "a/deep"));
+    TEST_ASSERT_EQUAL_INT(3, (int)a->files);
+    TEST_ASSERT_EQUAL_INT(3, (int)a->directories);
+    TEST_ASSERT_EQUAL_INT(1, (int)b->files); // the hard link is counted once
+
+    // Directory entries have sizes of their own, so compare against the files
+    TEST_ASSERT_TRUE(a->apparent_size >= 60);
+    struct stat info;
+    TEST_ASSERT_EQUAL_INT(0, stat("xtest_diskusage/b", &info));
+    TEST_ASSERT_TRUE(b->apparent_size == (uint64_t)info.st_size + 40);
+    TEST_ASSERT_EQUAL_INT(5, (int)tree.nodes[0].files);
+    TEST_ASSERT_EQUAL_INT(5, (int)tree.nodes[0].directories);
+    TEST_ASSERT_TRUE(tree.nodes[0].apparent_size >= a->apparent_size + b->apparent_size + 100);
+    fscl_diskusage_erase(&tree);
+
+    // Without a depth limit every directory gets a node
+    TEST_ASSERT_EQUAL_INT(0, fscl_diskusage_scan(&root, -1, 0, &tree));
+    TEST_ASSERT_EQUAL_INT(5, (int)tree.count);
+    const cdiskusage_node* deeper = fscl_diskusage_find(&tree, "a/deep/deeper");
+    TEST_ASSERT_NOT_CNULLPTR(deeper);
+    TEST_ASSERT_EQUAL_INT(3, deeper->depth);
+    TEST_ASSERT_EQUAL_INT(1, (int)deeper->files);
+    fscl_diskusage_erase(&tree);
+
+    fscl_filesys_remove_all(&root, 0);
+    fscl_filesys_erase(&root);
+    fscl_filesys_erase(&deep);
+    fscl_filesys_erase(&other);
+}
+
+XTEST_CASE(test_fscl_diskusage_parallel) {
+    // Far more directories than the queue holds at once (4 per thread)
+    char path[96];
+    for (int i = 0; i < 32; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            snprintf(path, sizeof(path), "xtest_diskusage_wide/d%02d/s%d", i, j);
+            cfilesystem dir = fscl_filesys_create(path);
+            fscl_filesys_create_directories(&dir);
+            fscl_filesys_erase(&dir);
+        }
+    }
+
+    // Workers pick up directories as queue slots free, and the result
+    // matches a single worker scan node for node
+    cfilesystem root = fscl_filesys_create("xtest_diskusage_wide");
+    cdiskusage_tree serial;
+    cdiskusage_tree tree;
+    TEST_ASSERT_EQUAL_INT(0, fscl_diskusage_scan(&root, -1, 1, &serial));
+    TEST_ASSERT_EQUAL_INT(0, fscl_diskusage_scan(&root, -1, 4, &tree));
+    TEST_ASSERT_EQUAL_INT(1 + 32 + 32 * 8, (int)tree.count);
+    TEST_ASSERT_EQUAL_INT((int)serial.count, (int)tree.count);
+    for (size_t i = 0; i < tree.count; ++i) {
+        TEST_ASSERT_EQUAL_STRING(serial.nodes[i].name, tree.nodes[i].name);
+        TEST_ASSERT_TRUE(serial.nodes[i].parent == tree.nodes[i].parent);
+        TEST_ASSERT_TRUE(serial.nodes[i].apparent_size == tree.nodes[i].apparent_size);
+    }
+    fscl_diskusage_erase(&serial);
+    fscl_diskusage_erase(&tree);
+
+    fscl_filesys_remove_all(&root, 0);
+    fscl_filesys_erase(&root);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_diskusage_group) {
+    XTEST_RUN_UNIT(test_fscl_diskusage_invalid);
+#ifndef _WIN32
+    XTEST_RUN_UNIT(test_fscl_diskusage_tree);
+    XTEST_RUN_UNIT(test_fscl_diskusage_parallel);
+#endif
+} // end of func
@@ -0,0 +1,116 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/fileglob.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <stdio.h>
+#include <string.h>
+
+//
+// XUNIT TEST DATA
+//
+typedef struct {
+    int count;
+    int sources;
+    int headers;
+} fileglob_tally;
+
+static int fileglob_count(const char* path, int is_directory, size_t pattern, void* user) {
+    fileglob_tally* tally = (fileglob_tally*)user;
+    (void)path;
+    (void)is_directory;
+    tally->count++;
+    if (pattern == 0) {
+        tally->sources++;
+    } else {
+        tally->headers++;
+    }
+    return 0;
+}
+
+static void fileglob_touch(const char* path) {
+    FILE* file = fopen(path, "wb");
+    fclose(file);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_fileglob_match) {
+    const char* patterns[] = {"*.{c,h}", "src/**/test_?.c", "lib/[a-c]*.so", "docs/[!x]*", "a\\*b", "**/build"};
+    cfileglob* glob = fscl_fileglob_compile(patterns, 6);
+    TEST_ASSERT_NOT_CNULLPTR(glob);
+
+    TEST_ASSERT_EQUAL_INT(0, (int)fscl_fileglob_match(glob, "main.c"));
+    TEST_ASSERT_EQUAL_INT(0, (int)fscl_fileglob_match(glob, "main.h"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "main.o"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "dir/main.c"));
+    TEST_ASSERT_EQUAL_INT(1, (int)fscl_fileglob_match(glob, "src/test_a.c"));
+    TEST_ASSERT_EQUAL_INT(1, (int)fscl_fileglob_match(glob, "src/x/y/test_b.c"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "src/x/test_ab.c"));
+    TEST_ASSERT_EQUAL_INT(2, (int)fscl_fileglob_match(glob, "lib/breeze.so"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "lib/dawn.so"));
+    TEST_ASSERT_EQUAL_INT(3, (int)fscl_fileglob_match(glob, "docs/readme"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "docs/xref"));
+    TEST_ASSERT_EQUAL_INT(4, (int)fscl_fileglob_match(glob, "a*b"));
+    TEST_ASSERT_EQUAL_INT(-1, (int)fscl_fileglob_match(glob, "axb"));
+    TEST_ASSERT_EQUAL_INT(5, (int)fscl_fileglob_match(glob, "build"));
+    TEST_ASSERT_EQUAL_INT(5, (int)fscl_fileglob_match(glob, "./one/two/build"));
+    fscl_fileglob_erase(glob);
+
+    const char* empty[] = {"/"};
+    TEST_ASSERT_CNULLPTR(fscl_fileglob_compile(empty, 1));
+}
+
+#ifndef _WIN32
+XTEST_CASE(test_fscl_fileglob_walk) {
+    cfilesystem deep = fscl_filesys_create("xtest_fileglob/src/core");
+    cfilesystem other = fscl_filesys_create("xtest_fileglob/include");
+    fscl_filesys_create_directories(&deep);
+    fscl_filesys_create_directories(&other);
+    fileglob_touch("xtest_fileglob/src/main.c");
+    fileglob_touch("xtest_fileglob/src/main.o");
+    fileglob_touch("xtest_fileglob/src/core/engine.c");
+    fileglob_touch("xtest_fileglob/include/engine.h");
+    fileglob_touch("xtest_fileglob/include/notes.txt");
+
+    const char* patterns[] = {"src/**/*.c", "include/engine.h"};
+    cfileglob* glob = fscl_fileglob_compile(patterns, 2);
+    TEST_ASSERT_NOT_CNULLPTR(glob);
+    fileglob_tally tally = {0, 0, 0};
+    TEST_ASSERT_EQUAL_INT(3, (int)fscl_fileglob_walk(glob, "xtest_fileglob", fileglob_count, &tally));
+    TEST_ASSERT_EQUAL_INT(3, tally.count);
+    TEST_ASSERT_EQUAL_INT(2, tally.sources);
+    TEST_ASSERT_EQUAL_INT(1, tally.headers);
+    fscl_fileglob_erase(glob);
+
+    cfilesystem root = fscl_filesys_create("xtest_fileglob");
+    fscl_filesys_remove_all(&root, 0);
+    fscl_filesys_erase(&root);
+    fscl_filesys_erase(&deep);
+    fscl_filesys_erase(&other);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_fileglob_group) {
+    XTEST_RUN_UNIT(test_fscl_fileglob_match);
+#ifndef _WIN32
+    XTEST_RUN_UNIT(test_fscl_fileglob_walk);
+#endif
+} // end of func
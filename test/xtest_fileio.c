@@ -0,0 +1,158 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/fileio.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//
+// XUNIT TEST DATA
+//
+#define FILEIO_TEST_FILES 32
+
+static int fileio_callbacks = 0;
+
+static void fileio_count_callback(cfileio_request* request, void* user) {
+    (void)request;
+    (void)user;
+    fileio_callbacks++;
+}
+
+// Chain a write onto each finished open from inside the callback
+static void fileio_open_callback(cfileio_request* request, void* user) {
+    cfileio* io = (cfileio*)user;
+    if (request->result >= 0) {
+        cfileio_request* write = request + FILEIO_TEST_FILES;
+        write->fd = (int)request->result;
+        fscl_fileio_submit(io, write, 1);
+    }
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_fileio_batch) {
+    cfileio* io = fscl_fileio_create(8, 2);
+    TEST_ASSERT_NOT_CNULLPTR(io);
+
+    static char names[FILEIO_TEST_FILES][32];
+    static cfileio_request requests[FILEIO_TEST_FILES * 2];
+    static cfileio_stat infos[FILEIO_TEST_FILES];
+    memset(requests, 0, sizeof(requests));
+    for (int i = 0; i < FILEIO_TEST_FILES; ++i) {
+        snprintf(names[i], sizeof(names[i]), "xtest_fileio_%d.tmp", i);
+        requests[i].op = FILEIO_OP_OPEN;
+        requests[i].path = names[i];
+        requests[i].flags = O_CREAT | O_WRONLY | O_TRUNC;
+        requests[i].mode = 0644;
+        requests[i].callback = fileio_open_callback;
+        requests[i].user = io;
+
+        cfileio_request* write = &requests[FILEIO_TEST_FILES + i];
+        write->op = FILEIO_OP_WRITE;
+        write->buffer = "fossil";
+        write->length = 6;
+    }
+    TEST_ASSERT_EQUAL_INT(FILEIO_TEST_FILES, fscl_fileio_submit(io, requests, FILEIO_TEST_FILES));
+    TEST_ASSERT_EQUAL_INT(0, fscl_fileio_wait(io));
+
+    // Close, stat and unlink everything in follow-up batches
+    for (int i = 0; i < FILEIO_TEST_FILES; ++i) {
+        TEST_ASSERT_EQUAL_INT(6, requests[FILEIO_TEST_FILES + i].result);
+        int fd = requests[FILEIO_TEST_FILES + i].fd;
+        memset(&requests[i], 0, sizeof(cfileio_request));
+        requests[i].op = FILEIO_OP_CLOSE;
+        requests[i].fd = fd;
+        memset(&requests[FILEIO_TEST_FILES + i], 0, sizeof(cfileio_request));
+        requests[FILEIO_TEST_FILES + i].op = FILEIO_OP_STAT;
+        requests[FILEIO_TEST_FILES + i].path = names[i];
+        requests[FILEIO_TEST_FILES + i].info = &infos[i];
+    }
+    fscl_fileio_submit(io, requests, FILEIO_TEST_FILES * 2);
+    TEST_ASSERT_EQUAL_INT(0, fscl_fileio_wait(io));
+    for (int i = 0; i < FILEIO_TEST_FILES; ++i) {
+        TEST_ASSERT_EQUAL_INT(6, infos[i].size);
+    }
+
+    fileio_callbacks = 0;
+    for (int i = 0; i < FILEIO_TEST_FILES; ++i) {
+        memset(&requests[i], 0, sizeof(cfileio_request));
+        requests[i].op = FILEIO_OP_UNLINK;
+        requests[i].path = names[i];
+        requests[i].callback = fileio_count_callback;
+    }
+    fscl_fileio_submit(io, requests, FILEIO_TEST_FILES);
+    TEST_ASSERT_EQUAL_INT(0, fscl_fileio_wait(io));
+    TEST_ASSERT_EQUAL_INT(FILEIO_TEST_FILES, fileio_callbacks);
+
+    fscl_fileio_erase(io);
+}
+
+XTEST_CASE(test_fscl_fileio_errors) {
+    cfileio* io = fscl_fileio_create(0, 1);
+    cfileio_request request;
+    memset(&request, 0, sizeof(request));
+    request.op = FILEIO_OP_UNLINK;
+    request.path = "xtest_fileio_missing.tmp";
+
+    fscl_fileio_submit(io, &request, 1);
+    TEST_ASSERT_EQUAL_INT(1, fscl_fileio_wait(io));
+    TEST_ASSERT_TRUE(request.result < 0);
+    fscl_fileio_erase(io);
+}
+
+#ifndef _WIN32
+XTEST_CASE(test_fscl_fileio_submit_starts) {
+    cfileio* io = fscl_fileio_create(0, 1);
+    cfileio_request request;
+    memset(&request, 0, sizeof(request));
+    request.op = FILEIO_OP_MKDIR;
+    request.path = "xtest_fileio_started";
+    request.mode = 0755;
+
+    // The operation runs without anyone calling fscl_fileio_wait
+    TEST_ASSERT_EQUAL_INT(1, fscl_fileio_submit(io, &request, 1));
+    int started = 0;
+    time_t deadline = time(NULL) + 2;
+    while (!started && time(NULL) <= deadline) {
+        started = access("xtest_fileio_started", F_OK) == 0;
+    }
+    TEST_ASSERT_TRUE(started);
+    TEST_ASSERT_EQUAL_INT(0, fscl_fileio_wait(io));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_fileio_submit(NULL, &request, 1));
+
+    request.op = FILEIO_OP_RMDIR;
+    TEST_ASSERT_EQUAL_INT(1, fscl_fileio_submit(io, &request, 1));
+    TEST_ASSERT_EQUAL_INT(0, fscl_fileio_wait(io));
+    fscl_fileio_erase(io);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_fileio_group) {
+    XTEST_RUN_UNIT(test_fscl_fileio_batch);
+    XTEST_RUN_UNIT(test_fscl_fileio_errors);
+#ifndef _WIN32
+    XTEST_RUN_UNIT(test_fscl_fileio_submit_starts);
+#endif
+} // end of func
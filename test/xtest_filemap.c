@@ -0,0 +1,109 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/filemap.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <stdio.h>
+#include <string.h>
+
+//
+// XUNIT TEST DATA
+//
+static const char* filemap_path = "xtest_filemap.tmp";
+
+static void filemap_write_fixture(size_t size) {
+    FILE* file = fopen(filemap_path, "wb");
+    for (size_t i = 0; i < size; ++i) {
+        fputc('a' + (int)(i % 26), file);
+    }
+    fclose(file);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_filemap_open_read_only) {
+    filemap_write_fixture(100);
+
+    cfilemap map;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_ONLY, 0));
+    TEST_ASSERT_EQUAL_INT(100, map.size);
+    TEST_ASSERT_EQUAL_INT(100, map.length);
+    TEST_ASSERT_EQUAL_INT('a', map.data[0]);
+    TEST_ASSERT_EQUAL_INT('z', map.data[25]);
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_advise(&map, FILEMAP_ADVICE_SEQUENTIAL));
+    fscl_filemap_close(&map);
+    remove(filemap_path);
+}
+
+XTEST_CASE(test_fscl_filemap_window) {
+    filemap_write_fixture(3 * 65536 + 10);
+
+    cfilemap map;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_ONLY, 65536));
+    TEST_ASSERT_EQUAL_INT(65536, map.length);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_window(&map, 3 * 65536, 0));
+    TEST_ASSERT_EQUAL_INT(10, map.length);
+    TEST_ASSERT_EQUAL_INT('a' + (3 * 65536) % 26, map.data[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_window(&map, 100001, 7));
+    TEST_ASSERT_EQUAL_INT(7, map.length);
+    TEST_ASSERT_EQUAL_INT('a' + 100001 % 26, map.data[0]);
+    fscl_filemap_close(&map);
+    remove(filemap_path);
+}
+
+XTEST_CASE(test_fscl_filemap_read_write) {
+    filemap_write_fixture(26);
+
+    cfilemap map;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_WRITE, 0));
+    map.data[0] = 'Z';
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_sync(&map));
+    fscl_filemap_close(&map);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_PRIVATE, 0));
+    TEST_ASSERT_EQUAL_INT('Z', map.data[0]);
+    map.data[1] = 'Y';
+    fscl_filemap_close(&map);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_ONLY, 0));
+    TEST_ASSERT_EQUAL_INT('b', map.data[1]);
+    fscl_filemap_close(&map);
+    remove(filemap_path);
+}
+
+XTEST_CASE(test_fscl_filemap_empty_file) {
+    filemap_write_fixture(0);
+
+    cfilemap map;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_ONLY, 0));
+    TEST_ASSERT_EQUAL_INT(0, map.length);
+    fscl_filemap_close(&map);
+    remove(filemap_path);
+
+    TEST_ASSERT_EQUAL_INT(-1, fscl_filemap_open(&map, filemap_path, FILEMAP_READ_ONLY, 0));
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_filemap_group) {
+    XTEST_RUN_UNIT(test_fscl_filemap_open_read_only);
+    XTEST_RUN_UNIT(test_fscl_filemap_window);
+    XTEST_RUN_UNIT(test_fscl_filemap_read_write);
+    XTEST_RUN_UNIT(test_fscl_filemap_empty_file);
+} // end of func
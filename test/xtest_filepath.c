@@ -0,0 +1,129 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/filepath.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <fcntl.h>
+#include <string.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//
+// XUNIT TEST DATA
+//
+static const char* filepath_normalized(cfilepath* path, const char* text) {
+    fscl_filepath_set(path, text);
+    fscl_filepath_normalize(path);
+    return fscl_filepath_cstr(path);
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_filepath_edit) {
+    cfilepath path;
+    fscl_filepath_init(&path);
+    TEST_ASSERT_EQUAL_STRING("", fscl_filepath_cstr(&path));
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_set(&path, "usr"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_join(&path, "lib"));
+    size_t saved = path.length;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_join(&path, "libc.so"));
+    TEST_ASSERT_EQUAL_STRING("usr/lib/libc.so", fscl_filepath_cstr(&path));
+    fscl_filepath_truncate(&path, saved);
+    TEST_ASSERT_EQUAL_STRING("usr/lib", fscl_filepath_cstr(&path));
+
+    fscl_filepath_dirname(&path);
+    TEST_ASSERT_EQUAL_STRING("usr", fscl_filepath_cstr(&path));
+    fscl_filepath_dirname(&path);
+    TEST_ASSERT_EQUAL_STRING(".", fscl_filepath_cstr(&path));
+
+    fscl_filepath_set(&path, "/var/log/");
+    fscl_filepath_basename(&path);
+    TEST_ASSERT_EQUAL_STRING("log", fscl_filepath_cstr(&path));
+    fscl_filepath_set(&path, "/var");
+    fscl_filepath_dirname(&path);
+    TEST_ASSERT_EQUAL_STRING("/", fscl_filepath_cstr(&path));
+
+    TEST_ASSERT_EQUAL_STRING("a/c", filepath_normalized(&path, "a//b/../c/."));
+    TEST_ASSERT_EQUAL_STRING("../x", filepath_normalized(&path, "a/../../x"));
+    TEST_ASSERT_EQUAL_STRING("/x", filepath_normalized(&path, "/../x/"));
+    TEST_ASSERT_EQUAL_STRING(".", filepath_normalized(&path, "a/.."));
+    fscl_filepath_erase(&path);
+}
+
+XTEST_CASE(test_fscl_filepath_long) {
+    // Paths past the inline buffer move to the heap without truncation
+    cfilepath path;
+    fscl_filepath_init(&path);
+    fscl_filepath_set(&path, "root");
+    for (int i = 0; i < 100; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, fscl_filepath_join(&path, "component"));
+    }
+    TEST_ASSERT_EQUAL_INT(4 + 100 * 10, (int)path.length);
+    TEST_ASSERT_EQUAL_INT(4 + 100 * 10, (int)strlen(fscl_filepath_cstr(&path)));
+    TEST_ASSERT_NOT_CNULLPTR(path.heap);
+    fscl_filepath_basename(&path);
+    TEST_ASSERT_EQUAL_STRING("component", fscl_filepath_cstr(&path));
+    fscl_filepath_erase(&path);
+}
+
+XTEST_CASE(test_fscl_filepath_relative_ops) {
+    cfilesystem dir = fscl_filesys_create("xtest_filepath");
+    fscl_filesys_remove_all(&dir, 0);
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_mkdirat(FSCL_FILEPATH_CWD, "xtest_filepath"));
+#ifndef _WIN32
+    int dirfd = fscl_filepath_open_dir(FSCL_FILEPATH_CWD, "xtest_filepath");
+    TEST_ASSERT_TRUE(dirfd >= 0);
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_mkdirat(dirfd, "sub"));
+    TEST_ASSERT_EQUAL_INT(2, fscl_filepath_existsat(dirfd, "sub"));
+
+    int fd = fscl_filepath_openat(dirfd, "sub/file.txt", O_WRONLY | O_CREAT, 0644);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    TEST_ASSERT_EQUAL_INT(1, fscl_filepath_existsat(dirfd, "sub/file.txt"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_unlinkat(dirfd, "sub/file.txt", 0));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_existsat(dirfd, "sub/file.txt"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filepath_unlinkat(dirfd, "sub", 1));
+    fscl_filepath_close_dir(dirfd);
+#endif
+
+    // Names longer than the old fixed buffers are no longer cut short
+    char name[300];
+    memset(name, 'n', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    name[200] = '\0';
+    fscl_filesys_create_subdirectory(&dir, name);
+    cfilepath path;
+    fscl_filepath_init(&path);
+    fscl_filepath_set(&path, "xtest_filepath");
+    fscl_filepath_join(&path, name);
+    TEST_ASSERT_EQUAL_INT(2, fscl_filepath_existsat(FSCL_FILEPATH_CWD, fscl_filepath_cstr(&path)));
+    fscl_filepath_erase(&path);
+
+    fscl_filesys_remove_all(&dir, 0);
+    fscl_filesys_erase(&dir);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_filepath_group) {
+    XTEST_RUN_UNIT(test_fscl_filepath_edit);
+    XTEST_RUN_UNIT(test_fscl_filepath_long);
+    XTEST_RUN_UNIT(test_fscl_filepath_relative_ops);
+} // end of func
@@ -0,0 +1,35 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#ifndef FSCL_XTEST_FILES_H
+#define FSCL_XTEST_FILES_H
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <stdio.h>
+
+//
+// XUNIT TEST HELPERS
+//
+
+// Replace the contents of a file, failing the test when it cannot be opened
+static inline void xtest_write_file(const char* path, const char* text) {
+    FILE* file = fopen(path, "wb");
+    TEST_ASSERT_NOT_CNULLPTR(file);
+    if (file) {
+        fputs(text, file);
+        fclose(file);
+    }
+}
+
+#endif
@@ -15,6 +15,8 @@ Description:
 #include <fossil/xtest.h>   // basic test tools
 #include <fossil/xassert.h> // extra asserts
 
+#include <stdio.h>
+
 //
 // XUNIT TEST CASES
 //
@@ -27,6 +29,17 @@ XTEST_CASE(test_fscl_filesys_create) {
     fscl_filesys_erase(&dir);
 }
 
+XTEST_CASE(test_fscl_filesys_change_directory) {
+    cfilesystem dir = fscl_filesys_create("a");
+    fscl_filesys_change_directory(&dir, "a/much/longer/path/than/before");
+    TEST_ASSERT_EQUAL_STRING("a/much/longer/path/than/before", dir.path);
+    fscl_filesys_change_directory(&dir, dir.path + 7); // a suffix of itself
+    TEST_ASSERT_EQUAL_STRING("longer/path/than/before", dir.path);
+    fscl_filesys_change_directory(&dir, "b");
+    TEST_ASSERT_EQUAL_STRING("b", dir.path);
+    fscl_filesys_erase(&dir);
+}
+
 XTEST_CASE(test_fscl_filesys_list_files) {
     cfilesystem dir = fscl_filesys_create("path\\to\\directory");
     // You may want to redirect stdout to capture the printed output for testing
@@ -46,11 +59,81 @@ XTEST_CASE(test_fscl_filesys_create_subdirectory) {
     fscl_filesys_erase(&subDirectory);
 }
 
+XTEST_CASE(test_fscl_filesys_create_directories) {
+    cfilesystem nested = fscl_filesys_create("xtest_tree/a/b/c");
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_create_directories(&nested));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&nested));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_create_directories(&nested));
+
+    cfilesystem sibling = fscl_filesys_create("xtest_tree/a/d/");
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_create_directories(&sibling));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&sibling));
+
+    cfilesystem root = fscl_filesys_create("xtest_tree");
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_remove_all(&root, 0));
+    fscl_filesys_erase(&nested);
+    fscl_filesys_erase(&sibling);
+    fscl_filesys_erase(&root);
+}
+
+XTEST_CASE(test_fscl_filesys_remove_all) {
+    char path[64];
+    for (int i = 0; i < 8; ++i) {
+        snprintf(path, sizeof(path), "xtest_tree/d%d/e", i);
+        cfilesystem dir = fscl_filesys_create(path);
+        fscl_filesys_create_directories(&dir);
+        fscl_filesys_erase(&dir);
+        for (int j = 0; j < 16; ++j) {
+            snprintf(path, sizeof(path), "xtest_tree/d%d/e/f%d", i, j);
+            FILE* file = fopen(path, "w");
+            fclose(file);
+        }
+    }
+
+    cfilesystem root = fscl_filesys_create("xtest_tree");
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&root));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_remove_all(&root, 4));
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&root));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_remove_all(&root, 4));
+    fscl_filesys_erase(&root);
+}
+
+XTEST_CASE(test_fscl_filesys_copy_and_move) {
+    FILE* file = fopen("xtest_copy.src", "wb");
+    fputs("fossil logic", file);
+    fclose(file);
+
+    cfilesystem source = fscl_filesys_create("xtest_copy.src");
+    cfilesystem copy = fscl_filesys_create("xtest_copy.dst");
+    cfilesystem moved = fscl_filesys_create("xtest_copy.moved");
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_copy_file(&source, &copy));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_filesys_copy_file(&source, &source));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_move_file(&copy, &moved));
+
+    char buffer[32] = {0};
+    file = fopen("xtest_copy.moved", "rb");
+    TEST_ASSERT_NOT_CNULLPTR(file);
+    fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    TEST_ASSERT_EQUAL_STRING("fossil logic", buffer);
+    TEST_ASSERT_CNULLPTR(fopen("xtest_copy.dst", "rb"));
+
+    remove("xtest_copy.src");
+    remove("xtest_copy.moved");
+    fscl_filesys_erase(&source);
+    fscl_filesys_erase(&copy);
+    fscl_filesys_erase(&moved);
+}
+
 //
 // XUNIT-TEST RUNNER
 //
 XTEST_DEFINE_POOL(test_fscl_filesys_group) {
     XTEST_RUN_UNIT(test_fscl_filesys_create);
+    XTEST_RUN_UNIT(test_fscl_filesys_change_directory);
     XTEST_RUN_UNIT(test_fscl_filesys_list_files);
     XTEST_RUN_UNIT(test_fscl_filesys_create_subdirectory);
+    XTEST_RUN_UNIT(test_fscl_filesys_create_directories);
+    XTEST_RUN_UNIT(test_fscl_filesys_remove_all);
+    XTEST_RUN_UNIT(test_fscl_filesys_copy_and_move);
 } // end of function main
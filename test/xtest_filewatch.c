@@ -0,0 +1,164 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/filewatch.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include "xtest_files.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//
+// XUNIT TEST DATA
+//
+typedef struct {
+    int batches;
+    int created;
+    int modified;
+    int deleted;
+    int nested;
+} filewatch_tally;
+
+static void filewatch_count(const cfilewatch_event* events, size_t count, void* user) {
+    filewatch_tally* tally = (filewatch_tally*)user;
+    tally->batches++;
+    for (size_t i = 0; i < count; ++i) {
+        if (events[i].events & FILEWATCH_CREATED) {
+            tally->created++;
+        }
+        if (events[i].events & FILEWATCH_MODIFIED) {
+            tally->modified++;
+        }
+        if (events[i].events & FILEWATCH_DELETED) {
+            tally->deleted++;
+        }
+        if (strcmp(events[i].path, "xtest_filewatch/sub/new.txt") == 0) {
+            tally->nested++;
+        }
+    }
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_filewatch_invalid) {
+    TEST_ASSERT_CNULLPTR(fscl_filewatch_create(NULL, 0, 0));
+    TEST_ASSERT_CNULLPTR(fscl_filewatch_create("xtest_filewatch_missing", 0, 0));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_filewatch_fd(NULL));
+    TEST_ASSERT_EQUAL_INT(-1, fscl_filewatch_poll(NULL, 0, NULL, NULL));
+}
+
+#ifdef __linux__
+XTEST_CASE(test_fscl_filewatch_coalesce) {
+    cfilesystem dir = fscl_filesys_create("xtest_filewatch");
+    fscl_filesys_create_directories(&dir);
+
+    cfilewatch* watch = fscl_filewatch_create("xtest_filewatch", 0, 20);
+    TEST_ASSERT_NOT_CNULLPTR(watch);
+    TEST_ASSERT_TRUE(fscl_filewatch_fd(watch) >= 0);
+
+    // Repeated writes to one file arrive as a single entry
+    xtest_write_file("xtest_filewatch/a.txt", "one");
+    xtest_write_file("xtest_filewatch/a.txt", "two");
+    xtest_write_file("xtest_filewatch/a.txt", "three");
+    filewatch_tally tally = {0};
+    TEST_ASSERT_EQUAL_INT(1, fscl_filewatch_poll(watch, 1000, filewatch_count, &tally));
+    TEST_ASSERT_EQUAL_INT(1, tally.batches);
+    TEST_ASSERT_EQUAL_INT(1, tally.created);
+    TEST_ASSERT_EQUAL_INT(1, tally.modified);
+
+    // A file created and removed within one tick is not reported
+    xtest_write_file("xtest_filewatch/tmp.txt", "gone");
+    remove("xtest_filewatch/tmp.txt");
+    remove("xtest_filewatch/a.txt");
+    memset(&tally, 0, sizeof(tally));
+    TEST_ASSERT_EQUAL_INT(1, fscl_filewatch_poll(watch, 1000, filewatch_count, &tally));
+    TEST_ASSERT_EQUAL_INT(1, tally.deleted);
+    TEST_ASSERT_EQUAL_INT(0, tally.created);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewatch_poll(watch, 0, filewatch_count, &tally));
+    fscl_filewatch_erase(watch);
+    fscl_filesys_remove_all(&dir, 0);
+    fscl_filesys_erase(&dir);
+}
+
+XTEST_CASE(test_fscl_filewatch_recursive) {
+    cfilesystem dir = fscl_filesys_create("xtest_filewatch");
+    fscl_filesys_create_directories(&dir);
+
+    cfilewatch* watch = fscl_filewatch_create("xtest_filewatch", 1, 20);
+    TEST_ASSERT_NOT_CNULLPTR(watch);
+
+    cfilesystem sub = fscl_filesys_create("xtest_filewatch/sub");
+    fscl_filesys_create_directories(&sub);
+    filewatch_tally tally = {0};
+    TEST_ASSERT_TRUE(fscl_filewatch_poll(watch, 1000, filewatch_count, &tally) >= 1);
+
+    // The new directory is watched without restarting the watcher
+    xtest_write_file("xtest_filewatch/sub/new.txt", "nested");
+    memset(&tally, 0, sizeof(tally));
+    TEST_ASSERT_TRUE(fscl_filewatch_poll(watch, 1000, filewatch_count, &tally) >= 1);
+    TEST_ASSERT_EQUAL_INT(1, tally.nested);
+
+    fscl_filewatch_erase(watch);
+    fscl_filesys_remove_all(&dir, 0);
+    fscl_filesys_erase(&sub);
+    fscl_filesys_erase(&dir);
+}
+
+XTEST_CASE(test_fscl_filewatch_moves) {
+    cfilesystem dir = fscl_filesys_create("xtest_filewatch");
+    cfilesystem out = fscl_filesys_create("xtest_filewatch_out");
+    cfilesystem sub = fscl_filesys_create("xtest_filewatch/sub");
+    fscl_filesys_create_directories(&sub);
+
+    cfilewatch* watch = fscl_filewatch_create("xtest_filewatch", 1, 20);
+    TEST_ASSERT_NOT_CNULLPTR(watch);
+    filewatch_tally tally = {0};
+
+    // Renamed inside the tree, the directory keeps reporting under its new name
+    TEST_ASSERT_EQUAL_INT(0, rename("xtest_filewatch/sub", "xtest_filewatch/moved"));
+    TEST_ASSERT_TRUE(fscl_filewatch_poll(watch, 1000, filewatch_count, &tally) >= 1);
+    xtest_write_file("xtest_filewatch/moved/new.txt", "renamed");
+    memset(&tally, 0, sizeof(tally));
+    TEST_ASSERT_TRUE(fscl_filewatch_poll(watch, 1000, filewatch_count, &tally) >= 1);
+    TEST_ASSERT_EQUAL_INT(1, tally.created);
+
+    // Moved out of the tree, it is no longer watched at all
+    TEST_ASSERT_EQUAL_INT(0, rename("xtest_filewatch/moved", "xtest_filewatch_out"));
+    TEST_ASSERT_TRUE(fscl_filewatch_poll(watch, 1000, filewatch_count, &tally) >= 1);
+    xtest_write_file("xtest_filewatch_out/outside.txt", "gone");
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewatch_poll(watch, 100, filewatch_count, &tally));
+
+    fscl_filewatch_erase(watch);
+    fscl_filesys_remove_all(&out, 0);
+    fscl_filesys_remove_all(&dir, 0);
+    fscl_filesys_erase(&sub);
+    fscl_filesys_erase(&out);
+    fscl_filesys_erase(&dir);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_filewatch_group) {
+    XTEST_RUN_UNIT(test_fscl_filewatch_invalid);
+#ifdef __linux__
+    XTEST_RUN_UNIT(test_fscl_filewatch_coalesce);
+    XTEST_RUN_UNIT(test_fscl_filewatch_recursive);
+    XTEST_RUN_UNIT(test_fscl_filewatch_moves);
+#endif
+} // end of func
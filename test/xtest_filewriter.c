@@ -0,0 +1,123 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/filewriter.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include "xtest_files.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+// XUNIT TEST DATA
+//
+static long filewriter_read(const char* path, char* buffer, size_t capacity) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    size_t length = fread(buffer, 1, capacity, file);
+    fclose(file);
+    return (long)length;
+}
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_filewriter_commit) {
+    xtest_write_file("xtest_filewriter.txt", "old state");
+
+    cfilewriter writer;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_open(&writer, "xtest_filewriter.txt", FILEWRITER_BUFFERED, 0));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_write(&writer, "new ", 4));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_write(&writer, "state", 5));
+
+    // Nothing is visible before the commit
+    char buffer[64];
+    TEST_ASSERT_EQUAL_INT(9, filewriter_read("xtest_filewriter.txt", buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(memcmp(buffer, "old state", 9) == 0);
+
+    char temp[256];
+    strcpy(temp, writer.temp_path);
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_commit(&writer));
+    TEST_ASSERT_EQUAL_INT(9, filewriter_read("xtest_filewriter.txt", buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(memcmp(buffer, "new state", 9) == 0);
+    TEST_ASSERT_EQUAL_INT(-1, filewriter_read(temp, buffer, sizeof(buffer)));
+
+    // An aborted writer leaves the destination alone
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_open(&writer, "xtest_filewriter.txt", FILEWRITER_BUFFERED, 0));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_write(&writer, "discarded", 9));
+    strcpy(temp, writer.temp_path);
+    fscl_filewriter_abort(&writer);
+    TEST_ASSERT_EQUAL_INT(9, filewriter_read("xtest_filewriter.txt", buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(memcmp(buffer, "new state", 9) == 0);
+    TEST_ASSERT_EQUAL_INT(-1, filewriter_read(temp, buffer, sizeof(buffer)));
+    remove("xtest_filewriter.txt");
+}
+
+XTEST_CASE(test_fscl_filewriter_direct_preallocate) {
+    // An odd size exercises the unaligned tail and the trimmed preallocation
+    size_t size = 3 * 1024 * 1024 + 123;
+    char* data = (char*)malloc(size);
+    char* back = (char*)malloc(size + 1);
+    TEST_ASSERT_NOT_CNULLPTR(data);
+    TEST_ASSERT_NOT_CNULLPTR(back);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = (char)(i * 31 + 7);
+    }
+
+    cfilewriter writer;
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_open(&writer, "xtest_filewriter.bin",
+                                                  FILEWRITER_DIRECT | FILEWRITER_PREALLOCATE, size + 4096));
+    for (size_t done = 0; done < size; done += 1000) {
+        size_t chunk = size - done < 1000 ? size - done : 1000;
+        TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_write(&writer, data + done, chunk));
+    }
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_commit(&writer));
+    TEST_ASSERT_EQUAL_INT((long)size, filewriter_read("xtest_filewriter.bin", back, size + 1));
+    TEST_ASSERT_TRUE(memcmp(data, back, size) == 0);
+
+    remove("xtest_filewriter.bin");
+    free(data);
+    free(back);
+}
+
+XTEST_CASE(test_fscl_filewriter_commit_all) {
+    cfilewriter writers[8];
+    char path[64];
+    for (int i = 0; i < 8; ++i) {
+        snprintf(path, sizeof(path), "xtest_filewriter_%d.txt", i);
+        TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_open(&writers[i], path, FILEWRITER_BUFFERED, 16));
+        TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_write(&writers[i], path, strlen(path)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, fscl_filewriter_commit_all(writers, 8));
+
+    char buffer[64];
+    for (int i = 0; i < 8; ++i) {
+        snprintf(path, sizeof(path), "xtest_filewriter_%d.txt", i);
+        TEST_ASSERT_EQUAL_INT((long)strlen(path), filewriter_read(path, buffer, sizeof(buffer)));
+        TEST_ASSERT_TRUE(memcmp(buffer, path, strlen(path)) == 0);
+        remove(path);
+    }
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_filewriter_group) {
+    XTEST_RUN_UNIT(test_fscl_filewriter_commit);
+    XTEST_RUN_UNIT(test_fscl_filewriter_direct_preallocate);
+    XTEST_RUN_UNIT(test_fscl_filewriter_commit_all);
+} // end of func
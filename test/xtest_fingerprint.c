@@ -0,0 +1,128 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/fingerprint.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include "xtest_files.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_fingerprint_hash64) {
+    // Reference values of XXH64 with seed 0
+    TEST_ASSERT_TRUE(fscl_fingerprint_hash64("", 0, 0) == 0xEF46DB3751D8E999ULL);
+    TEST_ASSERT_TRUE(fscl_fingerprint_hash64("abc", 3, 0) == 0x44BC2CF5AD770999ULL);
+
+    const char* text = "the quick brown fox jumps over the lazy dog, twice over";
+    cfingerprint_hasher hasher;
+    fscl_fingerprint_hash_init(&hasher, 7);
+    fscl_fingerprint_hash_update(&hasher, text, 10);
+    fscl_fingerprint_hash_update(&hasher, text + 10, strlen(text) - 10);
+    TEST_ASSERT_TRUE(fscl_fingerprint_hash_digest(&hasher) == fscl_fingerprint_hash64(text, strlen(text), 7));
+}
+
+XTEST_CASE(test_fscl_fingerprint_incremental) {
+    cfilesystem tree = fscl_filesys_create("xtest_fingerprint/sub");
+    fscl_filesys_create_directories(&tree);
+    xtest_write_file("xtest_fingerprint/a.txt", "alpha");
+    xtest_write_file("xtest_fingerprint/sub/b.txt", "beta");
+    xtest_write_file("xtest_fingerprint/sub/c.txt", "gamma");
+
+    cfingerprint_manifest first;
+    cfingerprint_diff diff;
+    TEST_ASSERT_EQUAL_INT(0, fscl_fingerprint_scan("xtest_fingerprint", NULL, &first, &diff, 2));
+    TEST_ASSERT_EQUAL_INT(3, first.count);
+    TEST_ASSERT_EQUAL_INT(3, diff.added_count);
+    TEST_ASSERT_EQUAL_INT(3, diff.hashed);
+    fscl_fingerprint_diff_erase(&diff);
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_fingerprint_save(&first, "xtest_fingerprint.manifest"));
+    cfingerprint_manifest loaded;
+    TEST_ASSERT_EQUAL_INT(0, fscl_fingerprint_load(&loaded, "xtest_fingerprint.manifest"));
+    TEST_ASSERT_TRUE(fscl_fingerprint_tree_hash(&loaded) == fscl_fingerprint_tree_hash(&first));
+
+    xtest_write_file("xtest_fingerprint/sub/b.txt", "beta, changed");
+    remove("xtest_fingerprint/sub/c.txt");
+    xtest_write_file("xtest_fingerprint/d.txt", "delta");
+
+    cfingerprint_manifest second;
+    TEST_ASSERT_EQUAL_INT(0, fscl_fingerprint_scan("xtest_fingerprint", &loaded, &second, &diff, 2));
+    TEST_ASSERT_EQUAL_INT(1, diff.reused);
+    TEST_ASSERT_EQUAL_INT(2, diff.hashed);
+    TEST_ASSERT_EQUAL_INT(1, diff.added_count);
+    TEST_ASSERT_EQUAL_STRING("d.txt", diff.added[0]);
+    TEST_ASSERT_EQUAL_INT(1, diff.removed_count);
+    TEST_ASSERT_EQUAL_STRING("sub/c.txt", diff.removed[0]);
+    TEST_ASSERT_EQUAL_INT(1, diff.modified_count);
+    TEST_ASSERT_EQUAL_STRING("sub/b.txt", diff.modified[0]);
+    TEST_ASSERT_TRUE(fscl_fingerprint_tree_hash(&second) != fscl_fingerprint_tree_hash(&first));
+
+    fscl_fingerprint_diff_erase(&diff);
+    fscl_fingerprint_manifest_erase(&first);
+    fscl_fingerprint_manifest_erase(&loaded);
+    fscl_fingerprint_manifest_erase(&second);
+    remove("xtest_fingerprint.manifest");
+
+    cfilesystem root = fscl_filesys_create("xtest_fingerprint");
+    fscl_filesys_remove_all(&root, 0);
+    fscl_filesys_erase(&root);
+    fscl_filesys_erase(&tree);
+}
+
+#ifndef _WIN32
+XTEST_CASE(test_fscl_fingerprint_unreadable) {
+    cfilesystem tree = fscl_filesys_create("xtest_fingerprint_locked/sub");
+    fscl_filesys_create_directories(&tree);
+    xtest_write_file("xtest_fingerprint_locked/sub/a.txt", "alpha");
+    chmod("xtest_fingerprint_locked/sub", 0);
+
+    // An unreadable subtree fails the scan instead of looking removed;
+    // root can open it anyway, so there the scan simply succeeds
+    cfingerprint_manifest manifest;
+    int result = fscl_fingerprint_scan("xtest_fingerprint_locked", NULL, &manifest, NULL, 1);
+    if (geteuid() != 0) {
+        TEST_ASSERT_EQUAL_INT(-1, result);
+        TEST_ASSERT_EQUAL_INT(EACCES, errno);
+    } else {
+        TEST_ASSERT_EQUAL_INT(0, result);
+        fscl_fingerprint_manifest_erase(&manifest);
+    }
+
+    chmod("xtest_fingerprint_locked/sub", 0755);
+    cfilesystem root = fscl_filesys_create("xtest_fingerprint_locked");
+    fscl_filesys_remove_all(&root, 0);
+    fscl_filesys_erase(&root);
+    fscl_filesys_erase(&tree);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_fingerprint_group) {
+    XTEST_RUN_UNIT(test_fscl_fingerprint_hash64);
+    XTEST_RUN_UNIT(test_fscl_fingerprint_incremental);
+#ifndef _WIN32
+    XTEST_RUN_UNIT(test_fscl_fingerprint_unreadable);
+#endif
+} // end of func
@@ -0,0 +1,138 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/lavaentropy.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lavaentropy_keeps_seeded_sequence) {
+    // Runs first so the pool is set up here; neither that nor a reseed
+    // may draw from the thread generator
+    int expected[4];
+    fscl_lava_seed(42);
+    for (int i = 0; i < 4; ++i) {
+        expected[i] = fscl_lava_random();
+    }
+
+    unsigned char bytes[16];
+    fscl_lava_seed(42);
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(bytes, sizeof(bytes)));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_reseed());
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_INT(expected[i], fscl_lava_random());
+    }
+}
+
+XTEST_CASE(test_lavaentropy_chacha20) {
+    // RFC 8439 section 2.3.2
+    static const unsigned char expected[LAVAENTROPY_BLOCK_SIZE] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+    };
+    static const unsigned char nonce[LAVAENTROPY_NONCE_SIZE] = {
+        0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00
+    };
+    unsigned char key[LAVAENTROPY_KEY_SIZE];
+    unsigned char block[LAVAENTROPY_BLOCK_SIZE];
+    for (int i = 0; i < LAVAENTROPY_KEY_SIZE; ++i) {
+        key[i] = (unsigned char)i;
+    }
+    fscl_lavaentropy_chacha20(key, 1, nonce, block);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(block, expected, sizeof(expected)));
+}
+
+XTEST_CASE(test_lavaentropy_bytes) {
+    unsigned char first[32];
+    unsigned char second[32];
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(first, sizeof(first)));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(second, sizeof(second)));
+    TEST_ASSERT_TRUE(memcmp(first, second, sizeof(first)) != 0);
+
+    // Mixing and reseeding keep the stream going
+    clavalamp lamps[4] = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}, {7.0, 8.0}};
+    fscl_lavaentropy_mix_lamps(lamps, 4);
+    fscl_lavaentropy_mix("token", 5);
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_reseed());
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(first, sizeof(first)));
+    TEST_ASSERT_TRUE(memcmp(first, second, sizeof(first)) != 0);
+
+    // Bulk output past the buffer and reseed sizes, with every byte value seen
+    static unsigned char bulk[600 * 1024 + 13];
+    size_t counts[256] = {0};
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(bulk, 7));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(bulk + 7, sizeof(bulk) - 7));
+    for (size_t i = 0; i < sizeof(bulk); ++i) {
+        counts[bulk[i]]++;
+    }
+    for (int i = 0; i < 256; ++i) {
+        TEST_ASSERT_TRUE(counts[i] > sizeof(bulk) / 256 / 2);
+    }
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_u64(&a));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_u64(&b));
+    TEST_ASSERT_TRUE(a != b);
+    TEST_ASSERT_EQUAL_INT(-1, fscl_lavaentropy_u64(NULL));
+}
+
+XTEST_CASE(test_lavaentropy_fork) {
+#ifndef _WIN32
+    // Parent and child must not continue the same buffered stream
+    unsigned char warm[8];
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(warm, sizeof(warm)));
+
+    int pipefd[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(pipefd));
+    pid_t child = fork();
+    TEST_ASSERT_TRUE(child >= 0);
+    if (child == 0) {
+        unsigned char bytes[32];
+        close(pipefd[0]);
+        int ok = fscl_lavaentropy_bytes(bytes, sizeof(bytes)) == 0 &&
+                 write(pipefd[1], bytes, sizeof(bytes)) == (ssize_t)sizeof(bytes);
+        _exit(ok ? 0 : 1);
+    }
+    close(pipefd[1]);
+    unsigned char parent[32];
+    unsigned char other[32];
+    TEST_ASSERT_EQUAL_INT(0, fscl_lavaentropy_bytes(parent, sizeof(parent)));
+    TEST_ASSERT_EQUAL_INT((int)sizeof(other), (int)read(pipefd[0], other, sizeof(other)));
+    close(pipefd[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    TEST_ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    TEST_ASSERT_TRUE(memcmp(parent, other, sizeof(parent)) != 0);
+#endif
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lavaentropy_group) {
+    XTEST_RUN_UNIT(test_lavaentropy_keeps_seeded_sequence);
+    XTEST_RUN_UNIT(test_lavaentropy_chacha20);
+    XTEST_RUN_UNIT(test_lavaentropy_bytes);
+    XTEST_RUN_UNIT(test_lavaentropy_fork);
+} // end of func
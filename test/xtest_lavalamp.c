@@ -15,6 +15,10 @@ Description:
 #include <fossil/xtest.h>   // basic test tools
 #include <fossil/xassert.h> // extra asserts
 
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
 //
 // XUNIT TEST CASES
 //
@@ -31,10 +35,154 @@ XTEST_CASE(testLavaRandom) {
     TEST_ASSERT_NOT_EQUAL_UINT(fscl_lava_random(), fscl_lava_random());
 }
 
+XTEST_CASE(testLavaField) {
+    clavafield field;
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_create(&field, 1003));
+    TEST_ASSERT_TRUE(((size_t)field.position % 64) == 0 && ((size_t)field.velocity % 64) == 0);
+    TEST_ASSERT_TRUE(field.position[1002] == 0.0 && field.velocity[1002] == 0.0);
+
+    // Noise stays within half a unit of where each lamp was
+    clavarng_lanes lanes;
+    fscl_lavarng_lanes_seed(&lanes, 3);
+    fscl_lava_field_randomize(&field, &lanes);
+    fscl_lava_field_randomize(&field, NULL);
+    int bounded = 1;
+    for (size_t i = 0; i < field.count; ++i) {
+        bounded &= field.position[i] >= -1.0 && field.position[i] < 1.0 && field.velocity[i] != 0.0;
+    }
+    TEST_ASSERT_TRUE(bounded);
+
+    // Lamp i gets position i - 500 and velocity (i % 13) - 6
+    for (size_t i = 0; i < field.count; ++i) {
+        field.position[i] = (double)i - 500.0;
+        field.velocity[i] = (double)(i % 13) - 6.0;
+    }
+    fscl_lava_field_step(&field, 0.5);
+    clavafield_report expected = {0, 0, 0, 0, 0};
+    for (size_t i = 0; i < field.count; ++i) {
+        double v = fabs((double)(i % 13) - 6.0);
+        double p = fabs((double)i - 500.0 + 0.5 * ((double)(i % 13) - 6.0));
+        TEST_ASSERT_TRUE(fabs(field.position[i]) == p);
+        expected.extreme_position += p > 10.0;
+        expected.extreme_velocity += v > 5.0;
+        expected.stagnant += v < 0.1;
+        expected.erratic += v > 2.0 && p > 5.0;
+        expected.consistent += v > 0.1 && p < 5.0;
+    }
+    clavafield_report report;
+    fscl_lava_field_analyze(&field, &report);
+    TEST_ASSERT_TRUE(report.extreme_position == expected.extreme_position);
+    TEST_ASSERT_TRUE(report.extreme_velocity == expected.extreme_velocity);
+    TEST_ASSERT_TRUE(report.stagnant == expected.stagnant);
+    TEST_ASSERT_TRUE(report.erratic == expected.erratic);
+    TEST_ASSERT_TRUE(report.consistent == expected.consistent);
+    TEST_ASSERT_TRUE(report.consistent > 0 && report.erratic > 0);
+
+    clavalamp lamps[1003];
+    fscl_lava_field_store(&field, lamps);
+    fscl_lava_field_reset(&field);
+    TEST_ASSERT_TRUE(field.position[7] == 0.0);
+    fscl_lava_field_load(&field, lamps);
+    TEST_ASSERT_TRUE(field.velocity[7] == lamps[7].velocity && field.position[7] == lamps[7].position);
+    fscl_lava_field_erase(&field);
+}
+
+XTEST_CASE(testLavaFieldSimulate) {
+    clavafield serial;
+    clavafield parallel;
+    clavafield resumed;
+    size_t count = 5 * FSCL_LAVA_CHUNK + 77;
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_create(&serial, count));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_create(&parallel, count));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_create(&resumed, count));
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_simulate(&serial, 42, 0, 5, 0.1, 1));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_simulate(&parallel, 42, 0, 5, 0.1, 4));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_simulate(&resumed, 42, 0, 3, 0.1, 3));
+    TEST_ASSERT_EQUAL_INT(0, fscl_lava_field_simulate(&resumed, 42, 3, 2, 0.1, 0));
+
+    // Bit-identical whatever the thread count or the split into runs
+    TEST_ASSERT_EQUAL_INT(0, memcmp(serial.position, parallel.position, count * sizeof(double)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(serial.velocity, parallel.velocity, count * sizeof(double)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(serial.position, resumed.position, count * sizeof(double)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(serial.velocity, resumed.velocity, count * sizeof(double)));
+
+    // Chunks draw from different streams
+    TEST_ASSERT_TRUE(serial.velocity[0] != serial.velocity[FSCL_LAVA_CHUNK]);
+    TEST_ASSERT_TRUE(serial.velocity[count - 1] != 0.0);
+
+    fscl_lava_field_erase(&serial);
+    fscl_lava_field_erase(&parallel);
+    fscl_lava_field_erase(&resumed);
+}
+
+XTEST_CASE(testLavaHash) {
+    static const unsigned char abc[32] = {
+        0xbd, 0xdd, 0x81, 0x3c, 0x63, 0x42, 0x39, 0x72, 0x31, 0x71, 0xef, 0x3f, 0xee, 0x98, 0x57, 0x9b,
+        0x94, 0x96, 0x4e, 0x3b, 0xb1, 0xcb, 0x3e, 0x42, 0x72, 0x62, 0xc8, 0xc0, 0x68, 0xd5, 0x23, 0x19
+    };
+    static const unsigned char keyed[32] = {
+        0x84, 0x87, 0xd0, 0x57, 0xe2, 0xd8, 0xc6, 0x4f, 0xae, 0x46, 0x77, 0x61, 0x6f, 0x0e, 0xc8, 0xbf,
+        0xa2, 0x3c, 0xce, 0xdc, 0x7c, 0x7c, 0xf2, 0xfc, 0x91, 0x5b, 0xb2, 0xcc, 0x0e, 0x94, 0xb9, 0xf3
+    };
+    static const unsigned char counting[32] = {
+        0x82, 0x62, 0x8c, 0xbf, 0xc9, 0x68, 0x9e, 0x23, 0x4b, 0x09, 0x23, 0xa5, 0x31, 0xf4, 0x57, 0x8f,
+        0xe2, 0xe7, 0x13, 0x8a, 0x03, 0xe2, 0xf8, 0x1e, 0xd6, 0xcd, 0xe9, 0x75, 0x17, 0x33, 0x66, 0x50
+    };
+    unsigned char digest[FSCL_LAVA_HASH_SIZE];
+    clavahash hash;
+
+    // BLAKE2b-256 reference vectors
+    fscl_lava_hash_init(&hash, LAVA_HASH_STRONG, 0);
+    fscl_lava_hash_update(&hash, "abc", 3);
+    TEST_ASSERT_EQUAL_INT(32, (int)fscl_lava_hash_final(&hash, digest));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(digest, abc, sizeof(abc)));
+    fscl_lava_hash_init(&hash, LAVA_HASH_STRONG, 7);
+    fscl_lava_hash_update(&hash, "abc", 3);
+    fscl_lava_hash_final(&hash, digest);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(digest, keyed, sizeof(keyed)));
+
+    // Uneven pieces across block boundaries hash like one buffer
+    unsigned char bytes[1280];
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = (unsigned char)i;
+    }
+    fscl_lava_hash_init(&hash, LAVA_HASH_STRONG, 0);
+    fscl_lava_hash_update(&hash, bytes, 100);
+    fscl_lava_hash_update(&hash, bytes + 100, 28);
+    fscl_lava_hash_update(&hash, bytes + 128, 1000);
+    fscl_lava_hash_update(&hash, bytes + 1128, 152);
+    fscl_lava_hash_final(&hash, digest);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(digest, counting, sizeof(counting)));
+
+    // The fast hash is XXH64, little-endian
+    fscl_lava_hash_init(&hash, LAVA_HASH_FAST, 0);
+    fscl_lava_hash_update(&hash, "abc", 3);
+    TEST_ASSERT_EQUAL_INT(8, (int)fscl_lava_hash_final(&hash, digest));
+    TEST_ASSERT_EQUAL_INT(0x99, digest[0]);
+    TEST_ASSERT_EQUAL_INT(0x44, digest[7]);
+
+    // Hashing lamps in place matches hashing their combined copy
+    clavalamp* lamps = fscl_lava_create(100);
+    char* combined = (char*)malloc(100 * sizeof(clavalamp));
+    TEST_ASSERT_NOT_CNULLPTR(combined);
+    fscl_lava_combine_states(lamps, 100, combined);
+    TEST_ASSERT_TRUE(fscl_lava_hash_state(lamps, 100) == fscl_fingerprint_hash64(combined, 100 * sizeof(clavalamp), 0));
+    TEST_ASSERT_TRUE(fscl_lava_derive_seed(lamps, 100) == fscl_lava_derive_seed(lamps, 100));
+    uint64_t seed = fscl_lava_derive_seed(lamps, 100);
+    lamps[99].velocity += 1.0;
+    TEST_ASSERT_TRUE(fscl_lava_derive_seed(lamps, 100) != seed);
+    free(combined);
+    fscl_lava_erase(lamps);
+}
+
 //
 // XUNIT-TEST RUNNER
 //
 XTEST_DEFINE_POOL(test_random_group) {
     XTEST_RUN_UNIT(testLavaSeed);
     XTEST_RUN_UNIT(testLavaRandom);
+    XTEST_RUN_UNIT(testLavaField);
+    XTEST_RUN_UNIT(testLavaFieldSimulate);
+    XTEST_RUN_UNIT(testLavaHash);
 } // end of func
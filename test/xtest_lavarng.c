@@ -0,0 +1,178 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/lavarng.h" // lib source code
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_lavarng_reference) {
+    // Outputs of the reference implementations
+    clavarng rng = {LAVARNG_XOSHIRO256, {.xoshiro = {1, 2, 3, 4}}};
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0x2d00);
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0);
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0x5a007080);
+
+    rng.engine = LAVARNG_PCG64;
+    rng.s.pcg.state_hi = 0x0123456789abcdefull;
+    rng.s.pcg.state_lo = 0xfedcba9876543210ull;
+    rng.s.pcg.inc_hi = 0x5851F42D4C957F2Dull;
+    rng.s.pcg.inc_lo = 0x14057B7EF767814Full;
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0x13c49fecdee35f71ull);
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0x4ee9574cc31f57d2ull);
+    TEST_ASSERT_TRUE(fscl_lavarng_next(&rng) == 0x718b9867b2c7ef05ull);
+
+    // Known answer of Philox4x32-10 for a zero key and counter
+    uint64_t block[2];
+    fscl_lavarng_philox_block(0, 0, 0, block);
+    TEST_ASSERT_TRUE(block[0] == 0xe169c58d6627e8d5ull);
+    TEST_ASSERT_TRUE(block[1] == 0x9b00dbd8bc57ac4cull);
+}
+
+XTEST_CASE(test_lavarng_fill_and_advance) {
+    const clavarng_engine engines[] = {LAVARNG_XOSHIRO256, LAVARNG_PCG64, LAVARNG_PHILOX};
+    for (int e = 0; e < 3; ++e) {
+        clavarng bulk;
+        clavarng single;
+        fscl_lavarng_seed(&bulk, engines[e], 42);
+        fscl_lavarng_seed(&single, engines[e], 42);
+
+        // Bulk fills continue the sequence exactly, from any position
+        uint64_t values[101];
+        fscl_lavarng_next(&bulk);
+        fscl_lavarng_next(&single);
+        fscl_lavarng_fill_u64(&bulk, values, 101);
+        int same = 1;
+        for (int i = 0; i < 101; ++i) {
+            same &= values[i] == fscl_lavarng_next(&single);
+        }
+        TEST_ASSERT_TRUE(same);
+
+        double doubles[300];
+        fscl_lavarng_fill_double(&bulk, doubles, 300);
+        int in_range = 1;
+        for (int i = 0; i < 300; ++i) {
+            in_range &= doubles[i] >= 0.0 && doubles[i] < 1.0;
+        }
+        TEST_ASSERT_TRUE(in_range);
+
+        // Advancing matches stepping, where the engine supports it
+        clavarng skipped = single;
+        if (fscl_lavarng_advance(&skipped, 1001) == 0) {
+            for (int i = 0; i < 1001; ++i) {
+                fscl_lavarng_next(&single);
+            }
+            TEST_ASSERT_TRUE(fscl_lavarng_next(&skipped) == fscl_lavarng_next(&single));
+        } else {
+            TEST_ASSERT_EQUAL_INT(LAVARNG_XOSHIRO256, engines[e]);
+        }
+
+        // A jumped copy starts a different stream
+        clavarng jumped = single;
+        fscl_lavarng_jump(&jumped);
+        TEST_ASSERT_TRUE(fscl_lavarng_next(&jumped) != fscl_lavarng_next(&single));
+    }
+}
+
+XTEST_CASE(test_lavarng_thread) {
+    clavarng* rng = fscl_lavarng_thread();
+    TEST_ASSERT_TRUE(rng == fscl_lavarng_thread());
+    fscl_lavarng_seed(rng, LAVARNG_XOSHIRO256, 7);
+    uint64_t first = fscl_lavarng_next(rng);
+    fscl_lavarng_seed(rng, LAVARNG_XOSHIRO256, 7);
+    TEST_ASSERT_TRUE(first == fscl_lavarng_next(rng));
+}
+
+XTEST_CASE(test_lavarng_lanes) {
+    clavarng_lanes lanes;
+    fscl_lavarng_lanes_seed(&lanes, 99);
+    TEST_ASSERT_NOT_CNULLPTR(fscl_lavarng_lanes_isa());
+
+    // Lane k is the seeded stream jumped k times, outputs interleaved
+    uint64_t values[3 + LAVARNG_LANES * 20];
+    fscl_lavarng_lanes_fill_u64(&lanes, values, 3);
+    fscl_lavarng_lanes_fill_u64(&lanes, values + 3, LAVARNG_LANES * 20);
+    clavarng stream;
+    fscl_lavarng_seed(&stream, LAVARNG_XOSHIRO256, 99);
+    int same = 1;
+    for (int k = 0; k < LAVARNG_LANES; ++k) {
+        clavarng lane = stream;
+        for (int i = k; i < 3 + LAVARNG_LANES * 20; i += LAVARNG_LANES) {
+            same &= values[i] == fscl_lavarng_next(&lane);
+        }
+        fscl_lavarng_jump(&stream);
+    }
+    TEST_ASSERT_TRUE(same);
+}
+
+XTEST_CASE(test_lavarng_distributions) {
+    enum { COUNT = 100000 };
+    static double samples[COUNT];
+    static uint64_t integers[COUNT];
+    clavarng_lanes lanes;
+    fscl_lavarng_lanes_seed(&lanes, 2024);
+
+    fscl_lavarng_lanes_fill_bounded(&lanes, integers, COUNT, 6);
+    int counts[6] = {0, 0, 0, 0, 0, 0};
+    int in_range = 1;
+    for (int i = 0; i < COUNT; ++i) {
+        in_range &= integers[i] < 6;
+        counts[integers[i] % 6]++;
+    }
+    TEST_ASSERT_TRUE(in_range);
+    for (int v = 0; v < 6; ++v) {
+        TEST_ASSERT_TRUE(counts[v] > 16000 && counts[v] < 17400);
+    }
+
+    double sum = 0.0;
+    double squares = 0.0;
+    fscl_lavarng_lanes_fill_normal(&lanes, samples, COUNT, 10.0, 2.0);
+    for (int i = 0; i < COUNT; ++i) {
+        sum += samples[i];
+        squares += samples[i] * samples[i];
+    }
+    double mean = sum / COUNT;
+    double variance = squares / COUNT - mean * mean;
+    TEST_ASSERT_TRUE(mean > 9.97 && mean < 10.03);
+    TEST_ASSERT_TRUE(variance > 3.9 && variance < 4.1);
+
+    sum = 0.0;
+    int positive = 1;
+    fscl_lavarng_lanes_fill_exponential(&lanes, samples, COUNT, 4.0);
+    for (int i = 0; i < COUNT; ++i) {
+        positive &= samples[i] >= 0.0;
+        sum += samples[i];
+    }
+    TEST_ASSERT_TRUE(positive);
+    TEST_ASSERT_TRUE(sum / COUNT > 0.245 && sum / COUNT < 0.255);
+
+    clavarng rng;
+    fscl_lavarng_seed(&rng, LAVARNG_PCG64, 5);
+    TEST_ASSERT_TRUE(fscl_lavarng_bounded(&rng, 1) == 0);
+    TEST_ASSERT_TRUE(fscl_lavarng_exponential(&rng) >= 0.0);
+    double normal = fscl_lavarng_normal(&rng);
+    TEST_ASSERT_TRUE(normal > -10.0 && normal < 10.0);
+}
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_lavarng_group) {
+    XTEST_RUN_UNIT(test_lavarng_reference);
+    XTEST_RUN_UNIT(test_lavarng_fill_and_advance);
+    XTEST_RUN_UNIT(test_lavarng_thread);
+    XTEST_RUN_UNIT(test_lavarng_lanes);
+    XTEST_RUN_UNIT(test_lavarng_distributions);
+} // end of func
@@ -0,0 +1,180 @@
+/*
+==============================================================================
+Author: Michael Gene Brockus (Dreamer)
+Email: michaelbrockus@gmail.com
+Organization: Fossil Logic
+Description: 
+    This file is part of the Fossil Logic project, where innovation meets
+    excellence in software development. Michael Gene Brockus, also known as
+    "Dreamer," is a dedicated contributor to this project. For any inquiries,
+    feel free to contact Michael at michaelbrockus@gmail.com.
+==============================================================================
+*/
+#include "fossil/xutil/statcache.h" // lib source code
+#include "fossil/xutil/filesystem.h"
+#include "fossil/xutil/command.h"
+
+#include <fossil/xtest.h>   // basic test tools
+#include <fossil/xassert.h> // extra asserts
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+//
+// XUNIT TEST CASES
+//
+XTEST_CASE(test_fscl_statcache_counters) {
+    cstatcache* cache = fscl_statcache_create(0, 0.0, 0);
+    TEST_ASSERT_NOT_CNULLPTR(cache);
+
+    fscl_command("mkdir xtest_statcache_dir");
+    TEST_ASSERT_EQUAL_INT(1, fscl_statcache_is_directory(cache, "xtest_statcache_dir"));
+    TEST_ASSERT_EQUAL_INT(1, fscl_statcache_exists(cache, "xtest_statcache_dir/"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_statcache_exists(cache, "xtest_statcache_missing"));
+    TEST_ASSERT_EQUAL_INT(0, fscl_statcache_exists(cache, "xtest_statcache_missing"));
+
+    cstatcache_counters counters = fscl_statcache_counters(cache);
+    TEST_ASSERT_EQUAL_INT(2, counters.hits);
+    TEST_ASSERT_EQUAL_INT(2, counters.misses);
+
+    // Without watching, a removal is only seen after an explicit invalidation
+    fscl_command("rmdir xtest_statcache_dir");
+    TEST_ASSERT_EQUAL_INT(1, fscl_statcache_exists(cache, "xtest_statcache_dir"));
+    fscl_statcache_invalidate(cache, "xtest_statcache_dir");
+    TEST_ASSERT_EQUAL_INT(0, fscl_statcache_exists(cache, "xtest_statcache_dir"));
+    fscl_statcache_erase(cache);
+}
+
+XTEST_CASE(test_fscl_statcache_install) {
+    cstatcache* cache = fscl_statcache_create(16, 0.0, 0);
+    fscl_statcache_install(cache);
+
+    cfilesystem dir = fscl_filesys_create(".");
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&dir));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&dir));
+    TEST_ASSERT_EQUAL_INT(1, fscl_statcache_counters(cache).hits);
+    fscl_filesys_erase(&dir);
+
+    fscl_statcache_erase(cache);
+    TEST_ASSERT_CNULLPTR(fscl_statcache_installed());
+}
+
+XTEST_CASE(test_fscl_statcache_mutations) {
+    cstatcache* cache = fscl_statcache_create(0, 0.0, 0);
+    fscl_statcache_install(cache);
+
+    cfilesystem root = fscl_filesys_create("xtest_statcache_tree");
+    cfilesystem deep = fscl_filesys_create("xtest_statcache_tree/a/b");
+    cfilesystem moved = fscl_filesys_create("xtest_statcache_tree/c");
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&root));
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&deep));
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_create_directories(&deep));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&root));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&deep));
+
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&moved));
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_move_file(&deep, &moved));
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&deep));
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&moved));
+
+    cfilesystem sub = fscl_filesys_create("xtest_statcache_tree/d");
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&sub));
+    fscl_filesys_create_subdirectory(&root, "d");
+    TEST_ASSERT_TRUE(fscl_filesys_exists(&sub));
+
+    TEST_ASSERT_EQUAL_INT(0, fscl_filesys_remove_all(&root, 1));
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&root));
+    TEST_ASSERT_FALSE(fscl_filesys_exists(&moved));
+
+    fscl_filesys_erase(&sub);
+    fscl_filesys_erase(&moved);
+    fscl_filesys_erase(&deep);
+    fscl_filesys_erase(&root);
+    fscl_statcache_erase(cache);
+}
+
+#ifdef __linux__
+XTEST_CASE(test_fscl_statcache_watch) {
+    cstatcache* cache = fscl_statcache_create(0, 0.0, 1);
+    TEST_ASSERT_EQUAL_INT(0, fscl_statcache_exists(cache, "xtest_statcache_watched"));
+
+    fscl_command("mkdir xtest_statcache_watched");
+    int seen = 0;
+    time_t deadline = time(NULL) + 2;
+    while (!seen && time(NULL) <= deadline) {
+        seen = fscl_statcache_is_directory(cache, "xtest_statcache_watched");
+    }
+    TEST_ASSERT_TRUE(seen);
+    TEST_ASSERT_TRUE(fscl_statcache_counters(cache).invalidations > 0);
+
+    fscl_command("rmdir xtest_statcache_watched");
+    fscl_statcache_erase(cache);
+}
+
+XTEST_CASE(test_fscl_statcache_watch_missing_parent) {
+    // No watch can cover a path whose parent is missing, so it must not stick
+    cstatcache* cache = fscl_statcache_create(0, 0.0, 1);
+    TEST_ASSERT_EQUAL_INT(0, fscl_statcache_exists(cache, "xtest_statcache_deep/b/c"));
+
+    fscl_command("mkdir -p xtest_statcache_deep/b/c");
+    TEST_ASSERT_TRUE(fscl_statcache_is_directory(cache, "xtest_statcache_deep/b/c"));
+
+    fscl_command("rm -rf xtest_statcache_deep");
+    fscl_statcache_erase(cache);
+}
+
+// Watch descriptors open in this process, read from the inotify fdinfo
+static int statcache_count_watches(void) {
+    int count = 0;
+    char line[512];
+    for (int fd = 0; fd < 1024; ++fd) {
+        char name[64];
+        snprintf(name, sizeof(name), "/proc/self/fdinfo/%d", fd);
+        FILE* info = fopen(name, "r");
+        if (!info) {
+            continue;
+        }
+        while (fgets(line, sizeof(line), info)) {
+            count += strncmp(line, "inotify wd:", 11) == 0;
+        }
+        fclose(info);
+    }
+    return count;
+}
+
+XTEST_CASE(test_fscl_statcache_watch_release) {
+    // Evicted keys give their watches back, so a small cache stays small
+    int before = statcache_count_watches();
+    cstatcache* cache = fscl_statcache_create(1, 0.0, 1);
+    fscl_command("mkdir -p xtest_statcache_release/0 xtest_statcache_release/1 xtest_statcache_release/2 xtest_statcache_release/3");
+    const char* keys[] = {
+        "xtest_statcache_release/0", "xtest_statcache_release/1",
+        "xtest_statcache_release/2", "xtest_statcache_release/3"
+    };
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_TRUE(fscl_statcache_is_directory(cache, keys[i]));
+        TEST_ASSERT_TRUE(statcache_count_watches() - before <= 2);
+    }
+    fscl_statcache_clear(cache);
+    TEST_ASSERT_EQUAL_INT(before, statcache_count_watches());
+
+    fscl_command("rm -rf xtest_statcache_release");
+    fscl_statcache_erase(cache);
+}
+#endif
+
+//
+// XUNIT-TEST RUNNER
+//
+XTEST_DEFINE_POOL(test_statcache_group) {
+    XTEST_RUN_UNIT(test_fscl_statcache_counters);
+    XTEST_RUN_UNIT(test_fscl_statcache_install);
+    XTEST_RUN_UNIT(test_fscl_statcache_mutations);
+#ifdef __linux__
+    XTEST_RUN_UNIT(test_fscl_statcache_watch);
+    XTEST_RUN_UNIT(test_fscl_statcache_watch_missing_parent);
+    XTEST_RUN_UNIT(test_fscl_statcache_watch_release);
+#endif
+} // end of func
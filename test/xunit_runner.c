@@ -19,6 +19,17 @@ XTEST_EXTERN_POOL(test_parser_group);
 XTEST_EXTERN_POOL(test_command_group);
 XTEST_EXTERN_POOL(test_fscl_filesys_group);
 XTEST_EXTERN_POOL(test_random_group);
+XTEST_EXTERN_POOL(test_filemap_group);
+XTEST_EXTERN_POOL(test_fileio_group);
+XTEST_EXTERN_POOL(test_statcache_group);
+XTEST_EXTERN_POOL(test_fingerprint_group);
+XTEST_EXTERN_POOL(test_filewatch_group);
+XTEST_EXTERN_POOL(test_filewriter_group);
+XTEST_EXTERN_POOL(test_filepath_group);
+XTEST_EXTERN_POOL(test_diskusage_group);
+XTEST_EXTERN_POOL(test_fileglob_group);
+XTEST_EXTERN_POOL(test_lavarng_group);
+XTEST_EXTERN_POOL(test_lavaentropy_group);
 
 //
 // XUNIT-TEST RUNNER
@@ -30,6 +41,17 @@ int main(int argc, char **argv) {
     XTEST_IMPORT_POOL(test_command_group);
     XTEST_IMPORT_POOL(test_fscl_filesys_group);
     XTEST_IMPORT_POOL(test_random_group);
+    XTEST_IMPORT_POOL(test_filemap_group);
+    XTEST_IMPORT_POOL(test_fileio_group);
+    XTEST_IMPORT_POOL(test_statcache_group);
+    XTEST_IMPORT_POOL(test_fingerprint_group);
+    XTEST_IMPORT_POOL(test_filewatch_group);
+    XTEST_IMPORT_POOL(test_filewriter_group);
+    XTEST_IMPORT_POOL(test_filepath_group);
+    XTEST_IMPORT_POOL(test_diskusage_group);
+    XTEST_IMPORT_POOL(test_fileglob_group);
+    XTEST_IMPORT_POOL(test_lavarng_group);
+    XTEST_IMPORT_POOL(test_lavaentropy_group);
 
     return XTEST_ERASE();
 } // end of func